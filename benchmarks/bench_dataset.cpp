@@ -0,0 +1,57 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include "polann/core/dataset.hpp"
+#include "polann/core/encoded_dataset.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        constexpr size_t features = 32;
+        constexpr size_t samples = 1 << 17;
+
+        template <typename Source>
+        void addGetBatch(Harness &harness, std::shared_ptr<Source> dataset, const std::string &name, size_t batchSize)
+        {
+            auto batch = std::make_shared<size_t>(0);
+            const size_t numBatches = dataset->numBatches(batchSize);
+            const double bytes = static_cast<double>(batchSize) * (features + 1) * sizeof(float) * 2.0;
+
+            harness.add("dataset_getbatch", name + "/" + std::to_string(batchSize), {0.0, bytes}, [=]()
+            {
+                auto [in, out] = dataset->getBatch(*batch, batchSize);
+                *batch = (*batch + 1) % (numBatches - 1); // Skip the partial last batch
+                doNotOptimize(in.data());
+            });
+        }
+
+    } // namespace
+
+    void registerDatasetBenchmarks(Harness &harness)
+    {
+        auto dataset = std::make_shared<core::Dataset<features, 1>>();
+        dataset->addSamples(samples, [](size_t i, std::span<float, features> in, std::span<float, 1> out)
+        {
+            for (size_t j = 0; j < features; ++j)
+                in[j] = std::sin(0.001f * static_cast<float>(i * features + j));
+            out[0] = in[0];
+        });
+        dataset->shuffle(1);
+
+        auto fp16 = std::make_shared<core::Float16Dataset<features, 1>>(core::Float16Dataset<features, 1>::encode(*dataset));
+        auto int8 = std::make_shared<core::Int8Dataset<features, 1>>(core::Int8Dataset<features, 1>::encode(*dataset));
+        fp16->shuffle(1);
+        int8->shuffle(1);
+
+        for (size_t batchSize : {32, 256})
+        {
+            addGetBatch(harness, dataset, "fp32", batchSize);
+            addGetBatch(harness, fp16, "fp16", batchSize);
+            addGetBatch(harness, int8, "int8", batchSize);
+        }
+    }
+
+} // namespace polann::bench
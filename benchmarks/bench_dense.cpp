@@ -0,0 +1,132 @@
+#include "harness.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "polann/layers/dense.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        template <typename Activation>
+        constexpr std::string_view activationName = "unknown";
+        template <>
+        constexpr std::string_view activationName<utils::ReLU> = "relu";
+        template <>
+        constexpr std::string_view activationName<utils::Sigmoid> = "sigmoid";
+        template <>
+        constexpr std::string_view activationName<utils::Tanh> = "tanh";
+        template <>
+        constexpr std::string_view activationName<utils::Identity> = "identity";
+
+        template <typename Activation, size_t In, size_t Out>
+        void addDense(Harness &harness)
+        {
+            using Layer = layers::Dense<Activation, In, Out>;
+
+            // Layers hold their weights inline, so keep them off the stack
+            auto layer = std::make_shared<Layer>();
+            auto input = std::make_shared<std::array<float, In>>();
+            auto output = std::make_shared<std::array<float, Out>>();
+            auto gradOut = std::make_shared<std::array<float, Out>>();
+            auto gradIn = std::make_shared<std::array<float, In>>();
+
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto &x : *input)
+                x = dist(rng);
+            for (auto &g : *gradOut)
+                g = dist(rng) * 1e-3f;
+
+            std::string shape = std::string(activationName<Activation>) + "/" + std::to_string(In) + "x" + std::to_string(Out);
+            const double macs = static_cast<double>(In) * Out;
+            const double weightBytes = macs * sizeof(float);
+
+            harness.add("dense_forward", shape, {2.0 * macs, weightBytes + (In + Out) * sizeof(float)}, [=]()
+            {
+                layer->forward(*input, *output);
+                doNotOptimize(*output);
+            });
+
+            layer->forward(*input, *output); // Populate cached activations for backward
+            harness.add("dense_backward", shape, {4.0 * macs, 3.0 * weightBytes + (In + Out) * sizeof(float)}, [=]()
+            {
+                layer->backward(*gradOut, *gradIn);
+                doNotOptimize(*gradIn);
+            });
+        }
+
+        template <typename Activation, size_t In, size_t Out>
+        void addDenseBatch(Harness &harness, size_t rows)
+        {
+            using Layer = layers::Dense<Activation, In, Out>;
+
+            auto layer = std::make_shared<Layer>();
+            auto input = std::make_shared<std::vector<float>>(rows * In);
+            auto output = std::make_shared<std::vector<float>>(rows * Out);
+            auto gradOut = std::make_shared<std::vector<float>>(rows * Out);
+            auto gradIn = std::make_shared<std::vector<float>>(rows * In);
+
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto &x : *input)
+                x = dist(rng);
+
+            std::string shape = std::string(activationName<Activation>) + "/" + std::to_string(In) + "x" + std::to_string(Out) + "/b" + std::to_string(rows);
+            const double macs = static_cast<double>(In) * Out;
+            const double weightBytes = macs * sizeof(float);
+
+            harness.add("dense_forward_batch", shape, {2.0 * macs * rows, weightBytes + rows * (In + Out) * sizeof(float)}, [=]()
+            {
+                layer->forwardBatch(input->data(), output->data(), rows);
+                doNotOptimize(output->front());
+            });
+
+            auto packed = std::make_shared<Layer>(*layer);
+            packed->packForInference();
+            harness.add("dense_forward_packed", shape, {2.0 * macs * rows, weightBytes + rows * (In + Out) * sizeof(float)}, [=]()
+            {
+                packed->forwardBatch(input->data(), output->data(), rows);
+                doNotOptimize(output->front());
+            });
+
+            layer->forwardBatch(input->data(), output->data(), rows);
+            harness.add("dense_backward_batch", shape, {4.0 * macs * rows, 3.0 * weightBytes + 2.0 * rows * (In + Out) * sizeof(float)}, [=]()
+            {
+                // backwardBatch overwrites its gradient input, so refresh it first
+                std::fill(gradOut->begin(), gradOut->end(), 1e-3f);
+                layer->backwardBatch(input->data(), output->data(), gradOut->data(), gradIn->data(), rows);
+                doNotOptimize(gradIn->front());
+            });
+        }
+
+        template <typename Activation>
+        void addShapes(Harness &harness)
+        {
+            addDense<Activation, 16, 16>(harness);
+            addDense<Activation, 64, 64>(harness);
+            addDense<Activation, 256, 256>(harness);
+            addDense<Activation, 784, 128>(harness);
+            addDense<Activation, 1024, 1024>(harness);
+        }
+
+    } // namespace
+
+    void registerDenseBenchmarks(Harness &harness)
+    {
+        addShapes<utils::ReLU>(harness);
+        addShapes<utils::Sigmoid>(harness);
+        addShapes<utils::Tanh>(harness);
+
+        addDenseBatch<utils::ReLU, 256, 256>(harness, 1);
+        addDenseBatch<utils::ReLU, 64, 64>(harness, 64);
+        addDenseBatch<utils::ReLU, 256, 256>(harness, 64);
+        addDenseBatch<utils::ReLU, 784, 128>(harness, 256);
+        addDenseBatch<utils::ReLU, 1024, 1024>(harness, 256);
+    }
+
+} // namespace polann::bench
@@ -0,0 +1,69 @@
+#include "harness.hpp"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "polann/kernels/gemm.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        struct GemmData
+        {
+            std::vector<float> a;
+            std::vector<float> b;
+            std::vector<float> c;
+
+            GemmData(size_t m, size_t n, size_t k) : a(m * k), b(k * n), c(m * n)
+            {
+                std::mt19937 rng(11);
+                std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+                for (auto &x : a)
+                    x = dist(rng);
+                for (auto &x : b)
+                    x = dist(rng);
+            }
+        };
+
+        void addGemm(Harness &harness, size_t m, size_t n, size_t k, bool reference)
+        {
+            using kernels::Transpose;
+
+            auto data = std::make_shared<GemmData>(m, n, k);
+            std::string shape = std::to_string(m) + "x" + std::to_string(n) + "x" + std::to_string(k);
+            Work work{2.0 * m * n * k, sizeof(float) * static_cast<double>(m * k + k * n + m * n)};
+
+            // B stored transposed (n x k), as in Dense::forwardBatch
+            harness.add("sgemm", "packed/" + shape, work, [=]()
+            {
+                kernels::sgemm(Transpose::No, Transpose::Yes, m, n, k, 1.0f, data->a.data(), k, data->b.data(), k, 0.0f, data->c.data(), n);
+                doNotOptimize(data->c.front());
+            });
+
+            if (reference)
+            {
+                harness.add("sgemm", "reference/" + shape, work, [=]()
+                {
+                    kernels::sgemmReference(Transpose::No, Transpose::Yes, m, n, k, 1.0f, data->a.data(), k, data->b.data(), k, 0.0f, data->c.data(), n);
+                    doNotOptimize(data->c.front());
+                });
+            }
+        }
+
+    } // namespace
+
+    void registerGemmBenchmarks(Harness &harness)
+    {
+        addGemm(harness, 64, 64, 64, true);
+        addGemm(harness, 256, 256, 256, true);
+        addGemm(harness, 1024, 1024, 1024, false);
+
+        // Batch x features shapes of typical Dense layers
+        addGemm(harness, 32, 128, 784, true);
+        addGemm(harness, 256, 128, 784, false);
+        addGemm(harness, 256, 1024, 1024, false);
+    }
+
+} // namespace polann::bench
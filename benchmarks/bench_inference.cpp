@@ -0,0 +1,126 @@
+#include "harness.hpp"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "polann/core/model_builder.hpp"
+#include "polann/kernels/jit.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/ensemble.hpp"
+#include "polann/models/prediction_cache.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        using namespace polann::layers;
+        using namespace polann::utils;
+
+        template <typename... Layers>
+        constexpr double macsPerSample = (0.0 + ... + static_cast<double>(Layers::inputSize * Layers::outputSize));
+
+        // Batch-1 latency of predict, predict on packed weights and the JIT chain
+        template <typename... Layers>
+        void addPredict(Harness &harness, const std::string &name)
+        {
+            using Model = models::NN<Layers...>;
+
+            auto model = std::make_shared<Model>(Layers()...);
+            auto packed = std::make_shared<Model>(*model);
+            packed->finalizeForInference();
+
+            auto input = std::make_shared<std::array<float, Model::inputSize>>();
+            std::mt19937 rng(5);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto &x : *input)
+                x = dist(rng);
+
+            const Work work{2.0 * macsPerSample<Layers...>, sizeof(float) * macsPerSample<Layers...>};
+
+            harness.add("predict", "plain/" + name, work, [=]()
+            {
+                doNotOptimize(model->predict(*input)[0]);
+            });
+
+            harness.add("predict", "packed/" + name, work, [=]()
+            {
+                doNotOptimize(packed->predict(*input)[0]);
+            });
+
+            // Repeated input: every call after the first is a cache hit
+            auto cache = std::make_shared<models::PredictionCache<Model>>(*packed);
+            harness.add("predict", "cached/" + name, work, [=]()
+            {
+                doNotOptimize(cache->predict(*input)[0]);
+            });
+
+            if constexpr (kernels::JitChain::supported())
+            {
+                auto jit = std::make_shared<kernels::JitChain>(kernels::compileJit(*model));
+                auto output = std::make_shared<std::array<float, Model::outputSize>>();
+                harness.add("predict", "jit/" + name, work, [=]()
+                {
+                    (*jit)(input->data(), output->data());
+                    doNotOptimize(output->front());
+                });
+            }
+        }
+
+        // K members through one fused Ensemble versus K packed predictBatch calls
+        template <typename... Layers>
+        void addEnsemble(Harness &harness, const std::string &name, size_t members, size_t rows)
+        {
+            using Model = models::NN<Layers...>;
+
+            auto models = std::make_shared<std::vector<Model>>();
+            for (size_t k = 0; k < members; ++k)
+            {
+                models->emplace_back(Layers()...);
+                models->back().finalizeForInference();
+            }
+            auto ensemble = std::make_shared<models::Ensemble<Layers...>>(*models);
+
+            auto inputs = std::make_shared<std::vector<float>>(rows * Model::inputSize);
+            auto outputs = std::make_shared<std::vector<float>>(rows * Model::outputSize);
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+            for (auto &x : *inputs)
+                x = dist(rng);
+
+            const double macs = macsPerSample<Layers...> * static_cast<double>(members * rows);
+            const Work work{2.0 * macs, sizeof(float) * macsPerSample<Layers...> * static_cast<double>(members)};
+            const std::string label = std::to_string(members) + "x" + name + "/b" + std::to_string(rows);
+
+            harness.add("ensemble", "separate/" + label, work, [=]()
+            {
+                std::vector<float> sum(outputs->size(), 0.0f);
+                for (const Model &model : *models)
+                {
+                    model.predictBatch(*inputs, *outputs);
+                    for (size_t i = 0; i < sum.size(); ++i)
+                        sum[i] += (*outputs)[i];
+                }
+                doNotOptimize(sum.front());
+            });
+
+            harness.add("ensemble", "fused/" + label, work, [=]()
+            {
+                ensemble->predictBatch(*inputs, *outputs);
+                doNotOptimize(outputs->front());
+            });
+        }
+
+    } // namespace
+
+    void registerInferenceBenchmarks(Harness &harness)
+    {
+        addPredict<Dense<ReLU, 32, 128>, Dense<ReLU, 128, 64>, Dense<Sigmoid, 64, 8>>(harness, "32-128-64-8");
+        addPredict<Dense<ReLU, 256, 256>, Dense<ReLU, 256, 256>, Dense<Identity, 256, 10>>(harness, "256-256-256-10");
+        addEnsemble<Dense<ReLU, 32, 128>, Dense<ReLU, 128, 64>, Dense<Sigmoid, 64, 8>>(harness, "32-128-64-8", 8, 1);
+        addEnsemble<Dense<ReLU, 32, 128>, Dense<ReLU, 128, 64>, Dense<Sigmoid, 64, 8>>(harness, "32-128-64-8", 8, 64);
+    }
+
+} // namespace polann::bench
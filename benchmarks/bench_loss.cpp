@@ -0,0 +1,117 @@
+#include "harness.hpp"
+
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include "polann/loss/mse.hpp"
+
+// Reference kernels must stay one element at a time however the benchmark is compiled
+#if defined(__clang__)
+#define POLANN_BENCH_SCALAR __attribute__((noinline))
+#define POLANN_BENCH_SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#elif defined(__GNUC__)
+#define POLANN_BENCH_SCALAR __attribute__((noinline, optimize("no-tree-vectorize")))
+#define POLANN_BENCH_SCALAR_LOOP
+#elif defined(_MSC_VER)
+#define POLANN_BENCH_SCALAR __declspec(noinline)
+#define POLANN_BENCH_SCALAR_LOOP __pragma(loop(no_vector))
+#else
+#define POLANN_BENCH_SCALAR
+#define POLANN_BENCH_SCALAR_LOOP
+#endif
+
+namespace polann::bench
+{
+    namespace
+    {
+        POLANN_BENCH_SCALAR float squaredErrorSumReference(const float *yPredict, const float *yTrue, size_t n)
+        {
+            float sum = 0.0f;
+            POLANN_BENCH_SCALAR_LOOP
+            for (size_t i = 0; i < n; ++i)
+            {
+                float diff = yPredict[i] - yTrue[i];
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        POLANN_BENCH_SCALAR void scaledDifferenceReference(const float *yPredict, const float *yTrue, float *out, size_t n, float scale)
+        {
+            POLANN_BENCH_SCALAR_LOOP
+            for (size_t i = 0; i < n; ++i)
+                out[i] = scale * (yPredict[i] - yTrue[i]);
+        }
+
+        struct LossData
+        {
+            std::vector<float> predict;
+            std::vector<float> target;
+            std::vector<float> grad;
+
+            explicit LossData(size_t n) : predict(n), target(n), grad(n)
+            {
+                std::mt19937 rng(7);
+                std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    predict[i] = dist(rng);
+                    target[i] = dist(rng);
+                }
+            }
+        };
+
+        void addMse(Harness &harness, size_t n)
+        {
+            auto data = std::make_shared<LossData>(n);
+            const std::string size = std::to_string(n);
+            const double readBytes = 2.0 * n * sizeof(float);
+
+            // Truly scalar baseline
+            harness.add("mse_compute", "scalar/" + size, {3.0 * n, readBytes}, [=]()
+            {
+                doNotOptimize(squaredErrorSumReference(data->predict.data(), data->target.data(), n));
+            });
+
+            harness.add("mse_gradient", "scalar/" + size, {2.0 * n, readBytes + n * sizeof(float)}, [=]()
+            {
+                scaledDifferenceReference(data->predict.data(), data->target.data(), data->grad.data(), n, 2.0f / n);
+                doNotOptimize(data->grad.front());
+            });
+
+            // The library's portable kernels, as the compiler vectorizes them
+            harness.add("mse_compute", "portable/" + size, {3.0 * n, readBytes}, [=]()
+            {
+                doNotOptimize(loss::kernels::squaredErrorSumScalar(data->predict.data(), data->target.data(), n));
+            });
+
+            harness.add("mse_gradient", "portable/" + size, {2.0 * n, readBytes + n * sizeof(float)}, [=]()
+            {
+                loss::kernels::scaledDifferenceScalar(data->predict.data(), data->target.data(), data->grad.data(), n, 2.0f / n);
+                doNotOptimize(data->grad.front());
+            });
+
+#ifdef POLANN_ENABLE_AVX2
+            harness.add("mse_compute", "avx2/" + size, {3.0 * n, readBytes}, [=]()
+            {
+                doNotOptimize(loss::kernels::squaredErrorSumAvx2(data->predict.data(), data->target.data(), n));
+            });
+
+            harness.add("mse_gradient", "avx2/" + size, {2.0 * n, readBytes + n * sizeof(float)}, [=]()
+            {
+                loss::kernels::scaledDifferenceAvx2(data->predict.data(), data->target.data(), data->grad.data(), n, 2.0f / n);
+                doNotOptimize(data->grad.front());
+            });
+#endif
+        }
+
+    } // namespace
+
+    void registerLossBenchmarks(Harness &harness)
+    {
+        for (size_t n : {1, 8, 64, 1024, 65536})
+            addMse(harness, n);
+    }
+
+} // namespace polann::bench
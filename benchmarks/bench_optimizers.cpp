@@ -0,0 +1,37 @@
+#include "harness.hpp"
+
+#include <memory>
+#include <string>
+#include "polann/layers/dense.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        template <size_t In, size_t Out>
+        void addSgd(Harness &harness)
+        {
+            auto layer = std::make_shared<layers::Dense<utils::ReLU, In, Out>>();
+            auto optimizer = std::make_shared<optimizers::SGD>(1e-6f);
+            layer->clearGradients();
+
+            const double params = static_cast<double>(In) * Out + Out;
+            harness.add("sgd_step", std::to_string(In) + "x" + std::to_string(Out), {2.0 * params, 3.0 * params * sizeof(float)}, [=]()
+            {
+                optimizer->step(*layer);
+                doNotOptimize(layer->weights.front());
+            });
+        }
+
+    } // namespace
+
+    void registerOptimizerBenchmarks(Harness &harness)
+    {
+        addSgd<64, 64>(harness);
+        addSgd<256, 256>(harness);
+        addSgd<1024, 1024>(harness);
+    }
+
+} // namespace polann::bench
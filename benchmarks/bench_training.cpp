@@ -0,0 +1,95 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "polann/core/dataset.hpp"
+#include "polann/core/model_builder.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/sweep.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::bench
+{
+    namespace
+    {
+        using namespace polann::layers;
+        using namespace polann::utils;
+
+        template <size_t InputSize, size_t OutputSize>
+        std::shared_ptr<core::Dataset<InputSize, OutputSize>> syntheticDataset(size_t samples)
+        {
+            auto dataset = std::make_shared<core::Dataset<InputSize, OutputSize>>();
+            dataset->addSamples(samples, [](size_t i, std::span<float, InputSize> in, std::span<float, OutputSize> out)
+            {
+                float sum = 0.0f;
+                for (size_t j = 0; j < InputSize; ++j)
+                {
+                    in[j] = std::sin(0.37f * static_cast<float>(i) + static_cast<float>(j));
+                    sum += in[j];
+                }
+                for (size_t k = 0; k < OutputSize; ++k)
+                    out[k] = sum > 0.0f ? 1.0f : 0.0f;
+            });
+            return dataset;
+        }
+
+        // Multiply-accumulates per sample summed over all layers
+        template <typename... Layers>
+        constexpr double macsPerSample = (0.0 + ... + static_cast<double>(Layers::inputSize * Layers::outputSize));
+
+        template <typename... Layers>
+        void addFit(Harness &harness, const std::string &name, size_t samples, size_t batchSize)
+        {
+            auto model = std::make_shared<models::NN<Layers...>>(Layers()...);
+            auto dataset = syntheticDataset<models::NN<Layers...>::inputSize, models::NN<Layers...>::outputSize>(samples);
+            auto optimizer = std::make_shared<optimizers::SGD>(0.01f);
+
+            // Forward (2 FLOPs per MAC) plus backward (4 FLOPs per MAC)
+            const double flops = 6.0 * macsPerSample<Layers...> * samples;
+            harness.add("fit_epoch", name + "/" + std::to_string(samples) + "/b" + std::to_string(batchSize), {flops, 0.0}, [=]()
+            {
+                model->fit(*dataset, *optimizer, 1, static_cast<int>(batchSize), true, false);
+            });
+
+            // Same architecture with runtime shapes
+            auto dynamic = std::make_shared<models::DynamicNN>(models::NN<Layers...>::inputSize);
+            (dynamic->addLayer(Layers::outputSize, activationKind<typename Layers::ActivationType>), ...);
+            harness.add("fit_epoch_dynamic", name + "/" + std::to_string(samples) + "/b" + std::to_string(batchSize), {flops, 0.0}, [=]()
+            {
+                dynamic->fit(*dataset, *optimizer, 1, static_cast<int>(batchSize), true, false);
+            });
+        }
+
+        // Many tiny models at once: the workload the sweep runner exists for
+        void addSweep(Harness &harness, size_t runs, size_t samples)
+        {
+            using Model = models::NN<Dense<ReLU, 2, 64>, Dense<ReLU, 64, 32>, Dense<Sigmoid, 32, 1>>;
+
+            auto dataset = syntheticDataset<2, 1>(samples);
+            auto configs = std::make_shared<std::vector<models::SweepConfig>>();
+            for (size_t i = 0; i < runs; ++i)
+                configs->push_back({0.01f * static_cast<float>(i % 4 + 1), 32, static_cast<uint32_t>(i), 1});
+
+            const double flops = 6.0 * macsPerSample<Dense<ReLU, 2, 64>, Dense<ReLU, 64, 32>, Dense<Sigmoid, 32, 1>> * samples * runs;
+            harness.add("sweep", "2-64-32-1/" + std::to_string(runs) + "x" + std::to_string(samples), {flops, 0.0}, [=]()
+            {
+                auto results = models::runSweep(*dataset, *dataset, *configs, [](const models::SweepConfig &) { return Model(Dense<ReLU, 2, 64>(), Dense<ReLU, 64, 32>(), Dense<Sigmoid, 32, 1>()); });
+                doNotOptimize(results.front().validation.loss);
+            });
+        }
+
+    } // namespace
+
+    void registerTrainingBenchmarks(Harness &harness)
+    {
+        addFit<Dense<ReLU, 2, 64>, Dense<ReLU, 64, 32>, Dense<Sigmoid, 32, 1>>(harness, "2-64-32-1", 4096, 32);
+        addFit<Dense<ReLU, 32, 128>, Dense<ReLU, 128, 64>, Dense<Sigmoid, 64, 8>>(harness, "32-128-64-8", 4096, 64);
+        addSweep(harness, 16, 1024);
+    }
+
+} // namespace polann::bench
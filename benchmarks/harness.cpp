@@ -0,0 +1,261 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <algorithm>
+#include "polann/config.h"
+
+namespace polann::bench
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Sample
+        {
+            double ns;
+            double ticks;
+        };
+
+        Sample timeIterations(const std::function<void()> &body, size_t iterations)
+        {
+            uint64_t startTicks = readTimestamp();
+            auto start = Clock::now();
+
+            for (size_t i = 0; i < iterations; ++i)
+                body();
+
+            auto stop = Clock::now();
+            uint64_t stopTicks = readTimestamp();
+
+            return {std::chrono::duration<double, std::nano>(stop - start).count(),
+                    static_cast<double>(stopTicks - startTicks)};
+        }
+
+        double percentile(const std::vector<double> &sorted, double p)
+        {
+            size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[(std::max)(rank, size_t{1}) - 1];
+        }
+
+        double median(std::vector<double> values)
+        {
+            std::sort(values.begin(), values.end());
+            size_t mid = values.size() / 2;
+            return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+        }
+
+        std::string escapeJson(std::string_view text)
+        {
+            std::string escaped;
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    escaped += '\\';
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        std::string formatTime(double ns)
+        {
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2);
+            if (ns < 1e3)
+                os << ns << " ns";
+            else if (ns < 1e6)
+                os << ns / 1e3 << " us";
+            else
+                os << ns / 1e6 << " ms";
+            return os.str();
+        }
+
+        void printPerfTable(std::ostream &log, const std::vector<Result> &results)
+        {
+            using utils::PerfEvent;
+
+            log << "\n" << std::left << std::setw(48) << "benchmark"
+                << std::right << std::setw(8) << "IPC"
+                << std::setw(14) << "cycles/iter"
+                << std::setw(12) << "cyc/FLOP"
+                << std::setw(10) << "L1D miss"
+                << std::setw(10) << "LLC miss"
+                << std::setw(10) << "br miss" << "\n";
+
+            for (const auto &r : results)
+            {
+                log << std::left << std::setw(48) << r.group + "/" + r.name << std::right;
+                if (!r.perf)
+                {
+                    log << "  (hardware counters unavailable)\n";
+                    continue;
+                }
+
+                log << std::fixed << std::setprecision(2)
+                    << std::setw(8) << r.perf->ipc()
+                    << std::setprecision(0)
+                    << std::setw(14) << (*r.perf)[PerfEvent::Cycles]
+                    << std::setprecision(3)
+                    << std::setw(12) << r.cyclesPerFlop()
+                    << std::setprecision(2)
+                    << std::setw(9) << 100.0 * r.perf->l1dMissRate() << "%"
+                    << std::setw(9) << 100.0 * r.perf->llcMissRate() << "%"
+                    << std::setw(9) << 100.0 * r.perf->branchMissRate() << "%\n";
+            }
+        }
+
+    } // namespace
+
+    std::vector<std::string> Harness::names() const
+    {
+        std::vector<std::string> result;
+        for (const auto &entry : entries)
+            result.push_back(entry.group + "/" + entry.name);
+        return result;
+    }
+
+    Result Harness::measure(const Entry &entry) const
+    {
+        // Calibrate: double the iteration count until one repetition is long enough
+        size_t iterations = 1;
+        while (timeIterations(entry.body, iterations).ns < options.minRepetitionNs && iterations < (size_t{1} << 30))
+            iterations *= 2;
+
+        for (size_t w = 0; w < options.warmup; ++w)
+            timeIterations(entry.body, iterations);
+
+        std::optional<utils::PerfCounters> counters;
+        if (options.perf)
+        {
+            counters.emplace();
+            counters->start();
+        }
+
+        std::vector<double> perIterationNs;
+        std::vector<double> perIterationTicks;
+        for (size_t r = 0; r < options.repetitions; ++r)
+        {
+            Sample sample = timeIterations(entry.body, iterations);
+            perIterationNs.push_back(sample.ns / iterations);
+            perIterationTicks.push_back(sample.ticks / iterations);
+        }
+
+        std::optional<utils::PerfSample> perf;
+        if (counters && counters->available())
+        {
+            perf = counters->stop();
+            for (auto &value : perf->values)
+                value /= static_cast<double>(iterations * options.repetitions);
+        }
+
+        Result result;
+        result.group = entry.group;
+        result.name = entry.name;
+        result.work = entry.work;
+        result.iterations = iterations;
+        result.repetitions = options.repetitions;
+        result.medianNs = median(perIterationNs);
+        result.meanNs = std::accumulate(perIterationNs.begin(), perIterationNs.end(), 0.0) / perIterationNs.size();
+        result.ticksPerIteration = median(perIterationTicks);
+        result.perf = perf;
+
+        std::sort(perIterationNs.begin(), perIterationNs.end());
+        result.minNs = perIterationNs.front();
+        result.p99Ns = percentile(perIterationNs, 0.99);
+        return result;
+    }
+
+    std::vector<Result> Harness::run(std::ostream &log) const
+    {
+        std::vector<Result> results;
+
+        log << std::left << std::setw(48) << "benchmark"
+            << std::right << std::setw(12) << "median"
+            << std::setw(12) << "p99"
+            << std::setw(10) << "GFLOP/s"
+            << std::setw(10) << "GB/s"
+            << std::setw(12) << "ticks/FLOP" << "\n";
+
+        for (const auto &entry : entries)
+        {
+            std::string fullName = entry.group + "/" + entry.name;
+            if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos)
+                continue;
+
+            Result result = measure(entry);
+            log << std::left << std::setw(48) << fullName
+                << std::right << std::setw(12) << formatTime(result.medianNs)
+                << std::setw(12) << formatTime(result.p99Ns)
+                << std::fixed << std::setprecision(2)
+                << std::setw(10) << result.gflops()
+                << std::setw(10) << result.gbytesPerSecond()
+                << std::setprecision(3)
+                << std::setw(12) << result.ticksPerFlop() << "\n";
+
+            results.push_back(std::move(result));
+        }
+
+        if (options.perf)
+            printPerfTable(log, results);
+
+        return results;
+    }
+
+    void writeJson(std::ostream &os, const std::vector<Result> &results)
+    {
+#ifdef POLANN_ENABLE_AVX2
+        constexpr bool avx2 = true;
+#else
+        constexpr bool avx2 = false;
+#endif
+        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+        os << std::setprecision(9);
+        os << "{\n";
+        os << "  \"polann_version\": \"" << POLANN_VERSION << "\",\n";
+        os << "  \"avx2\": " << (avx2 ? "true" : "false") << ",\n";
+        os << "  \"timestamp\": " << timestamp << ",\n";
+        os << "  \"results\": [";
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &r = results[i];
+            os << (i ? ",\n" : "\n");
+            os << "    {\"group\": \"" << escapeJson(r.group) << "\""
+               << ", \"name\": \"" << escapeJson(r.name) << "\""
+               << ", \"iterations\": " << r.iterations
+               << ", \"repetitions\": " << r.repetitions
+               << ", \"min_ns\": " << r.minNs
+               << ", \"median_ns\": " << r.medianNs
+               << ", \"mean_ns\": " << r.meanNs
+               << ", \"p99_ns\": " << r.p99Ns
+               << ", \"flops\": " << r.work.flops
+               << ", \"bytes\": " << r.work.bytes
+               << ", \"gflops\": " << r.gflops()
+               << ", \"gbytes_per_s\": " << r.gbytesPerSecond()
+               << ", \"ticks_per_flop\": " << r.ticksPerFlop();
+
+            if (r.perf)
+            {
+                os << ", \"perf\": {";
+                for (size_t e = 0; e < utils::perfEventCount; ++e)
+                    if (r.perf->valid[e])
+                        os << "\"" << utils::perfEventNames[e] << "\": " << r.perf->values[e] << ", ";
+                os << "\"ipc\": " << r.perf->ipc()
+                   << ", \"cycles_per_flop\": " << r.cyclesPerFlop()
+                   << ", \"l1d_miss_rate\": " << r.perf->l1dMissRate()
+                   << ", \"llc_miss_rate\": " << r.perf->llcMissRate()
+                   << ", \"branch_miss_rate\": " << r.perf->branchMissRate() << "}";
+            }
+
+            os << "}";
+        }
+
+        os << "\n  ]\n}\n";
+    }
+
+} // namespace polann::bench
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include "polann/utils/perf_counters.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define POLANN_BENCH_HAS_TSC
+#endif
+
+namespace polann::bench
+{
+    /**
+     * @brief Prevents the compiler from optimizing away a computed value
+     */
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Reads the time stamp counter (0 when unavailable)
+     *
+     * TSC ticks run at a constant reference frequency, not the current core clock.
+     */
+    inline uint64_t readTimestamp()
+    {
+#ifdef POLANN_BENCH_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Work performed by one benchmark iteration
+     */
+    struct Work
+    {
+        double flops = 0.0; /// Floating point operations per iteration
+        double bytes = 0.0; /// Bytes read plus written per iteration
+    };
+
+    /**
+     * @brief Aggregated timing of one benchmark
+     */
+    struct Result
+    {
+        std::string group;
+        std::string name;
+        Work work;
+        size_t iterations = 0;  /// Iterations per repetition
+        size_t repetitions = 0; /// Timed repetitions
+        double minNs = 0.0;     /// Per-iteration times across repetitions
+        double medianNs = 0.0;
+        double meanNs = 0.0;
+        double p99Ns = 0.0;
+        double ticksPerIteration = 0.0; /// Median TSC ticks per iteration
+
+        std::optional<utils::PerfSample> perf; /// Hardware counters per iteration (with --perf)
+
+        [[nodiscard]] double gflops() const { return medianNs > 0.0 ? work.flops / medianNs : 0.0; }
+        [[nodiscard]] double gbytesPerSecond() const { return medianNs > 0.0 ? work.bytes / medianNs : 0.0; }
+        [[nodiscard]] double ticksPerFlop() const { return work.flops > 0.0 ? ticksPerIteration / work.flops : 0.0; }
+
+        [[nodiscard]] double cyclesPerFlop() const
+        {
+            return perf && perf->has(utils::PerfEvent::Cycles) && work.flops > 0.0 ? (*perf)[utils::PerfEvent::Cycles] / work.flops : 0.0;
+        }
+    };
+
+    struct Options
+    {
+        size_t warmup = 3;            /// Untimed repetitions before measuring
+        size_t repetitions = 30;      /// Timed repetitions
+        double minRepetitionNs = 2e5; /// Calibrated minimum duration of one repetition
+        std::string filter;           /// Only run benchmarks whose full name contains this
+        bool perf = false;            /// Sample hardware counters over the timed repetitions
+    };
+
+    /**
+     * @brief Minimal self-contained benchmark runner
+     *
+     * Each benchmark body is one iteration. The runner calibrates an iteration
+     * count so a repetition lasts at least Options::minRepetitionNs, runs the
+     * warmup repetitions, then records per-iteration times of each timed
+     * repetition and reports min/median/mean/p99. With Options::perf, the timed
+     * repetitions are also bracketed by hardware counters (Linux perf_event).
+     */
+    class Harness
+    {
+    public:
+        explicit Harness(Options opts) : options(std::move(opts)) {}
+
+        /**
+         * @brief Register a benchmark
+         *
+         * @param group Category, e.g. "dense" or "loss"
+         * @param name Unique name within the group
+         * @param work FLOPs and bytes per iteration
+         * @param body One iteration of the measured code
+         */
+        void add(std::string group, std::string name, Work work, std::function<void()> body)
+        {
+            entries.push_back({std::move(group), std::move(name), work, std::move(body)});
+        }
+
+        [[nodiscard]] std::vector<std::string> names() const;
+
+        /**
+         * @brief Run all benchmarks matching the filter
+         *
+         * @param log Stream receiving a human-readable table
+         * @return Results in registration order
+         */
+        std::vector<Result> run(std::ostream &log) const;
+
+    private:
+        struct Entry
+        {
+            std::string group;
+            std::string name;
+            Work work;
+            std::function<void()> body;
+        };
+
+        Options options;
+        std::vector<Entry> entries;
+
+        Result measure(const Entry &entry) const;
+    };
+
+    /**
+     * @brief Write results as a JSON document for regression tracking
+     */
+    void writeJson(std::ostream &os, const std::vector<Result> &results);
+
+    // Benchmark suites, one per translation unit
+    void registerDenseBenchmarks(Harness &harness);
+    void registerGemmBenchmarks(Harness &harness);
+    void registerLossBenchmarks(Harness &harness);
+    void registerOptimizerBenchmarks(Harness &harness);
+    void registerDatasetBenchmarks(Harness &harness);
+    void registerTrainingBenchmarks(Harness &harness);
+    void registerInferenceBenchmarks(Harness &harness);
+
+} // namespace polann::bench
@@ -0,0 +1,111 @@
+#include "harness.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+using namespace polann::bench;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: polann_bench [options]\n"
+                  << "  --filter <text>     Only run benchmarks whose name contains text\n"
+                  << "  --json <file>       Write results as JSON ('-' for stdout)\n"
+                  << "  --reps <n>          Timed repetitions per benchmark (default 30)\n"
+                  << "  --warmup <n>        Warmup repetitions per benchmark (default 3)\n"
+                  << "  --min-time-us <n>   Minimum duration of one repetition (default 200)\n"
+                  << "  --perf              Sample hardware counters (Linux perf_event)\n"
+                  << "  --list              List benchmark names and exit\n";
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    std::string jsonPath;
+    bool list = false;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("Missing value for " + std::string(arg));
+                return argv[++i];
+            };
+
+            if (arg == "--filter")
+                options.filter = value();
+            else if (arg == "--json")
+                jsonPath = value();
+            else if (arg == "--reps")
+                options.repetitions = std::stoul(value());
+            else if (arg == "--warmup")
+                options.warmup = std::stoul(value());
+            else if (arg == "--min-time-us")
+                options.minRepetitionNs = std::stod(value()) * 1e3;
+            else if (arg == "--perf")
+                options.perf = true;
+            else if (arg == "--list")
+                list = true;
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+            else
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+        }
+
+        if (options.repetitions == 0)
+            throw std::invalid_argument("--reps must be positive");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    Harness harness(options);
+    registerDenseBenchmarks(harness);
+    registerGemmBenchmarks(harness);
+    registerLossBenchmarks(harness);
+    registerOptimizerBenchmarks(harness);
+    registerDatasetBenchmarks(harness);
+    registerTrainingBenchmarks(harness);
+    registerInferenceBenchmarks(harness);
+
+    if (list)
+    {
+        for (const auto &name : harness.names())
+            std::cout << name << "\n";
+        return 0;
+    }
+
+    // Keep stdout clean for JSON when it is the requested destination
+    std::ostream &log = jsonPath == "-" ? std::cerr : std::cout;
+    auto results = harness.run(log);
+
+    if (jsonPath == "-")
+        writeJson(std::cout, results);
+    else if (!jsonPath.empty())
+    {
+        std::ofstream file(jsonPath);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << jsonPath << " for writing\n";
+            return 1;
+        }
+        writeJson(file, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+# polann_precompile_headers(<target>)
+#
+# Precompiles the polann headers that model code usually includes, together
+# with the standard library headers behind them, for every C++ source of
+# <target>. Pays off for targets with several translation units; needs
+# CMake 3.16. Sources built with their own instruction-set flags must set
+# SKIP_PRECOMPILE_HEADERS, since a header is only reused with matching flags.
+function(polann_precompile_headers target)
+    target_precompile_headers(${target} PRIVATE
+        <polann/core/dataset.hpp>
+        <polann/core/model_builder.hpp>
+        <polann/layers/dense.hpp>
+        <polann/models/dynamic_nn.hpp>
+        <polann/models/nn.hpp>
+        <polann/optimizers/sgd.hpp>
+        <polann/utils/activation_functions.hpp>
+    )
+endfunction()
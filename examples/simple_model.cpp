@@ -26,22 +26,23 @@ using namespace polann::loss;
 Dataset<2, 1> circleDataset(float radius, float range, size_t samples)
 {
     Dataset<2, 1> dataset;
+    dataset.reserve(samples);
 
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_real_distribution<float> dist(-range, range);
-
-    for (size_t i = 0; i < samples; ++i)
+    // Rows are generated in parallel; each thread draws from its own engine
+    dataset.addSamples(samples, [&](size_t, std::span<float, 2> coordinate, std::span<float, 1> inCircle)
     {
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_real_distribution<float> dist(-range, range);
+
         float x = dist(rng);
         float y = dist(rng);
 
-        std::array<float, 2> coordinate = {x, y};
-        float distance = std::sqrt(x * x + y * y);
-        std::array<float, 1> inCircle = {distance < radius ? 1.0f : 0.0f};
+        coordinate[0] = x;
+        coordinate[1] = y;
 
-        dataset.addSample(coordinate, inCircle);
-    }
+        float distance = std::sqrt(x * x + y * y);
+        inCircle[0] = distance < radius ? 1.0f : 0.0f;
+    });
 
     return dataset;
 }
@@ -62,6 +63,10 @@ int main()
     SGD optimizer(0.1f);
     model.fit(dataset, optimizer, 100, 32);
 
+    // Evaluate on a fresh sample of the same distribution
+    auto testDataset = circleDataset(0.6f, 0.7f, 1000);
+    model.evaluate(testDataset).print(std::cout);
+
     // Test with some input
     std::array<float, 2> inputs = {0.43f, 0.22f};
     std::cout << "Input: " << inputs << std::endl;
@@ -73,19 +78,22 @@ int main()
     const int N = 100; // grid resolution
     std::vector<std::vector<double>> Z(N, std::vector<double>(N, 0.0));
 
+    // Predict the whole grid in one batched call
+    std::vector<float> grid(N * N * 2);
+    std::vector<float> predictions(N * N);
     for (int i = 0; i < N; ++i)
     {
         for (int j = 0; j < N; ++j)
         {
-            double x = -1.0 + 2.0 * i / (N - 1); // range -1 to 1
-            double y = -1.0 + 2.0 * j / (N - 1);
-
-            std::array<float, 2> input = {static_cast<float>(x), static_cast<float>(y)};
-            std::array<float, 1> output = model.predict(input);
-
-            Z[j][i] = static_cast<double>(output[0]);
+            grid[(i * N + j) * 2] = static_cast<float>(-1.0 + 2.0 * i / (N - 1)); // range -1 to 1
+            grid[(i * N + j) * 2 + 1] = static_cast<float>(-1.0 + 2.0 * j / (N - 1));
         }
     }
+    model.predictBatch(grid, predictions);
+
+    for (int i = 0; i < N; ++i)
+        for (int j = 0; j < N; ++j)
+            Z[j][i] = static_cast<double>(predictions[i * N + j]);
 
     matplot::imagesc(Z);
     matplot::colorbar();
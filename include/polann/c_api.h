@@ -0,0 +1,80 @@
+#ifndef POLANN_C_API_H
+#define POLANN_C_API_H
+
+/*
+ * Stable C interface to polann inference, exported by libpolann.
+ *
+ * Models are the files written by NN::save or DynamicNN::save and run on
+ * the runtime-shaped engine (DynamicNN) with packed weights. Buffers are
+ * caller-owned, row-major float32 and used in place: nothing is copied
+ * into or out of them beyond the forward pass itself.
+ *
+ * Functions never throw or abort. On failure they return a status other
+ * than POLANN_OK and polann_last_error() describes it for the calling
+ * thread. A loaded model may be shared by any number of threads calling
+ * polann_predict_batch concurrently.
+ */
+
+#include <stddef.h>
+#include "polann/config.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Bumped on incompatible changes to the functions below */
+#define POLANN_C_ABI_VERSION 1
+
+typedef struct polann_model polann_model;
+
+typedef enum polann_status
+{
+    POLANN_OK = 0,
+    POLANN_ERROR_INVALID_ARGUMENT = 1, /* Null pointer or similar */
+    POLANN_ERROR_IO = 2,               /* File could not be opened or mapped */
+    POLANN_ERROR_FORMAT = 3,           /* Not a polann model, or a corrupt one */
+    POLANN_ERROR_OUT_OF_MEMORY = 4,
+    POLANN_ERROR_INTERNAL = 5
+} polann_status;
+
+/* POLANN_C_ABI_VERSION of the library actually loaded */
+POLANN_API int polann_abi_version(void);
+
+/* Library version, e.g. "1.0.0" */
+POLANN_API const char *polann_version(void);
+
+/*
+ * Loads a model file through a read-only memory mapping.
+ * On success *model owns the model; release it with polann_model_free.
+ */
+POLANN_API polann_status polann_model_load(const char *path, polann_model **model);
+
+/* Loads a model from size bytes of a saved model file already in memory */
+POLANN_API polann_status polann_model_load_memory(const void *data, size_t size, polann_model **model);
+
+/* Releases a model; null is ignored */
+POLANN_API void polann_model_free(polann_model *model);
+
+/* Features per input row; 0 for null */
+POLANN_API size_t polann_model_input_size(const polann_model *model);
+
+/* Values per output row; 0 for null */
+POLANN_API size_t polann_model_output_size(const polann_model *model);
+
+/*
+ * Runs rows samples through the model; zero rows is a no-op.
+ * inputs holds rows * input_size floats and outputs receives rows * output_size.
+ * The model's normalizer, if any, is applied to the inputs. A rows count whose
+ * buffer sizes overflow size_t is rejected with POLANN_ERROR_INVALID_ARGUMENT.
+ */
+POLANN_API polann_status polann_predict_batch(const polann_model *model, const float *inputs, size_t rows, float *outputs);
+
+/* Message of the calling thread's last failure ("" if none); valid until its next call */
+POLANN_API const char *polann_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLANN_C_API_H */
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <limits>
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+
+namespace polann::callbacks
+{
+    /**
+     * @brief Returned by a hook to let training continue or end after the current epoch
+     */
+    enum class Action
+    {
+        Continue,
+        Stop
+    };
+
+    /**
+     * @brief State passed to onEpochBegin and onEpochEnd
+     *
+     * At onEpochBegin only epoch, epochs and learningRate are set.
+     */
+    struct EpochInfo
+    {
+        size_t epoch = 0;            /// Zero-based epoch index
+        size_t epochs = 0;           /// Requested number of epochs
+        float loss = 0.0f;           /// Mean per-sample training loss
+        size_t samples = 0;          /// Samples trained on in this epoch
+        size_t batches = 0;          /// Batches trained on in this epoch
+        double elapsedNs = 0.0;      /// Wall time of the epoch
+        double samplesPerSecond = 0.0;
+        float learningRate = std::numeric_limits<float>::quiet_NaN(); /// NaN if the optimizer has none
+    };
+
+    /**
+     * @brief State passed to onBatchEnd
+     */
+    struct BatchInfo
+    {
+        size_t epoch = 0;
+        size_t batch = 0;       /// Zero-based batch index within the epoch
+        size_t batchSize = 0;   /// Samples in this batch
+        float loss = 0.0f;      /// Mean per-sample loss of this batch
+        double elapsedNs = 0.0; /// Wall time of the batch including getBatch and optimizer step
+        double samplesPerSecond = 0.0;
+        float learningRate = std::numeric_limits<float>::quiet_NaN();
+    };
+
+    /**
+     * @brief Learning rate of an optimizer exposing a learningRate member, NaN otherwise
+     */
+    template <typename Optimizer>
+    [[nodiscard]] float learningRate(const Optimizer &optimizer)
+    {
+        if constexpr (requires { static_cast<float>(optimizer.learningRate); })
+            return static_cast<float>(optimizer.learningRate);
+        else
+            return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    namespace detail
+    {
+        template <typename Call>
+        Action toAction(Call &&call)
+        {
+            if constexpr (std::same_as<std::invoke_result_t<Call>, Action>)
+                return call();
+            else
+            {
+                call();
+                return Action::Continue;
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Whether a callback handles onBatchEnd for a model
+     *
+     * fit only measures per-batch timings when at least one callback does.
+     */
+    template <typename Callback, typename Model>
+    concept HasBatchEnd = requires(Callback &callback, Model &model, const BatchInfo &info) {
+        callback.onBatchEnd(model, info);
+    };
+
+    /*
+     * Hook dispatch used by NN::fit. A callback is any object implementing a
+     * subset of
+     *
+     *     void onTrainBegin(Model &model);
+     *     void onEpochBegin(Model &model, const EpochInfo &info);
+     *     void onBatchEnd(Model &model, const BatchInfo &info);
+     *     void onEpochEnd(Model &model, const EpochInfo &info);
+     *     void onTrainEnd(Model &model);
+     *
+     * Hooks may return Action instead of void; Action::Stop ends training after
+     * the current epoch. Missing hooks and the dispatch itself compile away.
+     */
+
+    template <typename Callback, typename Model>
+    void onTrainBegin(Callback &callback, Model &model)
+    {
+        if constexpr (requires { callback.onTrainBegin(model); })
+            callback.onTrainBegin(model);
+    }
+
+    template <typename Callback, typename Model>
+    Action onEpochBegin(Callback &callback, Model &model, const EpochInfo &info)
+    {
+        if constexpr (requires { callback.onEpochBegin(model, info); })
+            return detail::toAction([&] { return callback.onEpochBegin(model, info); });
+        else
+            return Action::Continue;
+    }
+
+    template <typename Callback, typename Model>
+    Action onBatchEnd(Callback &callback, Model &model, const BatchInfo &info)
+    {
+        if constexpr (HasBatchEnd<Callback, Model>)
+            return detail::toAction([&] { return callback.onBatchEnd(model, info); });
+        else
+            return Action::Continue;
+    }
+
+    template <typename Callback, typename Model>
+    Action onEpochEnd(Callback &callback, Model &model, const EpochInfo &info)
+    {
+        if constexpr (requires { callback.onEpochEnd(model, info); })
+            return detail::toAction([&] { return callback.onEpochEnd(model, info); });
+        else
+            return Action::Continue;
+    }
+
+    template <typename Callback, typename Model>
+    void onTrainEnd(Callback &callback, Model &model)
+    {
+        if constexpr (requires { callback.onTrainEnd(model); })
+            callback.onTrainEnd(model);
+    }
+
+} // namespace polann::callbacks
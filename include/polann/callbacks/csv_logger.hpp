@@ -0,0 +1,57 @@
+#pragma once
+
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <filesystem>
+#include "polann/callbacks/callback.hpp"
+
+namespace polann::callbacks
+{
+    /**
+     * @brief Writes one CSV row of training metrics per epoch
+     *
+     * Columns: epoch, loss, samples, epoch_ms, samples_per_s, learning_rate.
+     */
+    class CsvLogger
+    {
+    public:
+        /**
+         * @param stream Destination that must outlive training
+         */
+        explicit CsvLogger(std::ostream &stream) : os(&stream) {}
+
+        /**
+         * @param path File to create or overwrite
+         */
+        explicit CsvLogger(const std::filesystem::path &path) : file(path), os(&file)
+        {
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for writing");
+        }
+
+        template <typename Model>
+        void onTrainBegin(Model &)
+        {
+            *os << "epoch,loss,samples,epoch_ms,samples_per_s,learning_rate\n";
+        }
+
+        template <typename Model>
+        void onEpochEnd(Model &, const EpochInfo &info)
+        {
+            *os << info.epoch << ',' << info.loss << ',' << info.samples << ','
+                << info.elapsedNs / 1e6 << ',' << info.samplesPerSecond << ',' << info.learningRate << '\n';
+        }
+
+        template <typename Model>
+        void onTrainEnd(Model &)
+        {
+            os->flush();
+        }
+
+    private:
+        std::ofstream file;
+        std::ostream *os;
+    };
+
+} // namespace polann::callbacks
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include "polann/callbacks/callback.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/loss/mse.hpp"
+
+namespace polann::callbacks
+{
+    /**
+     * @brief Stops training once the validation loss stops improving
+     *
+     * After every epoch the model is evaluated on a held-out set with the
+     * batched, multi-threaded NN::evaluate. An epoch counts as an improvement
+     * when its loss is below the best so far by more than minDelta. Training
+     * stops after patience epochs without improvement. With restoreBest, the
+     * parameters of the best epoch are kept in memory and written back when
+     * training ends.
+     *
+     * @tparam Validation Dataset or DatasetView holding the held-out samples
+     * @tparam LossFunction Loss used for validation
+     */
+    template <polann::core::BatchSource Validation, typename LossFunction = polann::loss::MSE>
+    class EarlyStopping
+    {
+    public:
+        /**
+         * @param validation Held-out samples; must outlive training
+         * @param patience Epochs without improvement before stopping
+         * @param minDelta Minimum loss decrease that counts as improvement
+         * @param restoreBest Whether to restore the best parameters at the end
+         * @param pool Threads used for validation
+         */
+        explicit EarlyStopping(const Validation &validation, size_t patience = 10, float minDelta = 0.0f,
+                               bool restoreBest = true, polann::core::ThreadPool &pool = polann::core::ThreadPool::global())
+            : validation(&validation), patience(patience), minDelta(minDelta), restoreBest(restoreBest), pool(&pool) {}
+
+        template <typename Model>
+        void onTrainBegin(Model &)
+        {
+            best = std::numeric_limits<float>::infinity();
+            last = best;
+            bestEpochIndex = 0;
+            wait = 0;
+            stopped = false;
+            checkpoint.clear();
+        }
+
+        template <typename Model>
+        Action onEpochEnd(Model &model, const EpochInfo &info)
+        {
+            // Only the loss is needed, so skip AUC and the per-epoch sort of all predictions
+            last = model.template evaluate<Validation, LossFunction>(*validation, evaluationBatchSize, *pool, false).loss;
+
+            if (last < best - minDelta)
+            {
+                best = last;
+                bestEpochIndex = info.epoch;
+                wait = 0;
+
+                if (restoreBest)
+                {
+                    std::ostringstream os(std::ios::binary);
+                    model.save(os);
+                    checkpoint = std::move(os).str();
+                }
+                return Action::Continue;
+            }
+
+            if (++wait < patience)
+                return Action::Continue;
+
+            stopped = true;
+            return Action::Stop;
+        }
+
+        template <typename Model>
+        void onTrainEnd(Model &model)
+        {
+            if (!restoreBest || checkpoint.empty())
+                return;
+
+            std::istringstream is(checkpoint, std::ios::binary);
+            model.load(is);
+        }
+
+        [[nodiscard]] float bestLoss() const { return best; }
+
+        [[nodiscard]] float lastLoss() const { return last; } /// Validation loss of the latest epoch
+
+        [[nodiscard]] size_t bestEpoch() const { return bestEpochIndex; }
+
+        [[nodiscard]] bool stoppedEarly() const { return stopped; }
+
+    private:
+        static constexpr size_t evaluationBatchSize = 1024;
+
+        const Validation *validation;
+        size_t patience;
+        float minDelta;
+        bool restoreBest;
+        polann::core::ThreadPool *pool;
+
+        float best = std::numeric_limits<float>::infinity();
+        float last = std::numeric_limits<float>::infinity();
+        size_t bestEpochIndex = 0;
+        size_t wait = 0;
+        bool stopped = false;
+        std::string checkpoint; /// Serialized parameters of the best epoch
+    };
+
+} // namespace polann::callbacks
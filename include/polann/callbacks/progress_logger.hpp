@@ -0,0 +1,29 @@
+#pragma once
+
+#include <iostream>
+#include "polann/callbacks/callback.hpp"
+
+namespace polann::callbacks
+{
+    /**
+     * @brief Prints the epoch loss every few epochs and after the last one
+     *
+     * This is what fit uses when verbose is true.
+     */
+    struct ProgressLogger
+    {
+        std::ostream *os = &std::cout;
+        size_t every = 10; /// Print every n-th epoch; 0 prints only the last one
+
+        ProgressLogger() = default;
+        explicit ProgressLogger(std::ostream &stream, size_t interval = 10) : os(&stream), every(interval) {}
+
+        template <typename Model>
+        void onEpochEnd(Model &, const EpochInfo &info)
+        {
+            if ((every != 0 && info.epoch % every == 0) || info.epoch + 1 == info.epochs)
+                *os << "Epoch " << info.epoch << "/" << info.epochs << ", Loss: " << info.loss << std::endl;
+        }
+    };
+
+} // namespace polann::callbacks
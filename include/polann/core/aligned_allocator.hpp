@@ -0,0 +1,214 @@
+#pragma once
+
+#include <new>
+#include <limits>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <memory_resource>
+#include "polann/config.h"
+
+#ifdef POLANN_PLATFORM_LINUX
+#include <sys/mman.h>
+#endif
+
+namespace polann::core
+{
+    inline constexpr size_t cacheLineSize = 64;               /// Default alignment for SIMD-friendly buffers
+    inline constexpr size_t hugePageSize = 2 * 1024 * 1024;   /// Transparent huge page size on x86-64
+    inline constexpr size_t hugePageThreshold = hugePageSize; /// Minimum allocation size backed by huge pages
+
+    /**
+     * @brief Allocator returning memory aligned to a fixed boundary
+     *
+     * Allocations of at least hugePageThreshold bytes are aligned to hugePageSize
+     * and advised as transparent huge pages when HugePages is enabled (Linux only).
+     *
+     * @tparam T Value type
+     * @tparam Alignment Alignment in bytes (power of two, at least alignof(T))
+     * @tparam HugePages Whether large allocations should be huge-page backed
+     */
+    template <typename T, size_t Alignment = cacheLineSize, bool HugePages = false>
+    struct AlignedAllocator
+    {
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment must satisfy alignof(T)");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, Alignment, HugePages>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment, HugePages> &) noexcept {}
+
+        [[nodiscard]] T *allocate(size_t n)
+        {
+            if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+
+            const size_t bytes = n * sizeof(T);
+            void *ptr = ::operator new(bytes, std::align_val_t(alignmentFor(bytes)));
+
+#ifdef POLANN_PLATFORM_LINUX
+            if (usesHugePages(bytes))
+                madvise(ptr, bytes, MADV_HUGEPAGE); // Advisory only, failure is harmless
+#endif
+            return static_cast<T *>(ptr);
+        }
+
+        void deallocate(T *ptr, size_t n) noexcept
+        {
+            const size_t bytes = n * sizeof(T);
+            ::operator delete(ptr, bytes, std::align_val_t(alignmentFor(bytes)));
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment, HugePages> &) const noexcept { return true; }
+
+    private:
+        static constexpr bool usesHugePages(size_t bytes) noexcept
+        {
+            return HugePages && bytes >= hugePageThreshold;
+        }
+
+        static constexpr size_t alignmentFor(size_t bytes) noexcept
+        {
+            return usesHugePages(bytes) ? hugePageSize : Alignment;
+        }
+    };
+
+    /**
+     * @brief Allocator alias for large datasets backed by transparent huge pages
+     */
+    template <typename T>
+    using HugePageAllocator = AlignedAllocator<T, cacheLineSize, true>;
+
+    /**
+     * @brief Allocator adaptor whose value-less construct() default-initializes
+     *
+     * std::vector::resize(n) then leaves new trivially constructible elements
+     * uninitialized instead of zeroing them, so storage that is written in
+     * parallel right after growing is touched once, by the threads that fill
+     * it. Everything else forwards to Base.
+     *
+     * @tparam Base Underlying allocator (AlignedAllocator, pmr::AlignedPolymorphicAllocator, ...)
+     */
+    template <typename Base>
+    struct DefaultInitAllocator : Base
+    {
+        using Traits = std::allocator_traits<Base>;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = DefaultInitAllocator<typename Traits::template rebind_alloc<U>>;
+        };
+
+        using Base::Base;
+        DefaultInitAllocator() = default;
+        DefaultInitAllocator(const Base &base) noexcept : Base(base) {}
+
+        template <typename U>
+        DefaultInitAllocator(const DefaultInitAllocator<U> &other) noexcept : Base(static_cast<const U &>(other)) {}
+
+        template <typename U>
+        void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new (static_cast<void *>(ptr)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U *ptr, Args &&...args)
+        {
+            Traits::construct(static_cast<Base &>(*this), ptr, std::forward<Args>(args)...);
+        }
+
+        DefaultInitAllocator select_on_container_copy_construction() const
+        {
+            return DefaultInitAllocator(Traits::select_on_container_copy_construction(*this));
+        }
+
+        template <typename U>
+        bool operator==(const DefaultInitAllocator<U> &other) const noexcept
+        {
+            return static_cast<const Base &>(*this) == static_cast<const U &>(other);
+        }
+    };
+
+    namespace pmr
+    {
+        /**
+         * @brief Polymorphic allocator that enforces a minimum alignment
+         *
+         * std::pmr::polymorphic_allocator only requests alignof(T) from its resource.
+         * This variant forwards every request with Alignment so containers sharing an
+         * arena (e.g. std::pmr::monotonic_buffer_resource) still get SIMD-aligned storage.
+         *
+         * @tparam T Value type
+         * @tparam Alignment Alignment in bytes
+         */
+        template <typename T, size_t Alignment = cacheLineSize>
+        struct AlignedPolymorphicAllocator
+        {
+            static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+            static_assert(Alignment >= alignof(T), "Alignment must satisfy alignof(T)");
+
+            using value_type = T;
+
+            template <typename U>
+            struct rebind
+            {
+                using other = AlignedPolymorphicAllocator<U, Alignment>;
+            };
+
+            AlignedPolymorphicAllocator() noexcept
+                : resource(std::pmr::get_default_resource()) {}
+
+            AlignedPolymorphicAllocator(std::pmr::memory_resource *r) noexcept
+                : resource(r) {}
+
+            template <typename U>
+            AlignedPolymorphicAllocator(const AlignedPolymorphicAllocator<U, Alignment> &other) noexcept
+                : resource(other.getResource()) {}
+
+            [[nodiscard]] T *allocate(size_t n)
+            {
+                if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+                    throw std::bad_array_new_length();
+                return static_cast<T *>(resource->allocate(n * sizeof(T), Alignment));
+            }
+
+            void deallocate(T *ptr, size_t n) noexcept
+            {
+                resource->deallocate(ptr, n * sizeof(T), Alignment);
+            }
+
+            // Match std::pmr semantics: copies do not propagate the resource
+            AlignedPolymorphicAllocator select_on_container_copy_construction() const noexcept
+            {
+                return AlignedPolymorphicAllocator();
+            }
+
+            [[nodiscard]] std::pmr::memory_resource *getResource() const noexcept { return resource; }
+
+            template <typename U>
+            bool operator==(const AlignedPolymorphicAllocator<U, Alignment> &other) const noexcept
+            {
+                return *resource == *other.getResource();
+            }
+
+        private:
+            std::pmr::memory_resource *resource;
+        };
+
+    } // namespace pmr
+
+} // namespace polann::core
@@ -5,28 +5,83 @@
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <numeric>
+#include <concepts>
 #include <stdexcept>
 #include <filesystem>
+#include <memory_resource>
+#include "polann/core/aligned_allocator.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/thread_pool.hpp"
 
 namespace polann::core
 {
+    /**
+     * @brief Sample generator concept for parallel dataset fills
+     *
+     * Called as gen(sampleIndex, inputRow, outputRow) and must write both rows.
+     * Invocations happen concurrently from several threads.
+     */
+    template <typename Gen, size_t InputSize, size_t OutputSize>
+    concept SampleGenerator = std::invocable<Gen &, size_t, std::span<float, InputSize>, std::span<float, OutputSize>>;
+
+    /**
+     * @brief Anything NN::fit and NN::evaluate can iterate in batches
+     *
+     * Satisfied by Dataset and DatasetView.
+     */
+    template <typename T>
+    concept BatchSource = requires(T &t, const T &ct, size_t n, const Normalizer<T::inputSize> *norm) {
+        { T::inputSize } -> std::convertible_to<size_t>;
+        { T::outputSize } -> std::convertible_to<size_t>;
+        { ct.size() } -> std::convertible_to<size_t>;
+        { ct.numBatches(n) } -> std::convertible_to<size_t>;
+        { ct.getBatch(n, n, norm) } -> std::same_as<std::pair<std::span<const float>, std::span<const float>>>;
+        t.shuffle();
+    };
+
     /**
      * @brief Dataset structure for neural network training
      *
      * @tparam InputSize Number of features per input sample
      * @tparam OutputSize Number of features per output sample
+     * @tparam Allocator Float allocator used for all sample and batch storage
      */
-    template <size_t InputSize, size_t OutputSize>
+    template <size_t InputSize, size_t OutputSize, typename Allocator = AlignedAllocator<float>>
     struct Dataset
     {
-        std::vector<float> inputs;   /// Flattened row-major input matrix: numSamples * InputSize
-        std::vector<float> outputs;  /// Flattened row-major output matrix: numSamples * OutputSize
-        std::vector<size_t> indices; /// Shuffled indices for batching
+        using allocator_type = Allocator;
+        using FloatVector = std::vector<float, Allocator>;
+        using SampleVector = std::vector<float, DefaultInitAllocator<Allocator>>; /// Grows without zero-filling
+        using IndexVector = std::vector<size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>>;
+
+        static constexpr size_t inputSize = InputSize;
+        static constexpr size_t outputSize = OutputSize;
+
+        SampleVector inputs;  /// Flattened row-major input matrix: numSamples * InputSize
+        SampleVector outputs; /// Flattened row-major output matrix: numSamples * OutputSize
+        IndexVector indices; /// Shuffled indices for batching
         size_t numSamples = 0;
 
         // Batch buffers to avoid repeated allocations
-        mutable std::vector<float> batchInputBuffer;
-        mutable std::vector<float> batchOutputBuffer;
+        mutable FloatVector batchInputBuffer;
+        mutable FloatVector batchOutputBuffer;
+
+        Dataset() = default;
+
+        /**
+         * @brief Construct with an allocator instance shared by all internal buffers
+         *
+         * @param alloc Allocator (e.g. pmr::AlignedPolymorphicAllocator bound to an arena)
+         */
+        explicit Dataset(const Allocator &alloc)
+            : inputs(alloc), outputs(alloc), indices(alloc), batchInputBuffer(alloc), batchOutputBuffer(alloc) {}
+
+        Dataset(const Dataset &) = default;
+        Dataset(Dataset &&) noexcept = default;
+        Dataset &operator=(const Dataset &) = default;
+        Dataset &operator=(Dataset &&) noexcept = default;
+        virtual ~Dataset() = default;
 
         // File I/O interface
         virtual void fromFile(const std::filesystem::path &path) {}
@@ -43,6 +98,7 @@ namespace polann::core
             if (in.size() != InputSize || out.size() != OutputSize)
                 throw std::invalid_argument("Input/output size mismatch");
 
+            growToFit(1);
             inputs.insert(inputs.end(), in.begin(), in.end());
             outputs.insert(outputs.end(), out.begin(), out.end());
             indices.push_back(numSamples++);
@@ -60,11 +116,79 @@ namespace polann::core
             static_assert(InSize == InputSize, "Input size mismatch");
             static_assert(OutSize == OutputSize, "Output size mismatch");
 
+            growToFit(1);
             inputs.insert(inputs.end(), in.begin(), in.end());
             outputs.insert(outputs.end(), out.begin(), out.end());
             indices.push_back(numSamples++);
         }
 
+        /**
+         * @brief Append many samples from contiguous row-major spans
+         *
+         * @param in Flattened inputs (multiple of InputSize)
+         * @param out Flattened outputs (same number of rows as in)
+         */
+        void addSamples(std::span<const float> in, std::span<const float> out)
+        {
+            if (in.size() % InputSize != 0 || out.size() % OutputSize != 0)
+                throw std::invalid_argument("Input/output size mismatch");
+
+            const size_t count = in.size() / InputSize;
+            if (out.size() / OutputSize != count)
+                throw std::invalid_argument("Input/output sample count mismatch");
+
+            growToFit(count);
+            inputs.insert(inputs.end(), in.begin(), in.end());
+            outputs.insert(outputs.end(), out.begin(), out.end());
+            appendIndices(count);
+        }
+
+        /**
+         * @brief Append samples produced by a generator, filled in parallel
+         *
+         * Storage for all new rows is allocated once up front but not zeroed.
+         * The range is then split into contiguous chunks that the pool's threads
+         * write in place, so each new page is first touched by the thread that
+         * fills it. The generator must write every element of both rows.
+         *
+         * @param count Number of samples to generate
+         * @param gen Generator invoked once per new sample (see SampleGenerator)
+         * @param pool Threads to fill on
+         */
+        template <SampleGenerator<InputSize, OutputSize> Generator>
+        void addSamples(size_t count, Generator &&gen, ThreadPool &pool = ThreadPool::global())
+        {
+            if (count == 0)
+                return;
+
+            const size_t first = numSamples;
+            growToFit(count);
+            inputs.resize((first + count) * InputSize);
+            outputs.resize((first + count) * OutputSize);
+
+            try
+            {
+                pool.parallelFor(0, count, [&](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        std::span<float, InputSize> in(inputs.data() + (first + i) * InputSize, InputSize);
+                        std::span<float, OutputSize> out(outputs.data() + (first + i) * OutputSize, OutputSize);
+                        gen(first + i, in, out);
+                    }
+                });
+            }
+            catch (...)
+            {
+                // Roll back the partially generated rows
+                inputs.resize(first * InputSize);
+                outputs.resize(first * OutputSize);
+                throw;
+            }
+
+            appendIndices(count);
+        }
+
         void shuffle()
         {
             std::random_device rd;
@@ -80,6 +204,16 @@ namespace polann::core
 
         size_t size() const { return numSamples; }
 
+        std::span<const float, InputSize> inputRow(size_t sample) const
+        {
+            return std::span<const float, InputSize>(inputs.data() + sample * InputSize, InputSize);
+        }
+
+        std::span<const float, OutputSize> outputRow(size_t sample) const
+        {
+            return std::span<const float, OutputSize>(outputs.data() + sample * OutputSize, OutputSize);
+        }
+
         /**
          * @brief Compute the number of batches for a given batch size
          *
@@ -98,9 +232,11 @@ namespace polann::core
          *
          * @param batchIndex Index of the batch (0-based)
          * @param batchSize Maximum number of samples in this batch
+         * @param transform Optional normalizer applied to inputs while gathering
          * @return Pair of flattened row-major spans: (inputs, outputs)
          */
-        std::pair<std::span<const float>, std::span<const float>> getBatch(size_t batchIndex, size_t batchSize) const
+        std::pair<std::span<const float>, std::span<const float>> getBatch(
+            size_t batchIndex, size_t batchSize, const Normalizer<InputSize> *transform = nullptr) const
         {
             if (batchSize == 0)
                 throw std::invalid_argument("Batch size cannot be zero");
@@ -123,16 +259,35 @@ namespace polann::core
                 batchOutputBuffer.resize(requiredOutputSize);
 
             // Gather samples according to shuffled indices
-            for (size_t i = 0; i < actualBatchSize; ++i)
+            std::span<float> batchInputs(batchInputBuffer.data(), requiredInputSize);
+            std::span<float> batchOutputs(batchOutputBuffer.data(), requiredOutputSize);
+            gather(std::span(indices).subspan(startSample, actualBatchSize), batchInputs, batchOutputs, transform);
+
+            return {batchInputs, batchOutputs};
+        }
+
+        /**
+         * @brief Copy the given sample rows into contiguous row-major buffers
+         *
+         * Shared by getBatch and by views that own their own index order.
+         *
+         * @param rows Sample indices to gather, in batch order
+         * @param inDst Destination for rows.size() * InputSize input values
+         * @param outDst Destination for rows.size() * OutputSize output values
+         * @param transform Optional normalizer fused into the input copy
+         */
+        void gather(std::span<const size_t> rows, std::span<float> inDst, std::span<float> outDst,
+                    const Normalizer<InputSize> *transform = nullptr) const
+        {
+            for (size_t i = 0; i < rows.size(); ++i)
             {
-                size_t sampleIdx = indices[startSample + i];
-                std::copy_n(inputs.data() + sampleIdx * InputSize, InputSize, batchInputBuffer.data() + i * InputSize);
-                std::copy_n(outputs.data() + sampleIdx * OutputSize, OutputSize, batchOutputBuffer.data() + i * OutputSize);
+                size_t sampleIdx = rows[i];
+                if (transform)
+                    transform->apply(inputs.data() + sampleIdx * InputSize, inDst.data() + i * InputSize);
+                else
+                    std::copy_n(inputs.data() + sampleIdx * InputSize, InputSize, inDst.data() + i * InputSize);
+                std::copy_n(outputs.data() + sampleIdx * OutputSize, OutputSize, outDst.data() + i * OutputSize);
             }
-
-            return {
-                std::span(batchInputBuffer.data(), requiredInputSize),
-                std::span(batchOutputBuffer.data(), requiredOutputSize)};
         }
 
         /**
@@ -144,6 +299,45 @@ namespace polann::core
             outputs.reserve(expectedSamples * OutputSize);
             indices.reserve(expectedSamples);
         }
+
+    private:
+        static constexpr size_t minGrowthSamples = 1024;
+
+        void appendIndices(size_t count)
+        {
+            indices.resize(numSamples + count);
+            std::iota(indices.begin() + numSamples, indices.end(), numSamples);
+            numSamples += count;
+        }
+
+        /**
+         * @brief Grow all sample buffers together before count more samples overflow them
+         *
+         * This only restates std::vector's own geometric growth, on one schedule
+         * for all three buffers. It does not make appending cheaper: whenever the
+         * capacity runs out, addSample and addSamples still copy the whole
+         * dataset into the new storage (O(log n) times in total). Use reserve()
+         * up front to avoid the copies.
+         */
+        void growToFit(size_t count)
+        {
+            if (numSamples + count <= indices.capacity())
+                return;
+            reserve((std::max)({numSamples + count, numSamples * 2, minGrowthSamples}));
+        }
     };
 
+    namespace pmr
+    {
+        /**
+         * @brief Dataset whose buffers are drawn from a shared std::pmr::memory_resource
+         *
+         * Construct with a resource pointer to place several datasets in one arena:
+         * `pmr::Dataset<2, 1> ds(&arena);`
+         */
+        template <size_t InputSize, size_t OutputSize>
+        using Dataset = core::Dataset<InputSize, OutputSize, AlignedPolymorphicAllocator<float>>;
+
+    } // namespace pmr
+
 } // namespace polann::core
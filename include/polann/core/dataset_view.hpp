@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cmath>
+#include <span>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include "polann/core/dataset.hpp"
+
+namespace polann::core
+{
+    /**
+     * @brief Non-owning view over a subset of a dataset's samples
+     *
+     * Shares the source's inputs/outputs storage and owns only an index
+     * permutation plus its own batch buffers. The source must outlive the view.
+     *
+     * @tparam Source Underlying dataset type
+     */
+    template <typename Source>
+    class DatasetView
+    {
+    public:
+        static constexpr size_t inputSize = Source::inputSize;
+        static constexpr size_t outputSize = Source::outputSize;
+
+        /**
+         * @brief View over all samples of the source in storage order
+         */
+        explicit DatasetView(const Source &source)
+            : source(&source), indices(source.size()), gen(std::random_device{}())
+        {
+            std::iota(indices.begin(), indices.end(), size_t{0});
+        }
+
+        /**
+         * @brief View over the given sample indices of the source
+         *
+         * @param source Dataset to view
+         * @param sampleIndices Indices into the source (each < source.size())
+         */
+        DatasetView(const Source &source, std::vector<size_t> sampleIndices)
+            : source(&source), indices(std::move(sampleIndices)), gen(std::random_device{}())
+        {
+            for (size_t idx : indices)
+                if (idx >= source.size())
+                    throw std::out_of_range("View index out of range");
+        }
+
+        /**
+         * @brief Shuffle with the view's own generator (see seed())
+         */
+        void shuffle() { std::shuffle(indices.begin(), indices.end(), gen); }
+
+        void shuffle(unsigned int seed)
+        {
+            std::default_random_engine seeded(seed);
+            std::shuffle(indices.begin(), indices.end(), seeded);
+        }
+
+        /**
+         * @brief Reseed the generator behind shuffle(), making the epoch order reproducible
+         */
+        void seed(unsigned int seed) { gen.seed(seed); }
+
+        size_t size() const { return indices.size(); }
+
+        std::span<const size_t> sampleIndices() const { return indices; }
+
+        const Source &base() const { return *source; }
+
+        auto inputRow(size_t sample) const { return source->inputRow(indices[sample]); }
+
+        auto outputRow(size_t sample) const { return source->outputRow(indices[sample]); }
+
+        /**
+         * @brief Compute the number of batches for a given batch size
+         *
+         * @param batchSize Number of samples per batch
+         * @return Number of batches needed to cover the view
+         */
+        size_t numBatches(size_t batchSize) const
+        {
+            if (batchSize == 0)
+                throw std::invalid_argument("Batch size cannot be zero");
+            return (indices.size() + batchSize - 1) / batchSize;
+        }
+
+        /**
+         * @brief Get a batch of inputs and outputs as contiguous spans
+         *
+         * @param batchIndex Index of the batch (0-based)
+         * @param batchSize Maximum number of samples in this batch
+         * @param transform Optional normalizer applied to inputs while gathering
+         * @return Pair of flattened row-major spans: (inputs, outputs)
+         */
+        std::pair<std::span<const float>, std::span<const float>> getBatch(
+            size_t batchIndex, size_t batchSize, const Normalizer<inputSize> *transform = nullptr) const
+        {
+            if (batchIndex >= numBatches(batchSize))
+                throw std::out_of_range("Batch index out of range");
+
+            size_t startSample = batchIndex * batchSize;
+            size_t actualBatchSize = (std::min)(batchSize, indices.size() - startSample);
+
+            size_t requiredInputSize = actualBatchSize * inputSize;
+            size_t requiredOutputSize = actualBatchSize * outputSize;
+
+            if (batchInputBuffer.size() < requiredInputSize)
+                batchInputBuffer.resize(requiredInputSize);
+
+            if (batchOutputBuffer.size() < requiredOutputSize)
+                batchOutputBuffer.resize(requiredOutputSize);
+
+            std::span<float> batchInputs(batchInputBuffer.data(), requiredInputSize);
+            std::span<float> batchOutputs(batchOutputBuffer.data(), requiredOutputSize);
+            source->gather(std::span(indices).subspan(startSample, actualBatchSize), batchInputs, batchOutputs, transform);
+
+            return {batchInputs, batchOutputs};
+        }
+
+    private:
+        const Source *source;
+        std::vector<size_t> indices;
+        std::default_random_engine gen; /// Drives shuffle(); random unless seeded
+
+        // Batch buffers to avoid repeated allocations
+        mutable std::vector<float, AlignedAllocator<float>> batchInputBuffer;
+        mutable std::vector<float, AlignedAllocator<float>> batchOutputBuffer;
+    };
+
+    /**
+     * @brief Train/validation/test partition of a dataset as views
+     */
+    template <typename Source>
+    struct DatasetSplit
+    {
+        DatasetView<Source> train;
+        DatasetView<Source> validation;
+        DatasetView<Source> test;
+    };
+
+    /**
+     * @brief One cross-validation fold
+     */
+    template <typename Source>
+    struct DatasetFold
+    {
+        DatasetView<Source> train;
+        DatasetView<Source> validation;
+    };
+
+    namespace detail
+    {
+        inline std::vector<size_t> permutation(size_t n, unsigned int seed)
+        {
+            std::vector<size_t> perm(n);
+            std::iota(perm.begin(), perm.end(), size_t{0});
+            std::default_random_engine gen(seed);
+            std::shuffle(perm.begin(), perm.end(), gen);
+            return perm;
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Randomly split a dataset into train, validation and test views
+     *
+     * @param source Dataset to split (not copied)
+     * @param validationFraction Fraction of samples assigned to validation
+     * @param testFraction Fraction of samples assigned to test
+     * @param seed Seed for the split permutation
+     * @return DatasetSplit with disjoint views covering all samples
+     */
+    template <typename Source>
+    [[nodiscard]] DatasetSplit<Source> split(const Source &source, float validationFraction, float testFraction = 0.0f, unsigned int seed = 0)
+    {
+        if (validationFraction < 0.0f || testFraction < 0.0f || validationFraction + testFraction > 1.0f)
+            throw std::invalid_argument("Split fractions must be non-negative and sum to at most 1");
+
+        auto perm = detail::permutation(source.size(), seed);
+
+        // In double: float products round past n once n exceeds 2^24
+        const double n = static_cast<double>(perm.size());
+        size_t numValidation = (std::min)(static_cast<size_t>(std::floor(static_cast<double>(validationFraction) * n)), perm.size());
+        size_t numTest = (std::min)(static_cast<size_t>(std::floor(static_cast<double>(testFraction) * n)), perm.size() - numValidation);
+        size_t numTrain = perm.size() - numValidation - numTest;
+
+        auto first = perm.begin();
+        return {
+            DatasetView<Source>(source, std::vector<size_t>(first, first + numTrain)),
+            DatasetView<Source>(source, std::vector<size_t>(first + numTrain, first + numTrain + numValidation)),
+            DatasetView<Source>(source, std::vector<size_t>(first + numTrain + numValidation, perm.end()))};
+    }
+
+    /**
+     * @brief Build k cross-validation folds over a dataset
+     *
+     * Every sample appears in exactly one validation view. Only index arrays
+     * are allocated; all folds share the source storage.
+     *
+     * @param source Dataset to partition (not copied)
+     * @param k Number of folds (2 <= k <= source.size())
+     * @param seed Seed for the fold assignment
+     * @return Vector of k folds
+     */
+    template <typename Source>
+    [[nodiscard]] std::vector<DatasetFold<Source>> kFold(const Source &source, size_t k, unsigned int seed = 0)
+    {
+        if (k < 2 || k > source.size())
+            throw std::invalid_argument("Fold count must be in [2, dataset size]");
+
+        auto perm = detail::permutation(source.size(), seed);
+
+        std::vector<DatasetFold<Source>> folds;
+        folds.reserve(k);
+
+        for (size_t f = 0; f < k; ++f)
+        {
+            size_t begin = f * perm.size() / k;
+            size_t end = (f + 1) * perm.size() / k;
+
+            std::vector<size_t> trainIdx;
+            trainIdx.reserve(perm.size() - (end - begin));
+            trainIdx.insert(trainIdx.end(), perm.begin(), perm.begin() + begin);
+            trainIdx.insert(trainIdx.end(), perm.begin() + end, perm.end());
+
+            folds.push_back({DatasetView<Source>(source, std::move(trainIdx)),
+                             DatasetView<Source>(source, std::vector<size_t>(perm.begin() + begin, perm.begin() + end))});
+        }
+
+        return folds;
+    }
+
+} // namespace polann::core
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include "polann/core/dataset.hpp"
+#include "polann/core/encoding.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/aligned_allocator.hpp"
+
+namespace polann::core
+{
+    /**
+     * @brief Dataset storing inputs in a compact encoding
+     *
+     * Inputs are kept as fp16, bf16 or int8 and decoded to fp32 row by row while
+     * a batch is gathered, so 2-4x more samples stay resident for the same memory
+     * bandwidth. Outputs stay fp32. Satisfies BatchSource and works with
+     * DatasetView, Normalizer and NN::fit like Dataset does.
+     *
+     * @tparam InputSize Number of features per input sample
+     * @tparam OutputSize Number of features per output sample
+     * @tparam Encoding Codec template from polann::core::encoding (Float16, BFloat16, Int8)
+     * @tparam Allocator Float allocator used for sample and batch storage
+     */
+    template <size_t InputSize, size_t OutputSize, template <size_t> class Encoding, typename Allocator = AlignedAllocator<float>>
+    struct EncodedDataset
+    {
+        using Codec = Encoding<InputSize>;
+        using storage_type = typename Codec::storage_type;
+        using FloatVector = std::vector<float, Allocator>;
+        using CodeVector = std::vector<storage_type, typename std::allocator_traits<Allocator>::template rebind_alloc<storage_type>>;
+        using IndexVector = std::vector<size_t, typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>>;
+
+        static constexpr size_t inputSize = InputSize;
+        static constexpr size_t outputSize = OutputSize;
+
+        Codec codec;         /// Encoding parameters (e.g. per-column int8 scale)
+        CodeVector inputs;   /// Flattened row-major encoded input matrix: numSamples * InputSize
+        FloatVector outputs; /// Flattened row-major output matrix: numSamples * OutputSize
+        IndexVector indices; /// Shuffled indices for batching
+        size_t numSamples = 0;
+
+        // Batch buffers to avoid repeated allocations
+        mutable FloatVector batchInputBuffer;
+        mutable FloatVector batchOutputBuffer;
+
+        EncodedDataset() = default;
+
+        /**
+         * @brief Construct with explicit codec parameters
+         *
+         * @param codec Codec (required for Int8 when samples are added incrementally)
+         * @param alloc Allocator shared by all internal buffers
+         * @throws std::invalid_argument if the codec is not calibrated (e.g. a default Int8)
+         */
+        explicit EncodedDataset(const Codec &codec, const Allocator &alloc = Allocator())
+            : codec(codec), inputs(alloc), outputs(alloc), indices(alloc), batchInputBuffer(alloc), batchOutputBuffer(alloc)
+        {
+            requireCalibrated();
+        }
+
+        /**
+         * @brief Encode an existing fp32 dataset, calibrating the codec on it
+         *
+         * Samples are stored in the source's row order (a view's index order).
+         *
+         * @param source Dataset or DatasetView with fp32 inputs
+         * @return Encoded copy of the source
+         */
+        template <typename Source>
+        [[nodiscard]] static EncodedDataset encode(const Source &source)
+        {
+            static_assert(Source::inputSize == InputSize && Source::outputSize == OutputSize, "Dataset shape mismatch");
+
+            EncodedDataset result(Codec::calibrate(source));
+            result.reserve(source.size());
+            for (size_t i = 0; i < source.size(); ++i)
+            {
+                auto row = source.inputRow(i);
+                result.appendRow(row.data(), source.outputRow(i).data());
+            }
+            return result;
+        }
+
+        /**
+         * @brief Add a sample, encoding its inputs
+         *
+         * @param in Span of input features (must be InputSize)
+         * @param out Span of output features (must be OutputSize)
+         * @throws std::invalid_argument on a size mismatch or an uncalibrated codec
+         */
+        void addSample(std::span<const float> in, std::span<const float> out)
+        {
+            if (in.size() != InputSize || out.size() != OutputSize)
+                throw std::invalid_argument("Input/output size mismatch");
+            requireCalibrated();
+
+            appendRow(in.data(), out.data());
+        }
+
+        /**
+         * @brief Append many samples from contiguous row-major spans
+         *
+         * @param in Flattened inputs (multiple of InputSize)
+         * @param out Flattened outputs (same number of rows as in)
+         * @throws std::invalid_argument on a size mismatch or an uncalibrated codec
+         */
+        void addSamples(std::span<const float> in, std::span<const float> out)
+        {
+            if (in.size() % InputSize != 0 || out.size() % OutputSize != 0)
+                throw std::invalid_argument("Input/output size mismatch");
+            requireCalibrated();
+
+            const size_t count = in.size() / InputSize;
+            if (out.size() / OutputSize != count)
+                throw std::invalid_argument("Input/output sample count mismatch");
+
+            reserve(numSamples + count);
+            for (size_t i = 0; i < count; ++i)
+                appendRow(in.data() + i * InputSize, out.data() + i * OutputSize);
+        }
+
+        void shuffle()
+        {
+            std::random_device rd;
+            std::default_random_engine gen(rd());
+            std::shuffle(indices.begin(), indices.end(), gen);
+        }
+
+        void shuffle(unsigned int seed)
+        {
+            std::default_random_engine gen(seed);
+            std::shuffle(indices.begin(), indices.end(), gen);
+        }
+
+        size_t size() const { return numSamples; }
+
+        /**
+         * @brief Decoded copy of one input row
+         */
+        std::array<float, InputSize> inputRow(size_t sample) const
+        {
+            std::array<float, InputSize> row;
+            codec.decode(inputs.data() + sample * InputSize, row.data());
+            return row;
+        }
+
+        std::span<const float, OutputSize> outputRow(size_t sample) const
+        {
+            return std::span<const float, OutputSize>(outputs.data() + sample * OutputSize, OutputSize);
+        }
+
+        /**
+         * @brief Compute the number of batches for a given batch size
+         *
+         * @param batchSize Number of samples per batch
+         * @return Number of batches needed to cover the dataset
+         */
+        size_t numBatches(size_t batchSize) const
+        {
+            if (batchSize == 0)
+                throw std::invalid_argument("Batch size cannot be zero");
+            return (numSamples + batchSize - 1) / batchSize;
+        }
+
+        /**
+         * @brief Get a decoded batch of inputs and outputs as contiguous spans
+         *
+         * @param batchIndex Index of the batch (0-based)
+         * @param batchSize Maximum number of samples in this batch
+         * @param transform Optional normalizer applied to inputs after decoding
+         * @return Pair of flattened row-major spans: (inputs, outputs)
+         */
+        std::pair<std::span<const float>, std::span<const float>> getBatch(
+            size_t batchIndex, size_t batchSize, const Normalizer<InputSize> *transform = nullptr) const
+        {
+            if (batchIndex >= numBatches(batchSize))
+                throw std::out_of_range("Batch index out of range");
+
+            size_t startSample = batchIndex * batchSize;
+            size_t actualBatchSize = (std::min)(batchSize, numSamples - startSample);
+
+            size_t requiredInputSize = actualBatchSize * InputSize;
+            size_t requiredOutputSize = actualBatchSize * OutputSize;
+
+            if (batchInputBuffer.size() < requiredInputSize)
+                batchInputBuffer.resize(requiredInputSize);
+
+            if (batchOutputBuffer.size() < requiredOutputSize)
+                batchOutputBuffer.resize(requiredOutputSize);
+
+            std::span<float> batchInputs(batchInputBuffer.data(), requiredInputSize);
+            std::span<float> batchOutputs(batchOutputBuffer.data(), requiredOutputSize);
+            gather(std::span(indices).subspan(startSample, actualBatchSize), batchInputs, batchOutputs, transform);
+
+            return {batchInputs, batchOutputs};
+        }
+
+        /**
+         * @brief Decode the given sample rows into contiguous row-major buffers
+         *
+         * Each row is decoded straight into the batch buffer and, if requested,
+         * normalized in place while still in L1.
+         *
+         * @param rows Sample indices to gather, in batch order
+         * @param inDst Destination for rows.size() * InputSize input values
+         * @param outDst Destination for rows.size() * OutputSize output values
+         * @param transform Optional normalizer applied after decoding
+         */
+        void gather(std::span<const size_t> rows, std::span<float> inDst, std::span<float> outDst,
+                    const Normalizer<InputSize> *transform = nullptr) const
+        {
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                size_t sampleIdx = rows[i];
+                float *row = inDst.data() + i * InputSize;
+
+                codec.decode(inputs.data() + sampleIdx * InputSize, row);
+                if (transform)
+                    transform->apply(row, row);
+
+                std::copy_n(outputs.data() + sampleIdx * OutputSize, OutputSize, outDst.data() + i * OutputSize);
+            }
+        }
+
+        /**
+         * @brief Reserve memory for expected number of samples
+         */
+        void reserve(size_t expectedSamples)
+        {
+            inputs.reserve(expectedSamples * InputSize);
+            outputs.reserve(expectedSamples * OutputSize);
+            indices.reserve(expectedSamples);
+        }
+
+    private:
+        // A default Int8 codec would silently clamp every value into [-128, 127]
+        void requireCalibrated() const
+        {
+            if (!codec.calibrated())
+                throw std::invalid_argument("Codec is not calibrated; use encode() or Codec::calibrate()");
+        }
+
+        void appendRow(const float *in, const float *out)
+        {
+            if (indices.size() == indices.capacity())
+                reserve((std::max)(numSamples * 2, size_t{1024}));
+
+            inputs.resize(inputs.size() + InputSize);
+            codec.encode(in, inputs.data() + numSamples * InputSize);
+            outputs.insert(outputs.end(), out, out + OutputSize);
+            indices.push_back(numSamples++);
+        }
+    };
+
+    template <size_t InputSize, size_t OutputSize>
+    using Float16Dataset = EncodedDataset<InputSize, OutputSize, encoding::Float16>;
+
+    template <size_t InputSize, size_t OutputSize>
+    using BFloat16Dataset = EncodedDataset<InputSize, OutputSize, encoding::BFloat16>;
+
+    template <size_t InputSize, size_t OutputSize>
+    using Int8Dataset = EncodedDataset<InputSize, OutputSize, encoding::Int8>;
+
+} // namespace polann::core
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "polann/config.h"
+#include "polann/core/normalizer.hpp"
+
+#ifdef POLANN_ENABLE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace polann::core::encoding
+{
+    /**
+     * @brief Convert an IEEE binary32 value to binary16 (round to nearest even)
+     */
+    [[nodiscard]] inline uint16_t floatToHalf(float value)
+    {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        uint32_t abs = bits & 0x7FFFFFFFu;
+
+        if (abs >= 0x7F800000u) // Inf or NaN (keep NaN quiet)
+            return sign | 0x7C00u | (abs > 0x7F800000u ? 0x0200u : 0u);
+        if (abs >= 0x477FF000u) // Rounds past the largest finite half
+            return sign | 0x7C00u;
+        if (abs < 0x38800000u) // Result is subnormal (or zero) in half precision
+            return sign | static_cast<uint16_t>(std::nearbyint(std::bit_cast<float>(abs) * 16777216.0f));
+
+        uint32_t rebased = abs - 0x38000000u; // Rebias exponent from 127 to 15
+        rebased += 0x0FFFu + ((rebased >> 13) & 1u);
+        return sign | static_cast<uint16_t>(rebased >> 13);
+    }
+
+    /**
+     * @brief Convert an IEEE binary16 value to binary32 (exact)
+     */
+    [[nodiscard]] inline float halfToFloat(uint16_t half)
+    {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x03FFu;
+
+        if (exponent == 0) // Zero or subnormal
+        {
+            float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // 2^-24
+            return sign ? -magnitude : magnitude;
+        }
+
+        if (exponent == 0x1Fu) // Inf or NaN
+            return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+
+        return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    }
+
+    /**
+     * @brief Convert an IEEE binary32 value to bfloat16 (round to nearest even)
+     */
+    [[nodiscard]] inline uint16_t floatToBFloat16(float value)
+    {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+            return static_cast<uint16_t>((bits >> 16) | 0x0040u); // Keep NaN quiet
+
+        bits += 0x7FFFu + ((bits >> 16) & 1u);
+        return static_cast<uint16_t>(bits >> 16);
+    }
+
+    [[nodiscard]] inline float bfloat16ToFloat(uint16_t value)
+    {
+        return std::bit_cast<float>(static_cast<uint32_t>(value) << 16);
+    }
+
+    /**
+     * @brief IEEE half precision storage (2 bytes per feature)
+     *
+     * @tparam Features Number of features per row
+     */
+    template <size_t Features>
+    struct Float16
+    {
+        using storage_type = uint16_t;
+
+        template <typename Source>
+        [[nodiscard]] static Float16 calibrate(const Source &) { return {}; }
+
+        [[nodiscard]] static constexpr bool calibrated() { return true; }
+
+        void encode(const float *in, storage_type *out) const
+        {
+            for (size_t j = 0; j < Features; ++j)
+                out[j] = floatToHalf(in[j]);
+        }
+
+        void decode(const storage_type *in, float *out) const
+        {
+            size_t j = 0;
+#ifdef POLANN_ENABLE_AVX2
+            for (; j + 8 <= Features; j += 8)
+            {
+                __m128i vHalf = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + j));
+                _mm256_storeu_ps(out + j, _mm256_cvtph_ps(vHalf)); // F16C conversion
+            }
+#endif
+            for (; j < Features; ++j)
+                out[j] = halfToFloat(in[j]);
+        }
+    };
+
+    /**
+     * @brief bfloat16 storage: fp32 range with 8 mantissa bits (2 bytes per feature)
+     *
+     * @tparam Features Number of features per row
+     */
+    template <size_t Features>
+    struct BFloat16
+    {
+        using storage_type = uint16_t;
+
+        template <typename Source>
+        [[nodiscard]] static BFloat16 calibrate(const Source &) { return {}; }
+
+        [[nodiscard]] static constexpr bool calibrated() { return true; }
+
+        void encode(const float *in, storage_type *out) const
+        {
+            for (size_t j = 0; j < Features; ++j)
+                out[j] = floatToBFloat16(in[j]);
+        }
+
+        void decode(const storage_type *in, float *out) const
+        {
+            size_t j = 0;
+#ifdef POLANN_ENABLE_AVX2
+            for (; j + 8 <= Features; j += 8)
+            {
+                // Widen to 32 bits and move into the upper half of each lane
+                __m256i vWide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + j)));
+                _mm256_storeu_ps(out + j, _mm256_castsi256_ps(_mm256_slli_epi32(vWide, 16)));
+            }
+#endif
+            for (; j < Features; ++j)
+                out[j] = bfloat16ToFloat(in[j]);
+        }
+    };
+
+    /**
+     * @brief Affine int8 quantization with per-column scale and offset (1 byte per feature)
+     *
+     * Decodes as x = offset + scale * q with q in [-128, 127]. Values outside the
+     * calibrated range are clamped and NaN encodes as q = 0, the middle of the
+     * range. A default-constructed codec has zero scales
+     * and is unusable until calibrate() or explicit parameters fill them in.
+     *
+     * @tparam Features Number of features per row
+     */
+    template <size_t Features>
+    struct Int8
+    {
+        using storage_type = int8_t;
+
+        std::array<float, Features> scale{}; /// Zero until calibrated
+        std::array<float, Features> offset{};
+
+        /**
+         * @brief Derive per-column parameters from the min/max of a source
+         *
+         * @tparam Source Dataset or DatasetView with fp32 inputs
+         */
+        template <typename Source>
+        [[nodiscard]] static Int8 calibrate(const Source &source)
+        {
+            auto range = Normalizer<Features>::fit(source, NormalizationMode::MinMax);
+
+            Int8 result;
+            for (size_t j = 0; j < Features; ++j)
+            {
+                result.scale[j] = (1.0f / range.scale[j]) / 255.0f;
+                result.offset[j] = range.shift[j] + 128.0f * result.scale[j];
+            }
+            return result;
+        }
+
+        /**
+         * @brief Whether every column has a usable (positive, finite) scale
+         */
+        [[nodiscard]] bool calibrated() const
+        {
+            return std::ranges::all_of(scale, [](float s) { return s > 0.0f && std::isfinite(s); });
+        }
+
+        void encode(const float *in, storage_type *out) const
+        {
+            for (size_t j = 0; j < Features; ++j)
+            {
+                float q = std::nearbyint((in[j] - offset[j]) / scale[j]);
+                out[j] = std::isnan(q) ? storage_type{0} : static_cast<storage_type>(std::clamp(q, -128.0f, 127.0f));
+            }
+        }
+
+        void decode(const storage_type *in, float *out) const
+        {
+            size_t j = 0;
+#ifdef POLANN_ENABLE_AVX2
+            for (; j + 8 <= Features; j += 8)
+            {
+                __m256i vQ = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + j)));
+                __m256 vScale = _mm256_loadu_ps(scale.data() + j);
+                __m256 vOffset = _mm256_loadu_ps(offset.data() + j);
+                _mm256_storeu_ps(out + j, _mm256_fmadd_ps(_mm256_cvtepi32_ps(vQ), vScale, vOffset));
+            }
+#endif
+            for (; j < Features; ++j)
+#ifdef POLANN_ENABLE_AVX2
+                out[j] = std::fma(static_cast<float>(in[j]), scale[j], offset[j]); // Same rounding as the vector lanes
+#else
+                out[j] = offset[j] + scale[j] * static_cast<float>(in[j]);
+#endif
+        }
+    };
+
+} // namespace polann::core::encoding
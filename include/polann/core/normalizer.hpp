@@ -0,0 +1,188 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/core/thread_pool.hpp"
+
+namespace polann::core
+{
+    enum class NormalizationMode : uint8_t
+    {
+        ZScore, /// (x - mean) / stddev
+        MinMax  /// (x - min) / (max - min)
+    };
+
+    /**
+     * @brief Per-feature affine input transform y = (x - shift) * scale
+     *
+     * Statistics are computed in one streaming pass (Welford) and the transform
+     * is applied while rows are gathered into a batch or copied into predict's
+     * input buffer, so normalized data never exists as a separate copy.
+     *
+     * @tparam Features Number of input features
+     */
+    template <size_t Features>
+    struct Normalizer
+    {
+        NormalizationMode mode = NormalizationMode::ZScore;
+        std::array<float, Features> shift{};
+        std::array<float, Features> scale{};
+
+        Normalizer() { scale.fill(1.0f); }
+
+        /**
+         * @brief Compute normalization statistics over all samples of a source
+         *
+         * The source is split into one contiguous chunk per pool thread. Each
+         * chunk accumulates Welford moments and min/max, and the partial results
+         * are merged pairwise (Chan et al.).
+         *
+         * @tparam Source Dataset or DatasetView; must provide size() and inputRow(i)
+         * @param source Samples to analyse (typically the training split)
+         * @param mode Transform to derive from the statistics
+         * @param pool Threads to scan on
+         * @return Fitted normalizer
+         */
+        template <typename Source>
+        [[nodiscard]] static Normalizer fit(const Source &source, NormalizationMode mode = NormalizationMode::ZScore,
+                                            ThreadPool &pool = ThreadPool::global())
+        {
+            static_assert(Source::inputSize == Features, "Feature count mismatch");
+
+            const size_t count = source.size();
+            if (count == 0)
+                throw std::invalid_argument("Cannot fit normalizer on an empty dataset");
+
+            const size_t chunk = (count + pool.concurrency() - 1) / pool.concurrency();
+            std::vector<Moments> partials((count + chunk - 1) / chunk);
+            pool.parallelFor(0, count, chunk, [&](size_t begin, size_t end)
+            {
+                Moments &partial = partials[begin / chunk];
+                for (size_t i = begin; i < end; ++i)
+                    partial.add(source.inputRow(i));
+            });
+
+            Moments total;
+            for (const auto &partial : partials)
+                total.merge(partial);
+
+            Normalizer result;
+            result.mode = mode;
+            for (size_t j = 0; j < Features; ++j)
+            {
+                double range = mode == NormalizationMode::ZScore
+                                   ? std::sqrt(total.m2[j] / static_cast<double>(total.count))
+                                   : total.max[j] - total.min[j];
+
+                result.shift[j] = static_cast<float>(mode == NormalizationMode::ZScore ? total.mean[j] : total.min[j]);
+                result.scale[j] = range > 0.0 ? static_cast<float>(1.0 / range) : 1.0f; // Leave constant features unscaled
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Transform one row
+         *
+         * @param in Raw feature values
+         * @param out Destination for normalized values (may alias in)
+         */
+        void apply(const float *in, float *out) const
+        {
+            for (size_t j = 0; j < Features; ++j)
+                out[j] = (in[j] - shift[j]) * scale[j];
+        }
+
+        /**
+         * @brief Write the normalizer in binary form
+         */
+        void save(std::ostream &os) const
+        {
+            uint64_t features = Features;
+            os.write(reinterpret_cast<const char *>(&features), sizeof(features));
+            os.write(reinterpret_cast<const char *>(&mode), sizeof(mode));
+            os.write(reinterpret_cast<const char *>(shift.data()), sizeof(float) * Features);
+            os.write(reinterpret_cast<const char *>(scale.data()), sizeof(float) * Features);
+        }
+
+        /**
+         * @brief Read a normalizer written by save()
+         */
+        [[nodiscard]] static Normalizer load(std::istream &is)
+        {
+            uint64_t features = 0;
+            is.read(reinterpret_cast<char *>(&features), sizeof(features));
+            if (!is || features != Features)
+                throw std::runtime_error("Normalizer feature count mismatch");
+
+            Normalizer result;
+            is.read(reinterpret_cast<char *>(&result.mode), sizeof(result.mode));
+            if (!is || result.mode > NormalizationMode::MinMax)
+                throw std::runtime_error("Unknown normalization mode");
+            is.read(reinterpret_cast<char *>(result.shift.data()), sizeof(float) * Features);
+            is.read(reinterpret_cast<char *>(result.scale.data()), sizeof(float) * Features);
+            if (!is)
+                throw std::runtime_error("Truncated normalizer data");
+
+            return result;
+        }
+
+        bool operator==(const Normalizer &) const = default;
+
+    private:
+        // Streaming per-feature statistics in double precision
+        struct Moments
+        {
+            size_t count = 0;
+            std::array<double, Features> mean{};
+            std::array<double, Features> m2{};
+            std::array<float, Features> min;
+            std::array<float, Features> max;
+
+            Moments()
+            {
+                min.fill(std::numeric_limits<float>::infinity());
+                max.fill(-std::numeric_limits<float>::infinity());
+            }
+
+            void add(std::span<const float, Features> row)
+            {
+                ++count;
+                for (size_t j = 0; j < Features; ++j)
+                {
+                    double delta = row[j] - mean[j];
+                    mean[j] += delta / static_cast<double>(count);
+                    m2[j] += delta * (row[j] - mean[j]);
+                    min[j] = (std::min)(min[j], row[j]);
+                    max[j] = (std::max)(max[j], row[j]);
+                }
+            }
+
+            void merge(const Moments &other)
+            {
+                if (other.count == 0)
+                    return;
+
+                double n = static_cast<double>(count + other.count);
+                for (size_t j = 0; j < Features; ++j)
+                {
+                    double delta = other.mean[j] - mean[j];
+                    mean[j] += delta * static_cast<double>(other.count) / n;
+                    m2[j] += other.m2[j] + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / n;
+                    min[j] = (std::min)(min[j], other.min[j]);
+                    max[j] = (std::max)(max[j], other.max[j]);
+                }
+                count += other.count;
+            }
+        };
+    };
+
+} // namespace polann::core
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+#include <type_traits>
+#include <condition_variable>
+#include "polann/config.h"
+
+#ifdef POLANN_PLATFORM_LINUX
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+namespace polann::core
+{
+    /**
+     * @brief Placement of ThreadPool workers
+     */
+    struct ThreadPoolOptions
+    {
+        bool pinThreads = false; /// Pin each worker to one CPU (Linux only)
+        bool numaAware = false;  /// Spread workers round-robin over NUMA nodes (Linux only)
+    };
+
+    /**
+     * @brief Work-stealing thread pool shared by training, evaluation and data loading
+     *
+     * Every worker owns a task deque. It pops its own tasks LIFO and, when it
+     * runs dry, steals FIFO from the other workers. The thread that calls
+     * parallelFor takes part in the loop, so a pool with N workers runs a loop
+     * on N + 1 threads, and a pool without workers runs it inline.
+     *
+     * parallelFor is also the per-batch fork-join point: it returns only after
+     * every chunk has run. It may be called from inside pool tasks.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param numWorkers Worker threads in addition to the caller; 0 = no
+         *        workers, loops run on the caller (the default is hardware
+         *        concurrency - 1)
+         * @param options CPU pinning and NUMA placement
+         */
+        explicit ThreadPool(size_t numWorkers = defaultWorkerCount(), ThreadPoolOptions options = {})
+            : queues(numWorkers)
+        {
+            for (auto &queue : queues)
+                queue = std::make_unique<Queue>();
+
+            std::vector<std::vector<int>> placement = workerPlacement(numWorkers, options);
+
+            workers.reserve(numWorkers);
+            for (size_t i = 0; i < numWorkers; ++i)
+            {
+                workers.emplace_back([this, i] { workerLoop(i); });
+                if (!placement.empty())
+                    pin(workers.back(), placement[i]);
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock(sleepMutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            workers.clear(); // Join
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Process-wide pool used when no pool is passed explicitly
+         */
+        static ThreadPool &global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        static size_t defaultWorkerCount()
+        {
+            return (std::max)(1u, std::thread::hardware_concurrency()) - 1;
+        }
+
+        [[nodiscard]] size_t workerCount() const { return workers.size(); }
+
+        /**
+         * @brief Threads that execute a parallelFor: the workers plus the caller
+         */
+        [[nodiscard]] size_t concurrency() const { return workers.size() + 1; }
+
+        /**
+         * @brief Run a callable on a worker
+         *
+         * @return Future holding the result or the thrown exception
+         */
+        template <typename F>
+        auto submit(F &&task) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<F>>;
+            std::packaged_task<Result()> packaged(std::forward<F>(task));
+            auto future = packaged.get_future();
+
+            if (workers.empty())
+                packaged();
+            else
+                push(std::move(packaged));
+
+            return future;
+        }
+
+        /**
+         * @brief Split [begin, end) into chunks of at most grain indices and run them in parallel
+         *
+         * Chunks are claimed dynamically, so uneven chunk costs balance out. The
+         * first exception thrown by body is rethrown after all chunks finished;
+         * chunks not yet started at that point are skipped.
+         *
+         * @param begin First index
+         * @param end One past the last index
+         * @param grain Maximum indices per chunk (0 is treated as 1)
+         * @param body Callable invoked as body(chunkBegin, chunkEnd)
+         */
+        template <typename F>
+        void parallelFor(size_t begin, size_t end, size_t grain, F &&body)
+        {
+            if (begin >= end)
+                return;
+
+            grain = (std::max)(grain, size_t{1});
+            const size_t chunks = (end - begin + grain - 1) / grain;
+
+            if (chunks == 1 || workers.empty())
+            {
+                for (size_t first = begin; first < end; first += grain)
+                    body(first, (std::min)(first + grain, end));
+                return;
+            }
+
+            // Shared with helper tasks that may start after this call returned
+            auto loop = std::make_shared<Loop>();
+            loop->chunks = chunks;
+            loop->run = [&body, begin, end, grain](size_t chunk)
+            {
+                size_t first = begin + chunk * grain;
+                body(first, (std::min)(first + grain, end));
+            };
+
+            size_t helpers = (std::min)(chunks - 1, workers.size());
+            for (size_t h = 0; h < helpers; ++h)
+                push([loop] { loop->work(); });
+
+            loop->work();
+
+            // Claimed chunks are running on active threads, so this terminates
+            size_t done = loop->completed.load(std::memory_order_acquire);
+            while (done < chunks)
+            {
+                loop->completed.wait(done, std::memory_order_acquire);
+                done = loop->completed.load(std::memory_order_acquire);
+            }
+
+            loop->run = nullptr; // body goes out of scope with this frame
+            if (loop->error)
+                std::rethrow_exception(loop->error);
+        }
+
+        /**
+         * @brief parallelFor with about one chunk per thread
+         */
+        template <typename F>
+        void parallelFor(size_t begin, size_t end, F &&body)
+        {
+            size_t grain = (end > begin ? end - begin : 0) / concurrency() + 1;
+            parallelFor(begin, end, grain, std::forward<F>(body));
+        }
+
+    private:
+        using Task = std::move_only_function<void()>;
+
+        struct alignas(64) Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct Loop
+        {
+            std::function<void(size_t)> run;
+            size_t chunks = 0;
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> completed{0};
+            std::atomic<bool> failed{false};
+            std::mutex errorMutex;
+            std::exception_ptr error;
+
+            void work()
+            {
+                for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+                     chunk = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    if (!failed.load(std::memory_order_relaxed))
+                    {
+                        try
+                        {
+                            run(chunk);
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard lock(errorMutex);
+                            if (!error)
+                                error = std::current_exception();
+                            failed = true;
+                        }
+                    }
+
+                    if (completed.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks)
+                        completed.notify_all();
+                }
+            }
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::jthread> workers;
+        std::atomic<size_t> nextQueue{0};
+        std::atomic<size_t> queued{0};
+
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        static constexpr size_t notAWorker = static_cast<size_t>(-1);
+
+        // Index of the calling thread within the pool that owns it
+        static size_t &workerIndex()
+        {
+            thread_local size_t index = notAWorker;
+            return index;
+        }
+
+        static const ThreadPool *&workerPool()
+        {
+            thread_local const ThreadPool *pool = nullptr;
+            return pool;
+        }
+
+        void push(Task task)
+        {
+            // Workers keep their own tasks local; other threads distribute round-robin
+            size_t target = workerPool() == this ? workerIndex()
+                                                 : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard lock(queues[target]->mutex);
+                queues[target]->tasks.push_back(std::move(task));
+            }
+            {
+                std::lock_guard lock(sleepMutex);
+                queued.fetch_add(1, std::memory_order_release);
+            }
+            wake.notify_one();
+        }
+
+        bool tryPop(size_t self, Task &task)
+        {
+            // Own queue first, newest task (still warm in cache)
+            {
+                std::lock_guard lock(queues[self]->mutex);
+                if (!queues[self]->tasks.empty())
+                {
+                    task = std::move(queues[self]->tasks.back());
+                    queues[self]->tasks.pop_back();
+                    return true;
+                }
+            }
+
+            // Steal the oldest task of another worker
+            for (size_t k = 1; k < queues.size(); ++k)
+            {
+                Queue &victim = *queues[(self + k) % queues.size()];
+                std::unique_lock lock(victim.mutex, std::try_to_lock);
+                if (lock.owns_lock() && !victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void workerLoop(size_t self)
+        {
+            workerIndex() = self;
+            workerPool() = this;
+
+            Task task;
+            while (true)
+            {
+                if (tryPop(self, task))
+                {
+                    queued.fetch_sub(1, std::memory_order_acq_rel);
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+
+                std::unique_lock lock(sleepMutex);
+                wake.wait(lock, [&] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+                if (stopping && queued.load(std::memory_order_acquire) == 0)
+                    return;
+            }
+        }
+
+        // CPU sets per worker, empty when no placement was requested or possible
+        static std::vector<std::vector<int>> workerPlacement(size_t numWorkers, ThreadPoolOptions options)
+        {
+#ifdef POLANN_PLATFORM_LINUX
+            if (numWorkers == 0 || (!options.pinThreads && !options.numaAware))
+                return {};
+
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+                return {};
+
+            // CPUs per NUMA node, restricted to the ones this process may use
+            std::vector<std::vector<int>> nodes;
+            if (options.numaAware)
+            {
+                for (int node = 0;; ++node)
+                {
+                    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                    if (!file)
+                        break;
+
+                    std::string list;
+                    std::getline(file, list);
+                    std::vector<int> cpus;
+                    for (int cpu : parseCpuList(list))
+                        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                            cpus.push_back(cpu);
+                    if (!cpus.empty())
+                        nodes.push_back(std::move(cpus));
+                }
+            }
+
+            if (nodes.empty())
+            {
+                std::vector<int> cpus;
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                    if (CPU_ISSET(cpu, &allowed))
+                        cpus.push_back(cpu);
+                nodes.push_back(std::move(cpus));
+            }
+
+            // Worker i goes to node i % nodes; pinned workers take consecutive CPUs there
+            std::vector<std::vector<int>> placement(numWorkers);
+            for (size_t i = 0; i < numWorkers; ++i)
+            {
+                const std::vector<int> &cpus = nodes[i % nodes.size()];
+                if (options.pinThreads)
+                    placement[i] = {cpus[(i / nodes.size()) % cpus.size()]};
+                else
+                    placement[i] = cpus;
+            }
+            return placement;
+#else
+            (void)numWorkers;
+            (void)options;
+            return {};
+#endif
+        }
+
+        // Parses the kernel's "0-3,8,10-11" CPU list format
+        static std::vector<int> parseCpuList(const std::string &list)
+        {
+            std::vector<int> cpus;
+            size_t pos = 0;
+            while (pos < list.size())
+            {
+                size_t comma = list.find(',', pos);
+                std::string range = list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+                size_t dash = range.find('-');
+                try
+                {
+                    int first = std::stoi(range.substr(0, dash));
+                    int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; ++cpu)
+                        cpus.push_back(cpu);
+                }
+                catch (const std::exception &)
+                {
+                    // Ignore malformed entries
+                }
+
+                if (comma == std::string::npos)
+                    break;
+                pos = comma + 1;
+            }
+            return cpus;
+        }
+
+        static void pin([[maybe_unused]] std::jthread &thread, [[maybe_unused]] const std::vector<int> &cpus)
+        {
+#ifdef POLANN_PLATFORM_LINUX
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus)
+                CPU_SET(cpu, &set);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set); // Best effort
+#endif
+        }
+    };
+
+} // namespace polann::core
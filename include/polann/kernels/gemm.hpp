@@ -0,0 +1,227 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "polann/config.h"
+#include "polann/core/aligned_allocator.hpp"
+
+// With POLANN_COMPILED_KERNELS the SIMD kernels live in the polann library,
+// built for several instruction sets and picked at runtime; otherwise they
+// are inline and compiled into every user. Small problems stay inline either
+// way, where the caller's constant shapes let them fold.
+#ifdef POLANN_COMPILED_KERNELS
+#define POLANN_GEMM_API POLANN_API
+#else
+#define POLANN_GEMM_API inline
+#endif
+
+namespace polann::kernels
+{
+    enum class Transpose : bool
+    {
+        No,
+        Yes
+    };
+
+    namespace gemm
+    {
+        // Register tile of the micro-kernel: 6 rows x 16 columns = 12 ymm accumulators
+        inline constexpr size_t mr = 6;
+        inline constexpr size_t nr = 16;
+
+        // Cache blocking: a kc x nr panel of B stays in L1, an mc x kc block of
+        // packed A in L2 and a kc x nc block of packed B in L3
+        inline constexpr size_t mc = 168;
+        inline constexpr size_t kc = 256;
+        inline constexpr size_t nc = 4080;
+
+        // Below this many multiply-adds packing costs more than it saves
+        inline constexpr size_t smallProblem = 4096;
+
+        using Buffer = std::vector<float, polann::core::AlignedAllocator<float>>;
+
+        /**
+         * @brief Strided GEMM of the shapes the SIMD kernels are not worth it for
+         *
+         * Computes C for an empty C, k == 0, alpha == 0 and anything below
+         * smallProblem multiply-adds. Strides are as for sgemmBlocked.
+         *
+         * @return Whether C was computed; if not, call sgemmBlocked
+         */
+        inline bool sgemmSmall(size_t m, size_t n, size_t k, float alpha,
+                               const float *a, size_t aRowStride, size_t aColStride,
+                               const float *b, size_t bRowStride, size_t bColStride,
+                               float beta, float *c, size_t ldc)
+        {
+            if (m == 0 || n == 0)
+                return true;
+
+            if (k == 0 || alpha == 0.0f)
+            {
+                for (size_t i = 0; i < m; ++i)
+                    for (size_t j = 0; j < n; ++j)
+                        c[i * ldc + j] = beta == 0.0f ? 0.0f : beta * c[i * ldc + j];
+                return true;
+            }
+
+            if (m * n * k > smallProblem)
+                return false;
+
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < n; ++j)
+                {
+                    float sum = 0.0f;
+                    for (size_t p = 0; p < k; ++p)
+                        sum += a[i * aRowStride + p * aColStride] * b[p * bRowStride + j * bColStride];
+                    float &out = c[i * ldc + j];
+                    out = beta == 0.0f ? alpha * sum : alpha * sum + beta * out;
+                }
+            return true;
+        }
+
+        /**
+         * @brief Cache-blocked GEMM core: C = alpha * A * B + beta * C
+         *
+         * A is m x k with element (i, p) at a[i * aRowStride + p * aColStride],
+         * B is k x n with element (p, j) at b[p * bRowStride + j * bColStride],
+         * C is row-major m x n with leading dimension ldc. Expects m, n, k > 0.
+         */
+        POLANN_GEMM_API void sgemmBlocked(size_t m, size_t n, size_t k, float alpha,
+                                          const float *a, size_t aRowStride, size_t aColStride,
+                                          const float *b, size_t bRowStride, size_t bColStride,
+                                          float beta, float *c, size_t ldc);
+    } // namespace gemm
+
+    /**
+     * @brief B operand of sgemmPacked, stored once in the kernel's panel layout
+     *
+     * Blocks follow sgemm's NC/KC loop order; each holds nr-column panels with
+     * nr contiguous, 64-byte aligned values per k and zero padding past n.
+     */
+    struct PackedMatrix
+    {
+        size_t rows = 0; /// k
+        size_t cols = 0; /// n
+        gemm::Buffer data;
+
+        [[nodiscard]] bool empty() const { return data.empty(); }
+    };
+
+    /**
+     * @brief Single-precision GEMM on row-major matrices: C = alpha * op(A) * op(B) + beta * C
+     *
+     * Goto/BLIS-style: B and A are packed into cache-blocked panels and a 6x16
+     * register-tiled micro-kernel (AVX2 + FMA when available) computes C. When
+     * beta is 0, C is not read.
+     *
+     * @param transA Whether A is stored transposed (k x m)
+     * @param transB Whether B is stored transposed (n x k)
+     * @param m Rows of op(A) and C
+     * @param n Columns of op(B) and C
+     * @param k Columns of op(A), rows of op(B)
+     * @param lda Row stride of A as stored
+     * @param ldb Row stride of B as stored
+     * @param ldc Row stride of C
+     */
+    inline void sgemm(Transpose transA, Transpose transB, size_t m, size_t n, size_t k,
+                      float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                      float beta, float *c, size_t ldc)
+    {
+        bool ta = transA == Transpose::Yes;
+        bool tb = transB == Transpose::Yes;
+        size_t aRowStride = ta ? 1 : lda, aColStride = ta ? lda : 1;
+        size_t bRowStride = tb ? 1 : ldb, bColStride = tb ? ldb : 1;
+
+        if (!gemm::sgemmSmall(m, n, k, alpha, a, aRowStride, aColStride, b, bRowStride, bColStride, beta, c, ldc))
+            gemm::sgemmBlocked(m, n, k, alpha, a, aRowStride, aColStride, b, bRowStride, bColStride, beta, c, ldc);
+    }
+
+    /**
+     * @brief Pack op(B) (k x n) for repeated use with sgemmPacked
+     *
+     * @param transB Whether B is stored transposed (n x k)
+     * @param ldb Row stride of B as stored
+     */
+    [[nodiscard]] POLANN_GEMM_API PackedMatrix packMatrix(Transpose transB, size_t k, size_t n, const float *b, size_t ldb);
+
+    /**
+     * @brief C = alpha * A * B + beta * C with B prepacked by packMatrix
+     *
+     * Skips packing B on every call. A single row (m == 1) runs a matrix-vector
+     * kernel streaming the panels directly.
+     *
+     * @param m Rows of A and C
+     * @param a Row-major A, m x b.rows
+     * @param lda Row stride of A
+     * @param b Packed B
+     * @param ldc Row stride of C
+     */
+    POLANN_GEMM_API void sgemmPacked(size_t m, float alpha, const float *a, size_t lda, const PackedMatrix &b,
+                                     float beta, float *c, size_t ldc);
+
+    /**
+     * @brief Instruction set the GEMM kernels run with: "avx2" or "generic"
+     *
+     * Fixed at compile time for inline kernels, chosen from the CPU on first
+     * use for compiled ones.
+     */
+    [[nodiscard]] POLANN_GEMM_API const char *kernelVariant();
+
+    /**
+     * @brief Straightforward triple loop with the same contract as sgemm, for testing and benchmarks
+     */
+    inline void sgemmReference(Transpose transA, Transpose transB, size_t m, size_t n, size_t k,
+                               float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                               float beta, float *c, size_t ldc)
+    {
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                float sum = 0.0f;
+                for (size_t p = 0; p < k; ++p)
+                {
+                    float av = transA == Transpose::Yes ? a[p * lda + i] : a[i * lda + p];
+                    float bv = transB == Transpose::Yes ? b[j * ldb + p] : b[p * ldb + j];
+                    sum += av * bv;
+                }
+                c[i * ldc + j] = beta == 0.0f ? alpha * sum : alpha * sum + beta * c[i * ldc + j];
+            }
+    }
+
+} // namespace polann::kernels
+
+#ifndef POLANN_COMPILED_KERNELS
+#include "polann/kernels/gemm_impl.hpp"
+
+namespace polann::kernels
+{
+    inline void gemm::sgemmBlocked(size_t m, size_t n, size_t k, float alpha,
+                                   const float *a, size_t aRowStride, size_t aColStride,
+                                   const float *b, size_t bRowStride, size_t bColStride,
+                                   float beta, float *c, size_t ldc)
+    {
+        native::sgemmBlocked(m, n, k, alpha, a, aRowStride, aColStride, b, bRowStride, bColStride, beta, c, ldc);
+    }
+
+    inline PackedMatrix packMatrix(Transpose transB, size_t k, size_t n, const float *b, size_t ldb)
+    {
+        return gemm::native::packMatrix(transB, k, n, b, ldb);
+    }
+
+    inline void sgemmPacked(size_t m, float alpha, const float *a, size_t lda, const PackedMatrix &b,
+                            float beta, float *c, size_t ldc)
+    {
+        gemm::native::sgemmPacked(m, alpha, a, lda, b, beta, c, ldc);
+    }
+
+    inline const char *kernelVariant()
+    {
+#ifdef POLANN_GEMM_AVX2
+        return "avx2";
+#else
+        return "generic";
+#endif
+    }
+
+} // namespace polann::kernels
+#endif
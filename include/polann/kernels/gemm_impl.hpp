@@ -0,0 +1,392 @@
+#pragma once
+
+/*
+ * SIMD kernels behind the GEMM entry points declared in gemm.hpp.
+ *
+ * Everything lives in gemm::POLANN_GEMM_TARGET so one program can hold
+ * several builds of it side by side: the polann library compiles this header
+ * once per instruction set and dispatches at runtime (src/kernels), while
+ * header-only builds get the "native" copy for whatever the including
+ * translation unit is compiled for. The AVX2 paths follow the compiler's own
+ * target macros rather than POLANN_ENABLE_AVX2 for the same reason.
+ *
+ * A translation unit that defines POLANN_GEMM_AVX2 itself gets the AVX2
+ * kernels without being compiled for AVX2: only the functions below carry the
+ * target, so the standard library code it instantiates stays safe to share
+ * with the rest of the program on any CPU.
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include "polann/kernels/gemm.hpp"
+
+#if !defined(POLANN_GEMM_AVX2) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#define POLANN_GEMM_AVX2
+#endif
+
+#ifdef POLANN_GEMM_AVX2
+#include <immintrin.h>
+#endif
+
+// MSVC accepts AVX2 intrinsics anywhere; GCC and Clang need the function target
+#if defined(POLANN_GEMM_AVX2) && !defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+#define POLANN_GEMM_FUNCTION __attribute__((target("avx2,fma"))) inline
+#else
+#define POLANN_GEMM_FUNCTION inline
+#endif
+
+#ifndef POLANN_GEMM_TARGET
+#define POLANN_GEMM_TARGET native
+#endif
+
+namespace polann::kernels::gemm::POLANN_GEMM_TARGET
+{
+    /**
+     * @brief Copy an m x k block of A into row panels of mr rows
+     *
+     * Each panel is stored column by column (mr contiguous values per k).
+     * Rows past m are zero-filled so the micro-kernel never branches.
+     */
+    POLANN_GEMM_FUNCTION void packA(const float *a, size_t rowStride, size_t colStride, size_t m, size_t k, float *dst)
+    {
+        for (size_t i0 = 0; i0 < m; i0 += mr)
+        {
+            size_t rows = (std::min)(mr, m - i0);
+            for (size_t p = 0; p < k; ++p)
+            {
+                size_t i = 0;
+                for (; i < rows; ++i)
+                    dst[i] = a[(i0 + i) * rowStride + p * colStride];
+                for (; i < mr; ++i)
+                    dst[i] = 0.0f;
+                dst += mr;
+            }
+        }
+    }
+
+    /**
+     * @brief Copy a k x n block of B into column panels of nr columns
+     *
+     * Each panel is stored row by row (nr contiguous values per k).
+     */
+    POLANN_GEMM_FUNCTION void packB(const float *b, size_t rowStride, size_t colStride, size_t k, size_t n, float *dst)
+    {
+        for (size_t j0 = 0; j0 < n; j0 += nr)
+        {
+            size_t cols = (std::min)(nr, n - j0);
+            for (size_t p = 0; p < k; ++p)
+            {
+                const float *src = b + p * rowStride + j0 * colStride;
+                size_t j = 0;
+                if (colStride == 1)
+                {
+                    for (; j < cols; ++j)
+                        dst[j] = src[j];
+                }
+                else
+                {
+                    for (; j < cols; ++j)
+                        dst[j] = src[j * colStride];
+                }
+                for (; j < nr; ++j)
+                    dst[j] = 0.0f;
+                dst += nr;
+            }
+        }
+    }
+
+    /**
+     * @brief C[mr x nr] = alpha * A_panel * B_panel + beta * C (portable version)
+     */
+    POLANN_GEMM_FUNCTION void microKernelScalar(size_t k, const float *a, const float *b, float *c, size_t ldc, float alpha, float beta)
+    {
+        // One row of C at a time: nr accumulators fit the SIMD registers of any target
+        for (size_t i = 0; i < mr; ++i)
+        {
+            float acc[nr] = {};
+            for (size_t p = 0; p < k; ++p)
+            {
+                float ai = a[p * mr + i];
+                for (size_t j = 0; j < nr; ++j)
+                    acc[j] += ai * b[p * nr + j];
+            }
+
+            for (size_t j = 0; j < nr; ++j)
+                c[i * ldc + j] = beta == 0.0f ? alpha * acc[j] : alpha * acc[j] + beta * c[i * ldc + j];
+        }
+    }
+
+#ifdef POLANN_GEMM_AVX2
+    /**
+     * @brief row[0..16) = va * (lo, hi) + vb * row, without reading row when beta is 0
+     */
+    POLANN_GEMM_FUNCTION void storeRowAvx2(float *row, __m256 lo, __m256 hi, __m256 va, __m256 vb, float beta)
+    {
+        if (beta == 0.0f)
+        {
+            _mm256_storeu_ps(row, _mm256_mul_ps(va, lo));
+            _mm256_storeu_ps(row + 8, _mm256_mul_ps(va, hi));
+        }
+        else
+        {
+            _mm256_storeu_ps(row, _mm256_fmadd_ps(vb, _mm256_loadu_ps(row), _mm256_mul_ps(va, lo)));
+            _mm256_storeu_ps(row + 8, _mm256_fmadd_ps(vb, _mm256_loadu_ps(row + 8), _mm256_mul_ps(va, hi)));
+        }
+    }
+
+    /**
+     * @brief C[6 x 16] = alpha * A_panel * B_panel + beta * C with 12 FMA accumulators
+     */
+    POLANN_GEMM_FUNCTION void microKernelAvx2(size_t k, const float *a, const float *b, float *c, size_t ldc, float alpha, float beta)
+    {
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+        __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+        for (size_t p = 0; p < k; ++p)
+        {
+            __m256 b0 = _mm256_load_ps(b);
+            __m256 b1 = _mm256_load_ps(b + 8);
+
+            __m256 ai = _mm256_broadcast_ss(a);
+            c00 = _mm256_fmadd_ps(ai, b0, c00);
+            c01 = _mm256_fmadd_ps(ai, b1, c01);
+            ai = _mm256_broadcast_ss(a + 1);
+            c10 = _mm256_fmadd_ps(ai, b0, c10);
+            c11 = _mm256_fmadd_ps(ai, b1, c11);
+            ai = _mm256_broadcast_ss(a + 2);
+            c20 = _mm256_fmadd_ps(ai, b0, c20);
+            c21 = _mm256_fmadd_ps(ai, b1, c21);
+            ai = _mm256_broadcast_ss(a + 3);
+            c30 = _mm256_fmadd_ps(ai, b0, c30);
+            c31 = _mm256_fmadd_ps(ai, b1, c31);
+            ai = _mm256_broadcast_ss(a + 4);
+            c40 = _mm256_fmadd_ps(ai, b0, c40);
+            c41 = _mm256_fmadd_ps(ai, b1, c41);
+            ai = _mm256_broadcast_ss(a + 5);
+            c50 = _mm256_fmadd_ps(ai, b0, c50);
+            c51 = _mm256_fmadd_ps(ai, b1, c51);
+
+            a += mr;
+            b += nr;
+        }
+
+        const __m256 va = _mm256_set1_ps(alpha);
+        const __m256 vb = _mm256_set1_ps(beta);
+        storeRowAvx2(c, c00, c01, va, vb, beta);
+        storeRowAvx2(c + ldc, c10, c11, va, vb, beta);
+        storeRowAvx2(c + 2 * ldc, c20, c21, va, vb, beta);
+        storeRowAvx2(c + 3 * ldc, c30, c31, va, vb, beta);
+        storeRowAvx2(c + 4 * ldc, c40, c41, va, vb, beta);
+        storeRowAvx2(c + 5 * ldc, c50, c51, va, vb, beta);
+    }
+#endif
+
+    POLANN_GEMM_FUNCTION void microKernel(size_t k, const float *a, const float *b, float *c, size_t ldc, float alpha, float beta)
+    {
+#ifdef POLANN_GEMM_AVX2
+        microKernelAvx2(k, a, b, c, ldc, alpha, beta);
+#else
+        microKernelScalar(k, a, b, c, ldc, alpha, beta);
+#endif
+    }
+
+    /**
+     * @brief Micro-kernel on a tile cut off by the matrix edge, via a full-size scratch tile
+     */
+    POLANN_GEMM_FUNCTION void edgeKernel(size_t k, const float *a, const float *b, float *c, size_t ldc,
+                           size_t rows, size_t cols, float alpha, float beta)
+    {
+        alignas(32) float tile[mr * nr];
+        microKernel(k, a, b, tile, nr, 1.0f, 0.0f);
+
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+            {
+                float &out = c[i * ldc + j];
+                out = beta == 0.0f ? alpha * tile[i * nr + j] : alpha * tile[i * nr + j] + beta * out;
+            }
+    }
+
+    /**
+     * @brief Blocked loop nest shared by sgemmBlocked and sgemmPacked
+     *
+     * @param prepacked B already in panel layout (see packMatrix), or nullptr
+     *        to pack B from its strides block by block
+     */
+    POLANN_GEMM_FUNCTION void blocked(size_t m, size_t n, size_t k, float alpha,
+                        const float *a, size_t aRowStride, size_t aColStride,
+                        const float *b, size_t bRowStride, size_t bColStride,
+                        const float *prepacked, float beta, float *c, size_t ldc)
+    {
+        // Packing buffers are reused across calls on the same thread
+        thread_local Buffer packedA;
+        thread_local Buffer packedB;
+        packedA.resize((std::max)(packedA.size(), ((std::min)(m, mc) + mr - 1) / mr * mr * (std::min)(k, kc)));
+        if (!prepacked)
+            packedB.resize((std::max)(packedB.size(), ((std::min)(n, nc) + nr - 1) / nr * nr * (std::min)(k, kc)));
+
+        for (size_t jc = 0; jc < n; jc += nc)
+        {
+            size_t ncBlock = (std::min)(nc, n - jc);
+            for (size_t pc = 0; pc < k; pc += kc)
+            {
+                size_t kcBlock = (std::min)(kc, k - pc);
+                float betaBlock = pc == 0 ? beta : 1.0f; // Later k blocks accumulate
+
+                // Prepacked blocks are stored in exactly this loop order
+                const float *bBlock = prepacked;
+                if (prepacked)
+                    prepacked += (ncBlock + nr - 1) / nr * nr * kcBlock;
+                else
+                {
+                    packB(b + pc * bRowStride + jc * bColStride, bRowStride, bColStride, kcBlock, ncBlock, packedB.data());
+                    bBlock = packedB.data();
+                }
+
+                for (size_t ic = 0; ic < m; ic += mc)
+                {
+                    size_t mcBlock = (std::min)(mc, m - ic);
+                    packA(a + ic * aRowStride + pc * aColStride, aRowStride, aColStride, mcBlock, kcBlock, packedA.data());
+
+                    for (size_t jr = 0; jr < ncBlock; jr += nr)
+                    {
+                        size_t cols = (std::min)(nr, ncBlock - jr);
+                        const float *bPanel = bBlock + jr * kcBlock;
+
+                        for (size_t ir = 0; ir < mcBlock; ir += mr)
+                        {
+                            size_t rows = (std::min)(mr, mcBlock - ir);
+                            const float *aPanel = packedA.data() + ir * kcBlock;
+                            float *cTile = c + (ic + ir) * ldc + jc + jr;
+
+                            if (rows == mr && cols == nr)
+                                microKernel(kcBlock, aPanel, bPanel, cTile, ldc, alpha, betaBlock);
+                            else
+                                edgeKernel(kcBlock, aPanel, bPanel, cTile, ldc, rows, cols, alpha, betaBlock);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief y[0..n) = alpha * x * B + beta * y on a prepacked B (batch-1 inference)
+     *
+     * Streams every panel once with contiguous loads; no A packing.
+     */
+    POLANN_GEMM_FUNCTION void gemvPacked(size_t n, size_t k, float alpha, const float *x, const float *packed, float beta, float *y)
+    {
+        for (size_t jc = 0; jc < n; jc += nc)
+        {
+            size_t ncBlock = (std::min)(nc, n - jc);
+            for (size_t pc = 0; pc < k; pc += kc)
+            {
+                size_t kcBlock = (std::min)(kc, k - pc);
+                float betaBlock = pc == 0 ? beta : 1.0f;
+                const float *xBlock = x + pc;
+
+                for (size_t jr = 0; jr < ncBlock; jr += nr)
+                {
+                    const float *panel = packed + jr * kcBlock;
+                    alignas(32) float acc[nr];
+#ifdef POLANN_GEMM_AVX2
+                    // Two independent accumulator pairs hide the FMA latency
+                    __m256 lo0 = _mm256_setzero_ps(), hi0 = _mm256_setzero_ps();
+                    __m256 lo1 = _mm256_setzero_ps(), hi1 = _mm256_setzero_ps();
+                    size_t p = 0;
+                    for (; p + 2 <= kcBlock; p += 2)
+                    {
+                        __m256 x0 = _mm256_broadcast_ss(xBlock + p);
+                        __m256 x1 = _mm256_broadcast_ss(xBlock + p + 1);
+                        lo0 = _mm256_fmadd_ps(x0, _mm256_load_ps(panel + p * nr), lo0);
+                        hi0 = _mm256_fmadd_ps(x0, _mm256_load_ps(panel + p * nr + 8), hi0);
+                        lo1 = _mm256_fmadd_ps(x1, _mm256_load_ps(panel + (p + 1) * nr), lo1);
+                        hi1 = _mm256_fmadd_ps(x1, _mm256_load_ps(panel + (p + 1) * nr + 8), hi1);
+                    }
+                    if (p < kcBlock)
+                    {
+                        __m256 x0 = _mm256_broadcast_ss(xBlock + p);
+                        lo0 = _mm256_fmadd_ps(x0, _mm256_load_ps(panel + p * nr), lo0);
+                        hi0 = _mm256_fmadd_ps(x0, _mm256_load_ps(panel + p * nr + 8), hi0);
+                    }
+                    _mm256_store_ps(acc, _mm256_add_ps(lo0, lo1));
+                    _mm256_store_ps(acc + 8, _mm256_add_ps(hi0, hi1));
+#else
+                    std::fill_n(acc, nr, 0.0f);
+                    for (size_t p = 0; p < kcBlock; ++p)
+                        for (size_t j = 0; j < nr; ++j)
+                            acc[j] += xBlock[p] * panel[p * nr + j];
+#endif
+                    size_t cols = (std::min)(nr, ncBlock - jr);
+                    for (size_t j = 0; j < cols; ++j)
+                    {
+                        float &out = y[jc + jr + j];
+                        out = betaBlock == 0.0f ? alpha * acc[j] : alpha * acc[j] + betaBlock * out;
+                    }
+                }
+
+                packed += (ncBlock + nr - 1) / nr * nr * kcBlock;
+            }
+        }
+    }
+
+    POLANN_GEMM_FUNCTION void sgemmBlocked(size_t m, size_t n, size_t k, float alpha,
+                             const float *a, size_t aRowStride, size_t aColStride,
+                             const float *b, size_t bRowStride, size_t bColStride,
+                             float beta, float *c, size_t ldc)
+    {
+        blocked(m, n, k, alpha, a, aRowStride, aColStride, b, bRowStride, bColStride, nullptr, beta, c, ldc);
+    }
+
+    POLANN_GEMM_FUNCTION PackedMatrix packMatrix(Transpose transB, size_t k, size_t n, const float *b, size_t ldb)
+    {
+        bool tb = transB == Transpose::Yes;
+        size_t rowStride = tb ? 1 : ldb;
+        size_t colStride = tb ? ldb : 1;
+
+        PackedMatrix packed{k, n, {}};
+        size_t size = 0;
+        for (size_t jc = 0; jc < n; jc += nc)
+            size += ((std::min)(nc, n - jc) + nr - 1) / nr * nr * k;
+        packed.data.resize(size);
+
+        float *dst = packed.data.data();
+        for (size_t jc = 0; jc < n; jc += nc)
+        {
+            size_t ncBlock = (std::min)(nc, n - jc);
+            for (size_t pc = 0; pc < k; pc += kc)
+            {
+                size_t kcBlock = (std::min)(kc, k - pc);
+                packB(b + pc * rowStride + jc * colStride, rowStride, colStride, kcBlock, ncBlock, dst);
+                dst += (ncBlock + nr - 1) / nr * nr * kcBlock;
+            }
+        }
+        return packed;
+    }
+
+    POLANN_GEMM_FUNCTION void sgemmPacked(size_t m, float alpha, const float *a, size_t lda, const PackedMatrix &b,
+                            float beta, float *c, size_t ldc)
+    {
+        if (m == 0 || b.cols == 0)
+            return;
+
+        if (b.rows == 0)
+        {
+            for (size_t i = 0; i < m; ++i)
+                for (size_t j = 0; j < b.cols; ++j)
+                    c[i * ldc + j] = beta == 0.0f ? 0.0f : beta * c[i * ldc + j];
+            return;
+        }
+
+        if (m == 1)
+            gemvPacked(b.cols, b.rows, alpha, a, b.data.data(), beta, c);
+        else
+            blocked(m, b.cols, b.rows, alpha, a, lda, 1, nullptr, 0, 0, b.data.data(), beta, c, ldc);
+    }
+
+} // namespace polann::kernels::gemm::POLANN_GEMM_TARGET
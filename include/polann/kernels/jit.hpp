@@ -0,0 +1,512 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/config.h"
+#include "polann/kernels/gemm.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+#if defined(POLANN_PLATFORM_LINUX) && defined(POLANN_ENABLE_AVX2) && defined(__x86_64__)
+#define POLANN_JIT_X86_64
+#include <sys/mman.h>
+#endif
+
+namespace polann::kernels
+{
+    /**
+     * @brief One Dense layer of a JitChain, in Dense's parameter layout
+     */
+    struct JitLayer
+    {
+        size_t inputSize = 0;
+        size_t outputSize = 0;
+        const float *weights = nullptr; /// Row-major, outputSize x inputSize
+        const float *biases = nullptr;  /// outputSize values
+        utils::ActivationKind activation = utils::ActivationKind::Identity;
+    };
+
+    namespace jit
+    {
+        enum Reg : uint8_t
+        {
+            rax = 0,
+            rcx = 1,
+            rdx = 2,
+            rbx = 3,
+            rsp = 4,
+            rbp = 5,
+            rsi = 6,
+            rdi = 7,
+            r12 = 12,
+            r13 = 13
+        };
+
+        /**
+         * @brief Emits the handful of x86-64 / AVX2 instructions the chain needs
+         *
+         * Memory operands are always [base + disp32]; vector operands are ymm
+         * register numbers 0-15.
+         */
+        class Assembler
+        {
+        public:
+            std::vector<uint8_t> code;
+
+            void push(Reg r)
+            {
+                if (r >= 8)
+                    byte(0x41);
+                byte(0x50 + (r & 7));
+            }
+
+            void pop(Reg r)
+            {
+                if (r >= 8)
+                    byte(0x41);
+                byte(0x58 + (r & 7));
+            }
+
+            void movImm(Reg r, uint64_t imm)
+            {
+                byte(0x48 | (r >> 3));
+                byte(0xB8 + (r & 7));
+                for (int i = 0; i < 8; ++i)
+                    byte(static_cast<uint8_t>(imm >> (8 * i)));
+            }
+
+            void mov(Reg dst, Reg src)
+            {
+                byte(0x48 | ((src >> 3) << 2) | (dst >> 3));
+                byte(0x89);
+                byte(0xC0 | ((src & 7) << 3) | (dst & 7));
+            }
+
+            void lea(Reg dst, Reg base, int32_t disp)
+            {
+                byte(0x48 | ((dst >> 3) << 2) | (base >> 3));
+                byte(0x8D);
+                memory(dst, base, disp);
+            }
+
+            void addImm(Reg r, int32_t imm)
+            {
+                byte(0x48 | (r >> 3));
+                byte(0x81);
+                byte(0xC0 | (r & 7));
+                dword(static_cast<uint32_t>(imm));
+            }
+
+            void dec(Reg r)
+            {
+                byte(0x48 | (r >> 3));
+                byte(0xFF);
+                byte(0xC8 | (r & 7));
+            }
+
+            [[nodiscard]] size_t label() const { return code.size(); }
+
+            void jnz(size_t target)
+            {
+                byte(0x0F);
+                byte(0x85);
+                dword(static_cast<uint32_t>(static_cast<int32_t>(target - (code.size() + 4))));
+            }
+
+            void call(Reg r)
+            {
+                if (r >= 8)
+                    byte(0x41);
+                byte(0xFF);
+                byte(0xD0 | (r & 7));
+            }
+
+            void ret() { byte(0xC3); }
+
+            void vzeroupper()
+            {
+                byte(0xC5);
+                byte(0xF8);
+                byte(0x77);
+            }
+
+            void vxorps(int dst, int a, int b) { vexRegister(0x57, 1, 0, dst, a, b); }
+
+            void vmaxps(int dst, int a, int b) { vexRegister(0x5F, 1, 0, dst, a, b); }
+
+            void vmovapsLoad(int dst, Reg base, int32_t disp) { vexMemory(0x28, 1, 0, dst, 0, base, disp); }
+
+            void vmovapsStore(Reg base, int32_t disp, int src) { vexMemory(0x29, 1, 0, src, 0, base, disp); }
+
+            void vbroadcastss(int dst, Reg base, int32_t disp) { vexMemory(0x18, 2, 1, dst, 0, base, disp); }
+
+            void vfmadd231ps(int dst, int a, Reg base, int32_t disp) { vexMemory(0xB8, 2, 1, dst, a, base, disp); }
+
+        private:
+            void byte(uint8_t b) { code.push_back(b); }
+
+            void dword(uint32_t d)
+            {
+                for (int i = 0; i < 4; ++i)
+                    byte(static_cast<uint8_t>(d >> (8 * i)));
+            }
+
+            // Three-byte VEX prefix with L = 256 and W = 0; map 1 = 0F, 2 = 0F38; pp 1 = 66
+            void vex(int reg, int rm, int map, int pp, int vvvv)
+            {
+                byte(0xC4);
+                byte(static_cast<uint8_t>((((~reg >> 3) & 1) << 7) | (1 << 6) | (((~rm >> 3) & 1) << 5) | map));
+                byte(static_cast<uint8_t>(((~vvvv & 15) << 3) | (1 << 2) | pp));
+            }
+
+            void memory(int reg, Reg base, int32_t disp)
+            {
+                byte(static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7)));
+                if ((base & 7) == rsp) // rsp and r12 need a SIB byte
+                    byte(0x24);
+                dword(static_cast<uint32_t>(disp));
+            }
+
+            void vexRegister(uint8_t opcode, int map, int pp, int dst, int a, int b)
+            {
+                vex(dst, b, map, pp, a);
+                byte(opcode);
+                byte(static_cast<uint8_t>(0xC0 | ((dst & 7) << 3) | (b & 7)));
+            }
+
+            void vexMemory(uint8_t opcode, int map, int pp, int reg, int vvvv, Reg base, int32_t disp)
+            {
+                vex(reg, base, map, pp, vvvv);
+                byte(opcode);
+                memory(reg, base, disp);
+            }
+        };
+
+        constexpr size_t lanes = 8;          /// Floats per ymm register
+        constexpr size_t maxAccumulators = 8; /// ymm accumulators per output block, 64 outputs
+        constexpr int broadcastRegister = 15;
+        constexpr int zeroRegister = 14;
+
+        constexpr size_t padded(size_t n) { return (n + lanes - 1) / lanes * lanes; }
+
+        template <typename Activation>
+        void applyActivation(float *values, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                values[i] = Activation::compute(values[i]);
+        }
+
+        struct CodeDeleter
+        {
+            size_t size = 0;
+
+            void operator()(uint8_t *code) const
+            {
+#ifdef POLANN_JIT_X86_64
+                munmap(code, size);
+#else
+                (void)code;
+#endif
+            }
+        };
+    } // namespace jit
+
+    /**
+     * @brief Dense layer chain compiled to AVX2 machine code at runtime
+     *
+     * For networks whose shapes are only known at deployment. Weights are
+     * repacked into ymm-wide column panels and their addresses are baked into
+     * the code as immediates. Each output block of up to 64 values is kept in
+     * registers across the whole input loop, then bias-initialized sums get
+     * ReLU applied in registers and are stored once. Sigmoid and Tanh run as
+     * a call into the matching polann activation after the layer's stores.
+     *
+     * Intermediate activations live in a thread-local scratch buffer, so one
+     * chain may be called from several threads. Requires Linux on x86-64
+     * with AVX2 enabled; see supported().
+     */
+    class JitChain
+    {
+    public:
+        /**
+         * @param layers Consecutive layers; parameters are copied
+         * @throws std::invalid_argument on empty or mismatched layers
+         * @throws std::runtime_error if unsupported or executable memory is unavailable
+         */
+        explicit JitChain(std::span<const JitLayer> layers)
+        {
+            if (!supported())
+                throw std::runtime_error("JIT requires Linux on x86-64 with AVX2");
+            if (layers.empty())
+                throw std::invalid_argument("JIT chain needs at least one layer");
+            for (size_t l = 1; l < layers.size(); ++l)
+                if (layers[l].inputSize != layers[l - 1].outputSize)
+                    throw std::invalid_argument("Layer sizes do not chain");
+            for (const auto &layer : layers)
+                if (layer.activation == utils::ActivationKind::Custom)
+                    throw std::invalid_argument("JIT supports Identity, ReLU, Sigmoid and Tanh only");
+
+            inSize = layers.front().inputSize;
+            outSize = layers.back().outputSize;
+            pack(layers);
+            generate(layers);
+        }
+
+        [[nodiscard]] static constexpr bool supported()
+        {
+#ifdef POLANN_JIT_X86_64
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Runs the chain on one sample
+         *
+         * @param in inputSize() values
+         * @param out outputSize() values
+         */
+        void operator()(const float *in, float *out) const
+        {
+            thread_local gemm::Buffer scratch;
+            if (scratch.size() < scratchFloats)
+                scratch.resize(scratchFloats);
+
+            function(in, scratch.data());
+            std::copy_n(scratch.data() + outputOffset, outSize, out);
+        }
+
+        /**
+         * @brief Runs the chain on row-major samples one after another
+         */
+        void run(const float *in, float *out, size_t rows) const
+        {
+            for (size_t r = 0; r < rows; ++r)
+                (*this)(in + r * inSize, out + r * outSize);
+        }
+
+        [[nodiscard]] size_t inputSize() const { return inSize; }
+
+        [[nodiscard]] size_t outputSize() const { return outSize; }
+
+        [[nodiscard]] size_t codeSize() const { return code.get_deleter().size; }
+
+    private:
+        using Function = void (*)(const float *in, float *scratch);
+
+        gemm::Buffer parameters;        /// Packed panels and padded biases, addressed by the code
+        std::vector<size_t> panelOffsets; /// Per layer, in floats into parameters
+        std::vector<size_t> biasOffsets;
+        std::unique_ptr<uint8_t, jit::CodeDeleter> code;
+        Function function = nullptr;
+
+        size_t inSize = 0;
+        size_t outSize = 0;
+        size_t scratchFloats = 0; /// Two ping-pong buffers of the widest padded layer
+        size_t outputOffset = 0;  /// Where the last layer's outputs land in scratch
+
+        // Panel [i][lane] per output block, so one broadcast input feeds all accumulators
+        void pack(std::span<const JitLayer> layers)
+        {
+            size_t total = 0;
+            for (const auto &layer : layers)
+            {
+                panelOffsets.push_back(total);
+                total += layer.inputSize * jit::padded(layer.outputSize);
+                biasOffsets.push_back(total);
+                total += jit::padded(layer.outputSize);
+            }
+            parameters.assign(total, 0.0f);
+
+            for (size_t l = 0; l < layers.size(); ++l)
+            {
+                const JitLayer &layer = layers[l];
+                const size_t outputs = jit::padded(layer.outputSize);
+                float *panel = parameters.data() + panelOffsets[l];
+
+                for (size_t block = 0; block < outputs; block += jit::maxAccumulators * jit::lanes)
+                {
+                    size_t width = (std::min)(jit::maxAccumulators * jit::lanes, outputs - block);
+                    for (size_t i = 0; i < layer.inputSize; ++i, panel += width)
+                        for (size_t lane = 0; lane < width && block + lane < layer.outputSize; ++lane)
+                            panel[lane] = layer.weights[(block + lane) * layer.inputSize + i];
+                }
+
+                std::copy_n(layer.biases, layer.outputSize, parameters.data() + biasOffsets[l]);
+            }
+        }
+
+        void generate(std::span<const JitLayer> layers)
+        {
+            using namespace jit;
+
+            size_t widest = 0;
+            for (const auto &layer : layers)
+                widest = (std::max)(widest, padded(layer.outputSize));
+            scratchFloats = 2 * widest;
+
+            // void(const float *in, float *scratch); rbx = input, r12 = scratch
+            Assembler as;
+            as.push(rbx);
+            as.push(r12);
+            as.push(r13); // Keeps rsp 16-byte aligned for activation calls
+            as.mov(rbx, rdi);
+            as.mov(r12, rsi);
+
+            for (size_t l = 0; l < layers.size(); ++l)
+            {
+                const JitLayer &layer = layers[l];
+                const size_t outputs = padded(layer.outputSize);
+                const int32_t src = l == 0 ? 0 : static_cast<int32_t>(sizeof(float) * ((l - 1) % 2) * widest);
+                const int32_t dst = static_cast<int32_t>(sizeof(float) * (l % 2) * widest);
+                const float *panel = parameters.data() + panelOffsets[l];
+
+                for (size_t block = 0; block < outputs; block += maxAccumulators * lanes)
+                {
+                    const int count = static_cast<int>((std::min)(maxAccumulators * lanes, outputs - block) / lanes);
+                    const int32_t stride = static_cast<int32_t>(count * lanes * sizeof(float));
+
+                    as.movImm(rax, reinterpret_cast<uint64_t>(parameters.data() + biasOffsets[l] + block));
+                    for (int k = 0; k < count; ++k)
+                        as.vmovapsLoad(k, rax, k * 32);
+
+                    as.movImm(rax, reinterpret_cast<uint64_t>(panel));
+                    if (l == 0)
+                        as.mov(rcx, rbx);
+                    else
+                        as.lea(rcx, r12, src);
+
+                    // Two inputs per iteration, then an odd one
+                    auto step = [&](int offset)
+                    {
+                        as.vbroadcastss(broadcastRegister, rcx, offset * 4);
+                        for (int k = 0; k < count; ++k)
+                            as.vfmadd231ps(k, broadcastRegister, rax, offset * stride + k * 32);
+                    };
+
+                    if (layer.inputSize >= 2)
+                    {
+                        as.movImm(rdx, layer.inputSize / 2);
+                        size_t loop = as.label();
+                        step(0);
+                        step(1);
+                        as.addImm(rax, 2 * stride);
+                        as.addImm(rcx, 2 * sizeof(float));
+                        as.dec(rdx);
+                        as.jnz(loop);
+                    }
+                    if (layer.inputSize % 2)
+                        step(0);
+
+                    if (layer.activation == utils::ActivationKind::ReLU)
+                    {
+                        as.vxorps(zeroRegister, zeroRegister, zeroRegister);
+                        for (int k = 0; k < count; ++k)
+                            as.vmaxps(k, k, zeroRegister);
+                    }
+
+                    for (int k = 0; k < count; ++k)
+                        as.vmovapsStore(r12, dst + static_cast<int32_t>(block * sizeof(float)) + k * 32, k);
+
+                    panel += layer.inputSize * count * lanes;
+                }
+
+                if (layer.activation == utils::ActivationKind::Sigmoid || layer.activation == utils::ActivationKind::Tanh)
+                {
+                    auto callee = utils::visitActivation(layer.activation, []<typename Activation>()
+                    {
+                        return &applyActivation<Activation>;
+                    });
+                    as.vzeroupper();
+                    as.lea(rdi, r12, dst);
+                    as.movImm(rsi, layer.outputSize);
+                    as.movImm(rax, reinterpret_cast<uint64_t>(callee));
+                    as.call(rax);
+                }
+            }
+
+            as.vzeroupper();
+            as.pop(r13);
+            as.pop(r12);
+            as.pop(rbx);
+            as.ret();
+
+            outputOffset = ((layers.size() - 1) % 2) * widest;
+            install(as.code);
+        }
+
+        void install([[maybe_unused]] const std::vector<uint8_t> &bytes)
+        {
+#ifdef POLANN_JIT_X86_64
+            // Written while writable, then flipped to read + execute (never both)
+            void *memory = mmap(nullptr, bytes.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+                throw std::runtime_error("Cannot map memory for JIT code");
+
+            code = std::unique_ptr<uint8_t, jit::CodeDeleter>(static_cast<uint8_t *>(memory), jit::CodeDeleter{bytes.size()});
+            std::memcpy(memory, bytes.data(), bytes.size());
+            if (mprotect(memory, bytes.size(), PROT_READ | PROT_EXEC) != 0)
+                throw std::runtime_error("Cannot make JIT code executable");
+
+            function = reinterpret_cast<Function>(memory);
+#endif
+        }
+    };
+
+    /**
+     * @brief Compiles a trained NN or DynamicNN into a JitChain
+     *
+     * An attached normalizer is folded into the first layer's weights and
+     * biases, so results can differ from predict by rounding.
+     */
+    template <typename Model>
+    [[nodiscard]] JitChain compileJit(const Model &model)
+    {
+        auto describe = []<typename Layer>(const Layer &layer) -> JitLayer
+        {
+            utils::ActivationKind activation;
+            if constexpr (requires { typename Layer::ActivationType; })
+                activation = utils::activationKind<typename Layer::ActivationType>;
+            else
+                activation = layer.activation;
+            return {layer.inputSize, layer.outputSize, layer.weights.data(), layer.biases.data(), activation};
+        };
+
+        // Compile-time models hold a tuple of layers, runtime-shaped ones a vector
+        std::vector<JitLayer> chain;
+        if constexpr (requires { std::tuple_size<std::remove_cvref_t<decltype(model.getLayers())>>::value; })
+            std::apply([&](const auto &...layer) { ((chain.push_back(describe(layer))), ...); }, model.getLayers());
+        else
+            for (const auto &layer : model.getLayers())
+                chain.push_back(describe(layer));
+
+        std::vector<float> foldedWeights;
+        std::vector<float> foldedBiases;
+        if (const auto &normalizer = model.getNormalizer(); normalizer && !chain.empty())
+        {
+            // W'[o][i] = W[o][i] * scale[i]; b'[o] = b[o] - sum_i W'[o][i] * shift[i]
+            JitLayer &first = chain.front();
+            foldedWeights.assign(first.weights, first.weights + first.inputSize * first.outputSize);
+            foldedBiases.assign(first.biases, first.biases + first.outputSize);
+            for (size_t o = 0; o < first.outputSize; ++o)
+                for (size_t i = 0; i < first.inputSize; ++i)
+                {
+                    float &w = foldedWeights[o * first.inputSize + i];
+                    w *= normalizer->scale[i];
+                    foldedBiases[o] -= w * normalizer->shift[i];
+                }
+            first.weights = foldedWeights.data();
+            first.biases = foldedBiases.data();
+        }
+
+        return JitChain(chain);
+    }
+
+} // namespace polann::kernels
@@ -2,9 +2,12 @@
 
 #include <span>
 #include <array>
+#include <cmath>
 #include <random>
 #include <ranges>
 #include <concepts>
+#include <algorithm>
+#include "polann/kernels/gemm.hpp"
 
 namespace polann::layers
 {
@@ -32,9 +35,17 @@ namespace polann::layers
         static_assert(InputSize > 0, "Input size must be positive");
         static_assert(OutputSize > 0, "Output size must be positive");
 
+        using ActivationType = Activation;
+
         static constexpr size_t inputSize = InputSize;
         static constexpr size_t outputSize = OutputSize;
 
+        // Per-sample cost model used by instrumentation and benchmarks
+        static constexpr size_t forwardFlops = 2 * InputSize * OutputSize;  /// One multiply-add per weight
+        static constexpr size_t backwardFlops = 4 * InputSize * OutputSize; /// Input and weight gradients
+        static constexpr size_t forwardBytes = sizeof(float) * (InputSize * OutputSize + OutputSize + InputSize + OutputSize);
+        static constexpr size_t backwardBytes = sizeof(float) * (3 * InputSize * OutputSize + 2 * OutputSize + 2 * InputSize);
+
         std::array<float, InputSize * OutputSize> weights; /// Flattened row-major weight matrix
         std::array<float, OutputSize> biases;
 
@@ -46,6 +57,9 @@ namespace polann::layers
         mutable std::array<float, InputSize> lastInput;
         mutable std::array<float, OutputSize> lastActivation;
 
+        // Weights^T in the GEMM panel layout, empty unless packed for inference
+        kernels::PackedMatrix packedWeights;
+
         /**
          * @brief Initializes weights and biases with Xavier/Glorot initialization
          *
@@ -53,15 +67,25 @@ namespace polann::layers
          */
         Dense()
         {
-            // Xavier/Glorot initialization
-            float limit = std::sqrt(6.0f / (InputSize + OutputSize));
-
             std::random_device rd;
             std::mt19937 rng(rd());
+            initialize(rng);
+        }
+
+        /**
+         * @brief Redraws the weights (Xavier/Glorot) and zeroes the biases
+         *
+         * @param rng Generator to draw from, e.g. seeded for reproducible runs
+         */
+        void initialize(std::mt19937 &rng)
+        {
+            // Xavier/Glorot initialization
+            float limit = std::sqrt(6.0f / (InputSize + OutputSize));
             std::uniform_real_distribution<float> dist(-limit, limit);
 
             std::ranges::generate(weights, [&]() { return dist(rng); });
             std::ranges::fill(biases, 0.0f); // Initialize biases to zero
+            dropPackedWeights();
         }
 
         /**
@@ -92,6 +116,63 @@ namespace polann::layers
             forward(std::span<const float, InputSize>(in), std::span<float, OutputSize>(out));
         }
 
+        /**
+         * @brief Forward pass over several samples
+         *
+         * Computes in * weights^T with the packed GEMM kernel, then adds the
+         * biases and applies the activation. Does not record the state used by
+         * the per-sample backward, so concurrent calls on one layer are safe.
+         * Uses the prepacked weights after packForInference.
+         *
+         * @param in Row-major inputs, rows x InputSize
+         * @param out Row-major outputs, rows x OutputSize
+         * @param rows Number of samples
+         */
+        void forwardBatch(const float *in, float *out, size_t rows) const
+        {
+            if (isPacked())
+                kernels::sgemmPacked(rows, 1.0f, in, InputSize, packedWeights, 0.0f, out, OutputSize);
+            else
+                kernels::sgemm(kernels::Transpose::No, kernels::Transpose::Yes, rows, OutputSize, InputSize,
+                               1.0f, in, InputSize, weights.data(), InputSize, 0.0f, out, OutputSize);
+
+            for (size_t r = 0; r < rows; ++r)
+                for (size_t o = 0; o < OutputSize; ++o)
+                    out[r * OutputSize + o] = Activation::compute(out[r * OutputSize + o] + biases[o]);
+        }
+
+        /**
+         * @brief Backward pass over several samples, accumulating into the gradients
+         *
+         * @param in Inputs of the matching forwardBatch call, rows x InputSize
+         * @param out Outputs of the matching forwardBatch call, rows x OutputSize
+         * @param gradOutput Gradient w.r.t. the outputs; overwritten with the
+         *        gradient w.r.t. the pre-activations
+         * @param gradInput Output: gradient w.r.t. the inputs, rows x InputSize
+         *        (nullptr skips it, e.g. for the first layer)
+         * @param rows Number of samples
+         */
+        void backwardBatch(const float *in, const float *out, float *gradOutput, float *gradInput, size_t rows)
+        {
+            // Apply activation derivative and accumulate bias gradients
+            for (size_t r = 0; r < rows; ++r)
+                for (size_t o = 0; o < OutputSize; ++o)
+                {
+                    float &delta = gradOutput[r * OutputSize + o];
+                    delta *= Activation::derivative(out[r * OutputSize + o]);
+                    gradBiases[o] += delta;
+                }
+
+            // gradWeights += delta^T * in
+            kernels::sgemm(kernels::Transpose::Yes, kernels::Transpose::No, OutputSize, InputSize, rows,
+                           1.0f, gradOutput, OutputSize, in, InputSize, 1.0f, gradWeights.data(), InputSize);
+
+            // gradInput = delta * weights
+            if (gradInput)
+                kernels::sgemm(kernels::Transpose::No, kernels::Transpose::No, rows, InputSize, OutputSize,
+                               1.0f, gradOutput, OutputSize, weights.data(), InputSize, 0.0f, gradInput, InputSize);
+        }
+
         /**
          * @brief Backward pass through the layer
          *
@@ -119,6 +200,21 @@ namespace polann::layers
             }
         }
 
+        /**
+         * @brief Packs the weights once into the GEMM kernel layout for inference
+         *
+         * forwardBatch then skips the per-call repacking. The packed copy is a
+         * snapshot: call again after changing weights, or dropPackedWeights.
+         */
+        void packForInference()
+        {
+            packedWeights = kernels::packMatrix(kernels::Transpose::Yes, InputSize, OutputSize, weights.data(), InputSize);
+        }
+
+        void dropPackedWeights() { packedWeights = {}; }
+
+        [[nodiscard]] bool isPacked() const { return !packedWeights.empty(); }
+
         void clearGradients()
         {
             std::fill(gradWeights.begin(), gradWeights.end(), 0.0f);
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/kernels/gemm.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::layers
+{
+    /**
+     * @brief Selects the DynamicDense constructor that skips weight initialization
+     */
+    struct UninitializedTag
+    {
+        explicit UninitializedTag() = default;
+    };
+
+    inline constexpr UninitializedTag uninitialized{};
+
+    /**
+     * @brief Fully connected layer with shapes and activation chosen at runtime
+     *
+     * Same parameter layout, GEMM kernels and training contract as Dense, so
+     * optimizers work on both. Parameters live in cache-line aligned buffers.
+     * The activation is dispatched once per call, not per element.
+     */
+    struct DynamicDense
+    {
+        size_t inputSize = 0;
+        size_t outputSize = 0;
+        utils::ActivationKind activation = utils::ActivationKind::Identity;
+
+        kernels::gemm::Buffer weights; /// Flattened row-major weight matrix, outputSize x inputSize
+        kernels::gemm::Buffer biases;
+
+        // Gradients
+        kernels::gemm::Buffer gradWeights;
+        kernels::gemm::Buffer gradBiases;
+
+        // Weights^T in the GEMM panel layout, empty unless packed for inference
+        kernels::PackedMatrix packedWeights;
+
+        /**
+         * @brief Initializes weights with Xavier/Glorot initialization and biases with zero
+         *
+         * @throws std::invalid_argument for empty shapes or activations other than the built-in ones
+         */
+        DynamicDense(size_t inputSize, size_t outputSize, utils::ActivationKind activation)
+            : DynamicDense(inputSize, outputSize, activation, uninitialized)
+        {
+            std::random_device rd;
+            std::mt19937 rng(rd());
+            initialize(rng);
+        }
+
+        /**
+         * @brief Allocates zeroed parameters without seeding or drawing weights
+         *
+         * For callers that overwrite every parameter right away, such as
+         * DynamicNN::load.
+         *
+         * @throws std::invalid_argument for empty shapes or activations other than the built-in ones
+         */
+        DynamicDense(size_t inputSize, size_t outputSize, utils::ActivationKind activation, UninitializedTag)
+            : inputSize(inputSize), outputSize(outputSize), activation(activation),
+              weights(inputSize * outputSize, 0.0f), biases(outputSize, 0.0f),
+              gradWeights(inputSize * outputSize, 0.0f), gradBiases(outputSize, 0.0f)
+        {
+            if (inputSize == 0 || outputSize == 0)
+                throw std::invalid_argument("Layer sizes must be positive");
+            if (activation > utils::ActivationKind::Tanh)
+                throw std::invalid_argument("Activation is not available at runtime");
+        }
+
+        /**
+         * @brief Redraws the weights (Xavier/Glorot) and zeroes the biases
+         */
+        void initialize(std::mt19937 &rng)
+        {
+            float limit = std::sqrt(6.0f / static_cast<float>(inputSize + outputSize));
+            std::uniform_real_distribution<float> dist(-limit, limit);
+
+            std::ranges::generate(weights, [&]() { return dist(rng); });
+            std::ranges::fill(biases, 0.0f);
+            dropPackedWeights();
+        }
+
+        /**
+         * @brief Forward pass over several samples; see Dense::forwardBatch
+         *
+         * @param in Row-major inputs, rows x inputSize
+         * @param out Row-major outputs, rows x outputSize
+         * @param rows Number of samples
+         */
+        void forwardBatch(const float *in, float *out, size_t rows) const
+        {
+            if (isPacked())
+                kernels::sgemmPacked(rows, 1.0f, in, inputSize, packedWeights, 0.0f, out, outputSize);
+            else
+                kernels::sgemm(kernels::Transpose::No, kernels::Transpose::Yes, rows, outputSize, inputSize,
+                               1.0f, in, inputSize, weights.data(), inputSize, 0.0f, out, outputSize);
+
+            // Locals let the compiler keep shape and bias pointer in registers
+            const size_t outputs = outputSize;
+            const float *bias = biases.data();
+            utils::visitActivation(activation, [=]<typename Activation>()
+            {
+                for (size_t r = 0; r < rows; ++r)
+                    for (size_t o = 0; o < outputs; ++o)
+                        out[r * outputs + o] = Activation::compute(out[r * outputs + o] + bias[o]);
+            });
+        }
+
+        /**
+         * @brief Backward pass over several samples; see Dense::backwardBatch
+         *
+         * @param in Inputs of the matching forwardBatch call
+         * @param out Outputs of the matching forwardBatch call
+         * @param gradOutput Gradient w.r.t. the outputs; overwritten with the
+         *        gradient w.r.t. the pre-activations
+         * @param gradInput Output: gradient w.r.t. the inputs (nullptr skips it)
+         * @param rows Number of samples
+         */
+        void backwardBatch(const float *in, const float *out, float *gradOutput, float *gradInput, size_t rows)
+        {
+            const size_t outputs = outputSize;
+            float *gradBias = gradBiases.data();
+            utils::visitActivation(activation, [=]<typename Activation>()
+            {
+                for (size_t r = 0; r < rows; ++r)
+                    for (size_t o = 0; o < outputs; ++o)
+                    {
+                        float &delta = gradOutput[r * outputs + o];
+                        delta *= Activation::derivative(out[r * outputs + o]);
+                        gradBias[o] += delta;
+                    }
+            });
+
+            // gradWeights += delta^T * in
+            kernels::sgemm(kernels::Transpose::Yes, kernels::Transpose::No, outputSize, inputSize, rows,
+                           1.0f, gradOutput, outputSize, in, inputSize, 1.0f, gradWeights.data(), inputSize);
+
+            // gradInput = delta * weights
+            if (gradInput)
+                kernels::sgemm(kernels::Transpose::No, kernels::Transpose::No, rows, inputSize, outputSize,
+                               1.0f, gradOutput, outputSize, weights.data(), inputSize, 0.0f, gradInput, inputSize);
+        }
+
+        /**
+         * @brief Packs the weights once into the GEMM kernel layout; see Dense::packForInference
+         */
+        void packForInference()
+        {
+            packedWeights = kernels::packMatrix(kernels::Transpose::Yes, inputSize, outputSize, weights.data(), inputSize);
+        }
+
+        void dropPackedWeights() { packedWeights = {}; }
+
+        [[nodiscard]] bool isPacked() const { return !packedWeights.empty(); }
+
+        void clearGradients()
+        {
+            std::fill(gradWeights.begin(), gradWeights.end(), 0.0f);
+            std::fill(gradBiases.begin(), gradBiases.end(), 0.0f);
+        }
+
+        void scaleGradients(float scale)
+        {
+            for (auto &g : gradWeights) g *= scale;
+            for (auto &g : gradBiases) g *= scale;
+        }
+    };
+
+} // namespace polann::layers
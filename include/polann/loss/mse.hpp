@@ -10,6 +10,82 @@
 
 namespace polann::loss
 {
+    namespace kernels
+    {
+        /**
+         * @brief Sum of squared differences, portable implementation
+         */
+        [[nodiscard]] inline float squaredErrorSumScalar(const float *yPredict, const float *yTrue, std::size_t n)
+        {
+            float sum = 0.0f;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                float diff = yPredict[i] - yTrue[i];
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Writes scale * (yPredict - yTrue), portable implementation
+         */
+        inline void scaledDifferenceScalar(const float *yPredict, const float *yTrue, float *out, std::size_t n, float scale)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = scale * (yPredict[i] - yTrue[i]);
+        }
+
+#ifdef POLANN_ENABLE_AVX2
+        /**
+         * @brief Sum of squared differences, 8 lanes at a time with FMA
+         */
+        [[nodiscard]] inline float squaredErrorSumAvx2(const float *yPredict, const float *yTrue, std::size_t n)
+        {
+            std::size_t i = 0;
+            __m256 vsum = _mm256_setzero_ps();
+            for (; i + 8 <= n; i += 8)
+            {
+                // Process 8 elements at a time
+                __m256 va = _mm256_loadu_ps(yPredict + i);
+                __m256 vb = _mm256_loadu_ps(yTrue + i);
+                __m256 vdiff = _mm256_sub_ps(va, vb);
+                vsum = _mm256_fmadd_ps(vdiff, vdiff, vsum); // FMA: (a-b)^2 + acc
+            }
+
+            // Horizontal sum of vector elements
+            __m128 low = _mm256_castps256_ps128(vsum);
+            __m128 high = _mm256_extractf128_ps(vsum, 1);
+            __m128 sum128 = _mm_add_ps(low, high);
+            sum128 = _mm_hadd_ps(sum128, sum128);
+            sum128 = _mm_hadd_ps(sum128, sum128);
+
+            // Scalar remainder
+            return _mm_cvtss_f32(sum128) + squaredErrorSumScalar(yPredict + i, yTrue + i, n - i);
+        }
+
+        /**
+         * @brief Writes scale * (yPredict - yTrue), 8 lanes at a time
+         */
+        inline void scaledDifferenceAvx2(const float *yPredict, const float *yTrue, float *out, std::size_t n, float scale)
+        {
+            std::size_t i = 0;
+            __m256 vScale = _mm256_set1_ps(scale);
+            for (; i + 8 <= n; i += 8)
+            {
+                // Process 8 elements at a time
+                __m256 vPred = _mm256_loadu_ps(yPredict + i);
+                __m256 vTrue = _mm256_loadu_ps(yTrue + i);
+                __m256 vDiff = _mm256_sub_ps(vPred, vTrue); // yPredict - yTrue
+                _mm256_storeu_ps(out + i, _mm256_mul_ps(vDiff, vScale));
+            }
+
+            // Scalar remainder
+            scaledDifferenceScalar(yPredict + i, yTrue + i, out + i, n - i, scale);
+        }
+#endif
+
+    } // namespace kernels
+
     struct MSE
     {
         [[nodiscard]] static inline float compute(
@@ -19,40 +95,16 @@ namespace polann::loss
             if (yPredict.size() != yTrue.size())
                 throw std::runtime_error("MSE requires spans of equal size");
 
-            // Initialize params
             const std::size_t n = yPredict.size();
-            std::size_t i = 0;
-            float sum = 0.0f;
+            float sum;
 
 #ifdef POLANN_ENABLE_AVX2
             // SIMD optimization for larger arrays
             if (n > 8)
-            {
-                __m256 vsum = _mm256_setzero_ps();
-                for (; i + 8 <= n; i += 8)
-                {
-                    // Process 8 elements at a time
-                    __m256 va = _mm256_loadu_ps(yPredict.data() + i);
-                    __m256 vb = _mm256_loadu_ps(yTrue.data() + i);
-                    __m256 vdiff = _mm256_sub_ps(va, vb);
-                    vsum = _mm256_fmadd_ps(vdiff, vdiff, vsum); // FMA: (a-b)^2 + acc
-                }
-
-                // Horizontal sum of vector elements
-                __m128 low = _mm256_castps256_ps128(vsum);
-                __m128 high = _mm256_extractf128_ps(vsum, 1);
-                __m128 sum128 = _mm_add_ps(low, high);
-                sum128 = _mm_hadd_ps(sum128, sum128);
-                sum128 = _mm_hadd_ps(sum128, sum128);
-                sum = _mm_cvtss_f32(sum128);
-            }
+                sum = kernels::squaredErrorSumAvx2(yPredict.data(), yTrue.data(), n);
+            else
 #endif
-            // Scalar remainder
-            for (; i < n; ++i)
-            {
-                float diff = yPredict[i] - yTrue[i];
-                sum += diff * diff;
-            }
+                sum = kernels::squaredErrorSumScalar(yPredict.data(), yTrue.data(), n);
 
             return sum / static_cast<float>(n);
         }
@@ -65,30 +117,16 @@ namespace polann::loss
             if (gradOut.size() != yPredict.size())
                 throw std::runtime_error("Gradient output span must match prediction size");
 
-            // Initialize params
             const std::size_t n = yPredict.size();
             const float invN = 2.0f / n;
-            size_t i = 0;
 
 #ifdef POLANN_ENABLE_AVX2
             // SIMD optimization for larger arrays
             if (n > 8)
-            {
-                __m256 vInvN = _mm256_set1_ps(invN);
-                for (; i + 8 <= n; i += 8)
-                {
-                    // Process 8 elements at a time
-                    __m256 vPred = _mm256_loadu_ps(yPredict.data() + i);
-                    __m256 vTrue = _mm256_loadu_ps(yTrue.data() + i);
-                    __m256 vDiff = _mm256_sub_ps(vPred, vTrue); // yPredict - yTrue
-                    __m256 vGrad = _mm256_mul_ps(vDiff, vInvN); // * (2/n)
-                    _mm256_storeu_ps(gradOut.data() + i, vGrad);
-                }
-            }
+                kernels::scaledDifferenceAvx2(yPredict.data(), yTrue.data(), gradOut.data(), n, invN);
+            else
 #endif
-            // Scalar remainder
-            for (; i < n; ++i)
-                gradOut[i] = invN * (yPredict[i] - yTrue[i]);
+                kernels::scaledDifferenceScalar(yPredict.data(), yTrue.data(), gradOut.data(), n, invN);
         }
     };
 
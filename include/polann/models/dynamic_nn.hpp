@@ -0,0 +1,575 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include "polann/callbacks/callback.hpp"
+#include "polann/callbacks/progress_logger.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/layers/dynamic_dense.hpp"
+#include "polann/loss/mse.hpp"
+#include "polann/models/metrics.hpp"
+#include "polann/models/model_loops.hpp"
+#include "polann/models/model_format.hpp"
+#include "polann/models/revision.hpp"
+#include "polann/utils/activation_functions.hpp"
+#include "polann/utils/profiler.hpp"
+
+namespace polann::models
+{
+    /**
+     * @brief Neural network whose architecture is chosen at runtime
+     *
+     * Counterpart of NN for shapes that are not known at compile time, e.g.
+     * hyper-parameter sweeps or models loaded from disk. Training, batched
+     * inference and evaluation run on the same GEMM kernels as NN, and the
+     * binary format is shared, so either type can load the other's files.
+     * Per-layer profiling is only available on NN.
+     */
+    class DynamicNN
+    {
+    public:
+        /**
+         * @brief Runtime-sized counterpart of core::Normalizer
+         */
+        struct NormalizerType
+        {
+            core::NormalizationMode mode = core::NormalizationMode::ZScore;
+            std::vector<float> shift;
+            std::vector<float> scale;
+
+            void apply(const float *in, float *out) const
+            {
+                for (size_t j = 0; j < shift.size(); ++j)
+                    out[j] = (in[j] - shift[j]) * scale[j];
+            }
+        };
+
+        /**
+         * @brief Creates an empty network, e.g. as the target of load()
+         */
+        DynamicNN() = default;
+
+        /**
+         * @param inputSize Number of input features
+         */
+        explicit DynamicNN(size_t inputSize) : inSize(inputSize)
+        {
+            if (inputSize == 0)
+                throw std::invalid_argument("Input size must be positive");
+        }
+
+        /**
+         * @brief Appends a Dense layer fed by the current output
+         *
+         * @param outputSize Number of neurons in the layer
+         * @param activation Activation applied to the layer's outputs
+         * @return This network, for chaining
+         */
+        DynamicNN &addLayer(size_t outputSize, utils::ActivationKind activation)
+        {
+            if (inSize == 0)
+                throw std::logic_error("Input size must be set before adding layers");
+
+            layers.emplace_back(this->outputSize(), outputSize, activation);
+            revision.bump();
+            return *this;
+        }
+
+        [[nodiscard]] size_t inputSize() const { return inSize; }
+
+        [[nodiscard]] size_t outputSize() const { return layers.empty() ? inSize : layers.back().outputSize; }
+
+        [[nodiscard]] size_t layerCount() const { return layers.size(); }
+
+        [[nodiscard]] const std::vector<polann::layers::DynamicDense> &getLayers() const { return layers; }
+
+        /**
+         * @brief Counter that changes whenever predictions may change; see NN::parameterRevision
+         */
+        [[nodiscard]] uint64_t parameterRevision() const { return revision.get(); }
+
+        /**
+         * @brief Runs inference on one sample
+         *
+         * @param input inputSize() raw feature values
+         * @return outputSize() values
+         */
+        [[nodiscard]] std::vector<float> predict(std::span<const float> input) const
+        {
+            if (input.size() != inSize)
+                throw std::invalid_argument("Input size mismatch");
+
+            std::vector<float> output(outputSize());
+            predictBatch(input, output);
+            return output;
+        }
+
+        /**
+         * @brief Runs inference on several samples at once; see NN::predictBatch
+         *
+         * @param inputs Row-major inputs, a multiple of inputSize()
+         * @param outputs Row-major outputs with room for the same number of rows
+         */
+        void predictBatch(std::span<const float> inputs, std::span<float> outputs) const
+        {
+            requireLayers();
+            size_t rows = inputs.size() / inSize;
+            if (inputs.size() % inSize != 0 || outputs.size() < rows * outputSize())
+                throw std::invalid_argument("Batch size mismatch");
+
+            BatchScratch scratch;
+            std::vector<float, polann::core::AlignedAllocator<float>> normalized;
+            for (size_t first = 0; first < rows; first += predictChunkRows)
+            {
+                size_t count = (std::min)(predictChunkRows, rows - first);
+                const float *in = inputs.data() + first * inSize;
+
+                if (normalizer)
+                {
+                    normalized.resize(count * inSize);
+                    for (size_t r = 0; r < count; ++r)
+                        normalizer->apply(in + r * inSize, normalized.data() + r * inSize);
+                    in = normalized.data();
+                }
+
+                forwardBatchRaw(in, outputs.data() + first * outputSize(), count, scratch);
+            }
+        }
+
+        /**
+         * @brief Redraws all layer parameters from a seed; see NN::initialize
+         */
+        void initialize(uint32_t seed)
+        {
+            std::mt19937 rng(seed);
+            for (auto &layer : layers)
+                layer.initialize(rng);
+            revision.bump();
+        }
+
+        /**
+         * @brief Packs every layer's weights once for inference; see NN::finalizeForInference
+         */
+        void finalizeForInference()
+        {
+            for (auto &layer : layers)
+                layer.packForInference();
+        }
+
+        void dropPackedWeights()
+        {
+            for (auto &layer : layers)
+                layer.dropPackedWeights();
+        }
+
+        [[nodiscard]] bool isPacked() const
+        {
+            return std::ranges::any_of(layers, [](const auto &layer) { return layer.isPacked(); });
+        }
+
+        /**
+         * @brief Attaches an input normalizer fitted with core::Normalizer
+         */
+        template <size_t Features>
+        void setNormalizer(const core::Normalizer<Features> &norm)
+        {
+            if (Features != inSize)
+                throw std::invalid_argument("Normalizer feature count mismatch");
+
+            normalizer = NormalizerType{norm.mode, {norm.shift.begin(), norm.shift.end()}, {norm.scale.begin(), norm.scale.end()}};
+            revision.bump();
+        }
+
+        void clearNormalizer()
+        {
+            normalizer.reset();
+            revision.bump();
+        }
+
+        [[nodiscard]] const std::optional<NormalizerType> &getNormalizer() const { return normalizer; }
+
+        /**
+         * @brief Trains the model using mini-batch gradient descent; see NN::fit
+         *
+         * @throws std::invalid_argument if the dataset's shapes do not match
+         */
+        template <polann::core::BatchSource Dataset, typename Optimizer, typename LossFunction = polann::loss::MSE, typename... Callbacks>
+        void fit(Dataset &dataset, Optimizer &optimizer, int epochs = 1, int batchSize = 32, bool shuffle = true, bool verbose = true, Callbacks &&...hooks)
+        {
+            checkShapes<Dataset>();
+
+            if (verbose)
+            {
+                callbacks::ProgressLogger logger;
+                train<LossFunction>(dataset, optimizer, epochs, batchSize, shuffle, logger, hooks...);
+            }
+            else
+                train<LossFunction>(dataset, optimizer, epochs, batchSize, shuffle, hooks...);
+        }
+
+        /**
+         * @brief Computes loss, accuracy, MAE, RMSE and AUC over a dataset; see NN::evaluate
+         */
+        template <polann::core::BatchSource Dataset, typename LossFunction = polann::loss::MSE>
+        [[nodiscard]] Metrics evaluate(const Dataset &dataset, size_t batchSize = 1024,
+                                       polann::core::ThreadPool &pool = polann::core::ThreadPool::global(),
+                                       bool withAuc = true) const
+        {
+            checkShapes<Dataset>();
+
+            auto transform = staticNormalizer<Dataset::inputSize>();
+            return detail::evaluateLoop<LossFunction>(
+                dataset, batchSize, pool, withAuc,
+                [&](size_t batch, size_t size) { return dataset.getBatch(batch, size, transform ? &*transform : nullptr); },
+                [this](const float *in, float *out, size_t rows, BatchScratch &scratch) { forwardBatchRaw(in, out, rows, scratch); });
+        }
+
+        /**
+         * @brief Writes the network in the format of NN::save
+         */
+        void save(std::ostream &os) const
+        {
+            uint32_t version = modelFormatVersion;
+            uint32_t count = static_cast<uint32_t>(layers.size());
+            os.write(modelMagic, sizeof(modelMagic));
+            os.write(reinterpret_cast<const char *>(&version), sizeof(version));
+            os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+            for (const auto &layer : layers)
+            {
+                uint64_t shape[2] = {layer.inputSize, layer.outputSize};
+                uint8_t activation = static_cast<uint8_t>(layer.activation);
+                os.write(reinterpret_cast<const char *>(shape), sizeof(shape));
+                os.write(reinterpret_cast<const char *>(&activation), sizeof(activation));
+                os.write(reinterpret_cast<const char *>(layer.weights.data()), sizeof(float) * layer.weights.size());
+                os.write(reinterpret_cast<const char *>(layer.biases.data()), sizeof(float) * layer.biases.size());
+            }
+
+            uint8_t hasNormalizer = normalizer.has_value();
+            os.write(reinterpret_cast<const char *>(&hasNormalizer), sizeof(hasNormalizer));
+            if (normalizer)
+            {
+                uint64_t features = normalizer->shift.size();
+                os.write(reinterpret_cast<const char *>(&features), sizeof(features));
+                os.write(reinterpret_cast<const char *>(&normalizer->mode), sizeof(normalizer->mode));
+                os.write(reinterpret_cast<const char *>(normalizer->shift.data()), sizeof(float) * features);
+                os.write(reinterpret_cast<const char *>(normalizer->scale.data()), sizeof(float) * features);
+            }
+
+            if (!os)
+                throw std::runtime_error("Failed to write model");
+        }
+
+        void save(const std::filesystem::path &path) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for writing");
+            save(file);
+        }
+
+        /**
+         * @brief Reads a model written by NN::save or DynamicNN::save
+         *
+         * Files that store activations replace the whole architecture. Older
+         * files without them must match the current layer shapes, whose
+         * activations are kept. Packed layers are re-packed. The network is
+         * unchanged if reading fails.
+         *
+         * @param is Binary input stream
+         * @throws std::runtime_error if the data is not a valid model; stored sizes
+         *         are checked against the bytes left before anything is allocated
+         */
+        void load(std::istream &is)
+        {
+            char magic[sizeof(modelMagic)] = {};
+            uint32_t version = 0;
+            uint32_t count = 0;
+            is.read(magic, sizeof(magic));
+            is.read(reinterpret_cast<char *>(&version), sizeof(version));
+            is.read(reinterpret_cast<char *>(&count), sizeof(count));
+
+            if (!is || !std::equal(std::begin(magic), std::end(magic), std::begin(modelMagic)))
+                throw std::runtime_error("Not a polann model");
+            if (version < minModelFormatVersion || version > modelFormatVersion)
+                throw std::runtime_error("Unsupported model format version");
+            if (count == 0)
+                throw std::runtime_error("Model has no layers");
+            if (!storesActivations(version) && count != layers.size())
+                throw std::runtime_error("Layer count mismatch");
+
+            // Sizes come from the file, so nothing is allocated before it is known to hold them
+            std::optional<uint64_t> bytesLeft = streamBytesLeft(is);
+            if (bytesLeft && *bytesLeft / sizeof(uint64_t[2]) < count)
+                throw std::runtime_error("Truncated model data");
+
+            std::vector<polann::layers::DynamicDense> loaded;
+            loaded.reserve(count);
+            for (uint32_t l = 0; l < count; ++l)
+            {
+                uint64_t shape[2] = {};
+                is.read(reinterpret_cast<char *>(shape), sizeof(shape));
+                if (!is)
+                    throw std::runtime_error("Truncated model data");
+                if (l > 0 && shape[0] != loaded.back().outputSize)
+                    throw std::runtime_error("Layer shape mismatch");
+
+                utils::ActivationKind activation;
+                if (storesActivations(version))
+                {
+                    uint8_t stored = 0;
+                    is.read(reinterpret_cast<char *>(&stored), sizeof(stored));
+                    activation = static_cast<utils::ActivationKind>(stored);
+                    if (activation > utils::ActivationKind::Tanh)
+                        throw std::runtime_error("Unknown activation in model data");
+                }
+                else
+                {
+                    if (shape[0] != layers[l].inputSize || shape[1] != layers[l].outputSize)
+                        throw std::runtime_error("Layer shape mismatch");
+                    activation = layers[l].activation;
+                }
+
+                if (shape[0] == 0)
+                    throw std::runtime_error("Invalid size in model data");
+                checkStoredSize(shape[1], shape[0] + 1, streamBytesLeft(is)); // Weights and biases
+                auto &layer = loaded.emplace_back(shape[0], shape[1], activation, polann::layers::uninitialized); // Read below
+                is.read(reinterpret_cast<char *>(layer.weights.data()), sizeof(float) * layer.weights.size());
+                is.read(reinterpret_cast<char *>(layer.biases.data()), sizeof(float) * layer.biases.size());
+                if (!is)
+                    throw std::runtime_error("Truncated model data");
+            }
+
+            uint8_t hasNormalizer = 0;
+            is.read(reinterpret_cast<char *>(&hasNormalizer), sizeof(hasNormalizer));
+            if (!is)
+                throw std::runtime_error("Truncated model data");
+
+            std::optional<NormalizerType> loadedNormalizer;
+            if (hasNormalizer)
+            {
+                uint64_t features = 0;
+                is.read(reinterpret_cast<char *>(&features), sizeof(features));
+                if (!is || features != loaded.front().inputSize)
+                    throw std::runtime_error("Normalizer feature count mismatch");
+
+                loadedNormalizer.emplace();
+                is.read(reinterpret_cast<char *>(&loadedNormalizer->mode), sizeof(loadedNormalizer->mode));
+                if (!is || loadedNormalizer->mode > core::NormalizationMode::MinMax)
+                    throw std::runtime_error("Unknown normalization mode");
+
+                checkStoredSize(features, 2, streamBytesLeft(is));
+                loadedNormalizer->shift.resize(features);
+                loadedNormalizer->scale.resize(features);
+                is.read(reinterpret_cast<char *>(loadedNormalizer->shift.data()), sizeof(float) * features);
+                is.read(reinterpret_cast<char *>(loadedNormalizer->scale.data()), sizeof(float) * features);
+                if (!is)
+                    throw std::runtime_error("Truncated normalizer data");
+            }
+
+            bool repack = isPacked();
+            inSize = loaded.front().inputSize;
+            layers = std::move(loaded);
+            normalizer = std::move(loadedNormalizer);
+            revision.bump();
+            if (repack)
+                finalizeForInference();
+        }
+
+        void load(const std::filesystem::path &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for reading");
+            load(file);
+        }
+
+    private:
+        size_t inSize = 0;
+        std::vector<polann::layers::DynamicDense> layers;
+        std::optional<NormalizerType> normalizer;
+        Revision revision; /// See parameterRevision()
+
+        static constexpr size_t predictChunkRows = 256; /// Rows per batched forward pass in predictBatch
+
+        using BatchScratch = detail::BatchScratch;
+
+        // Per-layer batch outputs and ping-pong gradients of a training step
+        struct TrainScratch
+        {
+            std::vector<std::vector<float, polann::core::AlignedAllocator<float>>> outputs;
+            std::vector<float, polann::core::AlignedAllocator<float>> grad1;
+            std::vector<float, polann::core::AlignedAllocator<float>> grad2;
+        };
+
+        // Throws unless rows * columns floats stored in a file are positive, addressable and not past its end
+        static void checkStoredSize(uint64_t rows, uint64_t columns, std::optional<uint64_t> bytesLeft)
+        {
+            constexpr uint64_t maxFloats = (std::numeric_limits<size_t>::max)() / sizeof(float);
+            if (rows == 0 || columns == 0 || rows > maxFloats / columns)
+                throw std::runtime_error("Invalid size in model data");
+            if (bytesLeft && rows * columns > *bytesLeft / sizeof(float))
+                throw std::runtime_error("Truncated model data");
+        }
+
+        void requireLayers() const
+        {
+            if (layers.empty())
+                throw std::logic_error("Network has no layers");
+        }
+
+        template <typename Dataset>
+        void checkShapes() const
+        {
+            requireLayers();
+            if (Dataset::inputSize != inSize || Dataset::outputSize != outputSize())
+                throw std::invalid_argument("Dataset shape does not match the network");
+        }
+
+        [[nodiscard]] size_t widestLayer() const
+        {
+            size_t widest = inSize;
+            for (const auto &layer : layers)
+                widest = (std::max)(widest, layer.outputSize);
+            return widest;
+        }
+
+        // Datasets gather through the compile-time normalizer of their input size
+        template <size_t Features>
+        [[nodiscard]] std::optional<core::Normalizer<Features>> staticNormalizer() const
+        {
+            if (!normalizer)
+                return std::nullopt;
+
+            core::Normalizer<Features> result;
+            result.mode = normalizer->mode;
+            std::copy_n(normalizer->shift.begin(), Features, result.shift.begin());
+            std::copy_n(normalizer->scale.begin(), Features, result.scale.begin());
+            return result;
+        }
+
+        void forwardBatchRaw(const float *input, float *output, size_t rows, BatchScratch &scratch) const
+        {
+            if (rows == 0)
+                return;
+
+            size_t widest = widestLayer();
+            if (scratch.buf1.size() < rows * widest)
+            {
+                scratch.buf1.resize(rows * widest);
+                scratch.buf2.resize(rows * widest);
+            }
+
+            const float *src = input;
+            for (size_t l = 0; l < layers.size(); ++l)
+            {
+                float *dst = l + 1 == layers.size() ? output
+                             : l % 2 == 0           ? scratch.buf1.data()
+                                                    : scratch.buf2.data();
+                layers[l].forwardBatch(src, dst, rows);
+                src = dst;
+            }
+        }
+
+        // Layer iteration of detail::trainLoop over the runtime layer list
+        template <size_t Features>
+        struct TrainSteps
+        {
+            DynamicNN &model;
+            std::optional<core::Normalizer<Features>> transform;
+            TrainScratch scratch;
+            [[no_unique_address]] utils::NullProfiler<0> nullProfiler; // Profiling is NN-only
+
+            auto &profiler() { return nullProfiler; }
+
+            template <typename Dataset>
+            auto getBatch(const Dataset &dataset, size_t batch, size_t batchSize)
+            {
+                return dataset.getBatch(batch, batchSize, transform ? &*transform : nullptr);
+            }
+
+            void clearGradients()
+            {
+                for (auto &layer : model.layers)
+                    layer.clearGradients();
+            }
+
+            std::span<const float> forward(const float *input, size_t rows)
+            {
+                model.forwardTrain(input, rows, scratch);
+                return scratch.outputs.back();
+            }
+
+            std::span<float> lossGradients() { return scratch.grad1; }
+
+            void backward(const float *input, size_t rows) { model.backwardTrain(input, rows, scratch); }
+
+            void scaleGradients(float scale)
+            {
+                for (auto &layer : model.layers)
+                    layer.scaleGradients(scale);
+            }
+
+            template <typename Optimizer>
+            void step(Optimizer &optimizer)
+            {
+                for (auto &layer : model.layers)
+                    optimizer.step(layer);
+                model.revision.bump();
+            }
+        };
+
+        template <typename LossFunction, typename Dataset, typename Optimizer, typename... Callbacks>
+        void train(Dataset &dataset, Optimizer &optimizer, int epochs, int batchSize, bool shuffle, Callbacks &...hooks)
+        {
+            TrainSteps<Dataset::inputSize> steps{*this, staticNormalizer<Dataset::inputSize>(), {}, {}};
+            detail::trainLoop<LossFunction>(*this, steps, dataset, optimizer, epochs, batchSize, shuffle, hooks...);
+        }
+
+        // Runtime-indexed counterparts of NN::forwardTrain and NN::backwardTrain
+        void forwardTrain(const float *input, size_t rows, TrainScratch &scratch)
+        {
+            scratch.outputs.resize(layers.size());
+
+            const float *src = input;
+            for (size_t l = 0; l < layers.size(); ++l)
+            {
+                scratch.outputs[l].resize(rows * layers[l].outputSize);
+                layers[l].forwardBatch(src, scratch.outputs[l].data(), rows);
+                src = scratch.outputs[l].data();
+            }
+
+            size_t widest = widestLayer();
+            if (scratch.grad1.size() < rows * widest)
+            {
+                scratch.grad1.resize(rows * widest);
+                scratch.grad2.resize(rows * widest);
+            }
+        }
+
+        void backwardTrain(const float *input, size_t rows, TrainScratch &scratch)
+        {
+            float *gradOut = scratch.grad1.data();
+            float *gradIn = scratch.grad2.data();
+
+            for (size_t l = layers.size(); l-- > 0;)
+            {
+                const float *src = l == 0 ? input : scratch.outputs[l - 1].data();
+
+                layers[l].backwardBatch(src, scratch.outputs[l].data(), gradOut, l == 0 ? nullptr : gradIn, rows);
+                std::swap(gradOut, gradIn);
+            }
+        }
+    };
+
+} // namespace polann::models
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/core/aligned_allocator.hpp"
+#include "polann/kernels/gemm.hpp"
+#include "polann/models/nn.hpp"
+
+namespace polann::models
+{
+    /**
+     * @brief How an Ensemble combines its members' outputs
+     */
+    enum class EnsembleReduction : uint8_t
+    {
+        Mean, /// Average of the member outputs
+        Vote  /// Share of members voting for each output (see Ensemble)
+    };
+
+    /**
+     * @brief K networks of one architecture evaluated as a single model
+     *
+     * The members' weights are stacked per layer and packed once. The first
+     * layer of all members is one GEMM over the shared input, K times wider
+     * than a single model's; deeper layers run on the packed per-member blocks
+     * of the stacked activations, so the input is loaded and normalized once
+     * and no intermediate result is copied. Members are snapshotted at
+     * construction; later changes to the source models are not seen.
+     *
+     * With EnsembleReduction::Vote, a single-output model counts members whose
+     * output is at least 0.5 and a multi-output model counts each member's
+     * argmax; the result is the fraction of votes per output.
+     *
+     * @tparam Layers Layer types shared by every member
+     */
+    template <typename... Layers>
+    class Ensemble
+    {
+    public:
+        using Model = NN<Layers...>;
+
+        static constexpr size_t inputSize = Model::inputSize;
+        static constexpr size_t outputSize = Model::outputSize;
+
+        /**
+         * @param models Trained member networks; all must carry the same normalizer, if any
+         * @param reduction How member outputs are combined
+         * @throws std::invalid_argument if models is empty or their normalizers differ
+         */
+        explicit Ensemble(std::span<const Model> models, EnsembleReduction reduction = EnsembleReduction::Mean)
+            : members(models.size()), reduction(reduction)
+        {
+            if (models.empty())
+                throw std::invalid_argument("Ensemble needs at least one member");
+
+            normalizer = models.front().getNormalizer();
+            for (const Model &model : models)
+                if (!sameNormalizer(model.getNormalizer(), normalizer))
+                    throw std::invalid_argument("Ensemble members must share one normalizer");
+
+            stackLayers(models, std::index_sequence_for<Layers...>{});
+        }
+
+        /**
+         * @brief Number of member networks
+         */
+        [[nodiscard]] size_t size() const { return members; }
+
+        [[nodiscard]] EnsembleReduction getReduction() const { return reduction; }
+
+        /**
+         * @brief Runs one sample through all members and combines their outputs
+         */
+        [[nodiscard]] std::array<float, outputSize> predict(const std::array<float, inputSize> &input) const
+        {
+            std::array<float, outputSize> output;
+            predictBatch(input, output);
+            return output;
+        }
+
+        /**
+         * @brief Runs several samples through all members at once
+         *
+         * Thread-safe. The shared normalizer, if any, is applied to the inputs.
+         *
+         * @param inputs Row-major inputs, a multiple of inputSize
+         * @param outputs Row-major outputs with room for the same number of rows
+         */
+        void predictBatch(std::span<const float> inputs, std::span<float> outputs) const
+        {
+            size_t rows = inputs.size() / inputSize;
+            if (inputs.size() % inputSize != 0 || outputs.size() < rows * outputSize)
+                throw std::invalid_argument("Batch size mismatch");
+
+            thread_local Scratch scratch;
+            scratch.front.resize(predictChunkRows * maxWidth * members);
+            scratch.back.resize(predictChunkRows * maxWidth * members);
+
+            for (size_t first = 0; first < rows; first += predictChunkRows)
+            {
+                size_t count = (std::min)(predictChunkRows, rows - first);
+                const float *in = inputs.data() + first * inputSize;
+
+                if (normalizer)
+                {
+                    scratch.normalized.resize(count * inputSize);
+                    for (size_t r = 0; r < count; ++r)
+                        normalizer->apply(in + r * inputSize, scratch.normalized.data() + r * inputSize);
+                    in = scratch.normalized.data();
+                }
+
+                const float *last = forwardStages(in, count, scratch, std::index_sequence_for<Layers...>{});
+                reduce(last, outputs.data() + first * outputSize, count);
+            }
+        }
+
+    private:
+        using Buffer = std::vector<float, polann::core::AlignedAllocator<float>>;
+
+        struct Stage
+        {
+            std::vector<kernels::PackedMatrix> weights; /// One stacked matrix for the first layer, one per member after
+            kernels::gemm::Buffer biases;               /// Member biases back to back
+        };
+
+        struct Scratch
+        {
+            Buffer normalized;
+            Buffer front; /// Stacked activations, rows x (members * width)
+            Buffer back;
+        };
+
+        static constexpr size_t layerCount = sizeof...(Layers);
+        static constexpr size_t maxWidth = (std::max)({Layers::outputSize...});
+        static constexpr size_t predictChunkRows = 256; /// Rows per fused pass, bounds the scratch size
+
+        std::array<Stage, layerCount> stages;
+        std::optional<typename Model::NormalizerType> normalizer;
+        size_t members;
+        EnsembleReduction reduction;
+
+        static bool sameNormalizer(const std::optional<typename Model::NormalizerType> &a,
+                                   const std::optional<typename Model::NormalizerType> &b)
+        {
+            if (a.has_value() != b.has_value())
+                return false;
+            return !a || (a->mode == b->mode && a->shift == b->shift && a->scale == b->scale);
+        }
+
+        template <size_t... I>
+        void stackLayers(std::span<const Model> models, std::index_sequence<I...>)
+        {
+            (stackLayer<I>(models), ...);
+        }
+
+        template <size_t I>
+        void stackLayer(std::span<const Model> models)
+        {
+            using Layer = std::tuple_element_t<I, std::tuple<Layers...>>;
+            constexpr size_t in = Layer::inputSize;
+            constexpr size_t out = Layer::outputSize;
+
+            Stage &stage = stages[I];
+            stage.biases.resize(members * out);
+            for (size_t k = 0; k < members; ++k)
+            {
+                const Layer &layer = std::get<I>(models[k].getLayers());
+                std::ranges::copy(layer.biases, stage.biases.begin() + k * out);
+            }
+
+            if constexpr (I == 0)
+            {
+                // Members' weight rows one after another: a (members * out) x in matrix
+                kernels::gemm::Buffer stacked(members * out * in);
+                for (size_t k = 0; k < members; ++k)
+                    std::ranges::copy(std::get<0>(models[k].getLayers()).weights, stacked.begin() + k * out * in);
+                stage.weights.push_back(kernels::packMatrix(kernels::Transpose::Yes, in, members * out, stacked.data(), in));
+            }
+            else
+            {
+                for (size_t k = 0; k < members; ++k)
+                {
+                    const Layer &layer = std::get<I>(models[k].getLayers());
+                    stage.weights.push_back(kernels::packMatrix(kernels::Transpose::Yes, in, out, layer.weights.data(), in));
+                }
+            }
+        }
+
+        template <size_t... I>
+        const float *forwardStages(const float *in, size_t rows, Scratch &scratch, std::index_sequence<I...>) const
+        {
+            const float *src = in;
+            float *dst = scratch.front.data();
+            float *spare = scratch.back.data();
+            ((forwardStage<I>(src, dst, rows), src = dst, std::swap(dst, spare)), ...);
+            return src;
+        }
+
+        template <size_t I>
+        void forwardStage(const float *in, float *out, size_t rows) const
+        {
+            using Layer = std::tuple_element_t<I, std::tuple<Layers...>>;
+            using Activation = typename Layer::ActivationType;
+            constexpr size_t inSize = Layer::inputSize;
+            constexpr size_t outSize = Layer::outputSize;
+
+            const Stage &stage = stages[I];
+            const size_t width = members * outSize;
+
+            if constexpr (I == 0)
+                kernels::sgemmPacked(rows, 1.0f, in, inSize, stage.weights.front(), 0.0f, out, width);
+            else
+                for (size_t k = 0; k < members; ++k)
+                    kernels::sgemmPacked(rows, 1.0f, in + k * inSize, members * inSize, stage.weights[k],
+                                         0.0f, out + k * outSize, width);
+
+            const float *bias = stage.biases.data();
+            for (size_t r = 0; r < rows; ++r)
+                for (size_t j = 0; j < width; ++j)
+                    out[r * width + j] = Activation::compute(out[r * width + j] + bias[j]);
+        }
+
+        void reduce(const float *stacked, float *out, size_t rows) const
+        {
+            const size_t width = members * outputSize;
+            const float share = 1.0f / static_cast<float>(members);
+
+            for (size_t r = 0; r < rows; ++r)
+            {
+                const float *row = stacked + r * width;
+                float *dst = out + r * outputSize;
+                std::fill(dst, dst + outputSize, 0.0f);
+
+                for (size_t k = 0; k < members; ++k)
+                {
+                    const float *member = row + k * outputSize;
+                    if (reduction == EnsembleReduction::Mean)
+                        for (size_t o = 0; o < outputSize; ++o)
+                            dst[o] += member[o];
+                    else if constexpr (outputSize == 1)
+                        dst[0] += member[0] >= 0.5f ? 1.0f : 0.0f;
+                    else
+                        dst[std::max_element(member, member + outputSize) - member] += 1.0f;
+                }
+
+                for (size_t o = 0; o < outputSize; ++o)
+                    dst[o] *= share;
+            }
+        }
+    };
+
+    template <typename... Layers>
+    Ensemble(std::span<const NN<Layers...>>, EnsembleReduction = EnsembleReduction::Mean) -> Ensemble<Layers...>;
+
+    template <typename... Layers, typename Allocator>
+    Ensemble(const std::vector<NN<Layers...>, Allocator> &, EnsembleReduction = EnsembleReduction::Mean) -> Ensemble<Layers...>;
+
+} // namespace polann::models
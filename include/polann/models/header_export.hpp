@@ -0,0 +1,247 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include "polann/models/nn.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+namespace polann::models
+{
+    /**
+     * @brief C++ source of an activation function for exportHeader
+     *
+     * Specialize it for custom activations. definition must declare a function
+     * called name that matches Activation::compute; constant marks whether it
+     * can be constexpr (no <cmath> calls).
+     */
+    template <typename Activation>
+    struct ActivationSource;
+
+    template <>
+    struct ActivationSource<utils::ReLU>
+    {
+        static constexpr std::string_view name = "relu";
+        static constexpr bool constant = true;
+        static constexpr std::string_view definition =
+            "constexpr float relu(float x) noexcept { return x > 0.0f ? x : 0.0f; }";
+    };
+
+    template <>
+    struct ActivationSource<utils::Sigmoid>
+    {
+        static constexpr std::string_view name = "sigmoid";
+        static constexpr bool constant = false;
+        static constexpr std::string_view definition =
+            "inline float sigmoid(float x) noexcept\n"
+            "        {\n"
+            "            if (x > 500.0f)\n"
+            "                return 1.0f;\n"
+            "            if (x < -500.0f)\n"
+            "                return 0.0f;\n"
+            "            return 1.0f / (1.0f + std::exp(-x));\n"
+            "        }";
+    };
+
+    template <>
+    struct ActivationSource<utils::Tanh>
+    {
+        static constexpr std::string_view name = "hyperbolicTangent";
+        static constexpr bool constant = false;
+        static constexpr std::string_view definition =
+            "inline float hyperbolicTangent(float x) noexcept { return std::tanh(x); }";
+    };
+
+    template <>
+    struct ActivationSource<utils::Identity>
+    {
+        static constexpr std::string_view name = "identity";
+        static constexpr bool constant = true;
+        static constexpr std::string_view definition =
+            "constexpr float identity(float x) noexcept { return x; }";
+    };
+
+    struct HeaderExportOptions
+    {
+        std::string namespaceName = "polann_model"; /// Namespace of the generated code, may be nested (a::b)
+        size_t unrollLimit = 1024;                  /// Layers with at most this many weights are fully unrolled
+    };
+
+    namespace detail
+    {
+        // Shortest round-trip spelling, so the header reproduces every bit
+        inline std::string floatLiteral(float value)
+        {
+            if (!std::isfinite(value))
+                throw std::runtime_error("Cannot export non-finite parameters");
+
+            char buffer[32];
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            std::string literal(buffer, end);
+            if (literal.find_first_of(".e") == std::string::npos)
+                literal += ".0";
+            return literal + "f";
+        }
+
+        inline void writeArray(std::ostream &os, std::string_view name, const float *values, size_t count)
+        {
+            constexpr size_t perLine = 8;
+
+            os << "        alignas(64) inline constexpr float " << name << "[" << count << "] = {";
+            for (size_t i = 0; i < count; ++i)
+            {
+                os << (i % perLine == 0 ? "\n            " : " ") << floatLiteral(values[i]);
+                if (i + 1 < count)
+                    os << ",";
+            }
+            os << "};\n\n";
+        }
+
+        template <typename Layer>
+        void writeLayerArrays(std::ostream &os, const Layer &layer, size_t index)
+        {
+            std::string prefix = "layer" + std::to_string(index);
+            writeArray(os, prefix + "Weights", layer.weights.data(), layer.weights.size());
+            writeArray(os, prefix + "Biases", layer.biases.data(), layer.biases.size());
+        }
+
+        // Mirrors Dense::forward: bias first, then the inputs in order
+        template <typename Layer>
+        void writeLayerForward(std::ostream &os, size_t index, size_t unrollLimit)
+        {
+            constexpr size_t in = Layer::inputSize;
+            constexpr size_t out = Layer::outputSize;
+            std::string_view activation = ActivationSource<typename Layer::ActivationType>::name;
+            std::string weights = "detail::layer" + std::to_string(index) + "Weights";
+            std::string biases = "detail::layer" + std::to_string(index) + "Biases";
+            std::string src = "x" + std::to_string(index);
+            std::string dst = "x" + std::to_string(index + 1);
+
+            os << "        std::array<float, " << out << "> " << dst << "{};\n";
+            if (in * out <= unrollLimit)
+            {
+                for (size_t o = 0; o < out; ++o)
+                {
+                    os << "        " << dst << "[" << o << "] = detail::" << activation << "(" << biases << "[" << o << "]";
+                    for (size_t i = 0; i < in; ++i)
+                        os << "\n            + " << weights << "[" << o * in + i << "] * " << src << "[" << i << "]";
+                    os << ");\n";
+                }
+            }
+            else
+            {
+                os << "        for (std::size_t o = 0; o < " << out << "; ++o)\n"
+                   << "        {\n"
+                   << "            float sum = " << biases << "[o];\n"
+                   << "            for (std::size_t i = 0; i < " << in << "; ++i)\n"
+                   << "                sum += " << src << "[i] * " << weights << "[o * " << in << " + i];\n"
+                   << "            " << dst << "[o] = detail::" << activation << "(sum);\n"
+                   << "        }\n";
+            }
+            os << "\n";
+        }
+    } // namespace detail
+
+    /**
+     * @brief Writes a trained network as a self-contained C++ header
+     *
+     * The header depends only on the standard library. It holds the parameters
+     * and the attached normalizer as constexpr 64-byte aligned arrays and a
+     * predict() specialized for the architecture: small layers are unrolled
+     * into straight-line code, larger ones become loops with constant bounds.
+     * predict is constexpr when every activation allows it. Results match
+     * NN::predict up to the compiler's floating-point contraction.
+     *
+     * @param model Trained network
+     * @param os Text output stream
+     * @param options Namespace and unrolling threshold
+     */
+    template <typename... Layers>
+    void exportHeader(const NN<Layers...> &model, std::ostream &os, const HeaderExportOptions &options = {})
+    {
+        using Model = NN<Layers...>;
+
+        if (options.namespaceName.empty())
+            throw std::invalid_argument("Namespace name must not be empty");
+
+        constexpr bool constant = (ActivationSource<typename Layers::ActivationType>::constant && ...);
+        const auto &normalizer = model.getNormalizer();
+
+        os << "// Generated by polann::models::exportHeader; do not edit.\n"
+           << "#pragma once\n\n"
+           << "#include <array>\n"
+           << "#include <cmath>\n"
+           << "#include <cstddef>\n\n"
+           << "namespace " << options.namespaceName << "\n"
+           << "{\n"
+           << "    inline constexpr std::size_t inputSize = " << Model::inputSize << ";\n"
+           << "    inline constexpr std::size_t outputSize = " << Model::outputSize << ";\n\n"
+           << "    namespace detail\n"
+           << "    {\n";
+
+        // Each activation function once, in layer order
+        std::vector<std::string_view> written;
+        auto writeActivation = [&]<typename Layer>()
+        {
+            using Source = ActivationSource<typename Layer::ActivationType>;
+            if (std::ranges::find(written, Source::name) != written.end())
+                return;
+            written.push_back(Source::name);
+            os << "        " << Source::definition << "\n\n";
+        };
+        (writeActivation.template operator()<Layers>(), ...);
+
+        if (normalizer)
+        {
+            detail::writeArray(os, "inputShift", normalizer->shift.data(), Model::inputSize);
+            detail::writeArray(os, "inputScale", normalizer->scale.data(), Model::inputSize);
+        }
+
+        std::apply([&](const auto &...layer)
+        {
+            size_t index = 0;
+            ((detail::writeLayerArrays(os, layer, index++)), ...);
+        }, model.getLayers());
+
+        os << "    } // namespace detail\n\n"
+           << "    [[nodiscard]] " << (constant ? "constexpr" : "inline")
+           << " std::array<float, outputSize> predict(const std::array<float, inputSize> &input) noexcept\n"
+           << "    {\n";
+
+        if (normalizer)
+            os << "        std::array<float, inputSize> x0{};\n"
+               << "        for (std::size_t i = 0; i < inputSize; ++i)\n"
+               << "            x0[i] = (input[i] - detail::inputShift[i]) * detail::inputScale[i];\n\n";
+        else
+            os << "        const std::array<float, inputSize> &x0 = input;\n\n";
+
+        size_t index = 0;
+        ((detail::writeLayerForward<Layers>(os, index++, options.unrollLimit)), ...);
+
+        os << "        return x" << sizeof...(Layers) << ";\n"
+           << "    }\n\n"
+           << "} // namespace " << options.namespaceName << "\n";
+
+        if (!os)
+            throw std::runtime_error("Failed to write header");
+    }
+
+    template <typename... Layers>
+    void exportHeader(const NN<Layers...> &model, const std::filesystem::path &path, const HeaderExportOptions &options = {})
+    {
+        std::ofstream file(path);
+        if (!file)
+            throw std::runtime_error("Cannot open " + path.string() + " for writing");
+        exportHeader(model, file, options);
+    }
+
+} // namespace polann::models
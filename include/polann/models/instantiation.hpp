@@ -0,0 +1,47 @@
+#pragma once
+
+#include "polann/models/nn.hpp"
+#include "polann/models/metrics.hpp"
+#include "polann/core/thread_pool.hpp"
+
+/*
+ * Explicit instantiation of networks shared by many translation units.
+ *
+ * Declare the network once next to its definition, e.g. in model.hpp:
+ *
+ *     using Model = polann::models::NN<Dense<ReLU, 32, 64>, Dense<Sigmoid, 64, 1>>;
+ *     using TrainingData = polann::core::Dataset<32, 1>;
+ *     POLANN_EXTERN_NN(Dense<ReLU, 32, 64>, Dense<Sigmoid, 64, 1>);
+ *     POLANN_EXTERN_NN_TRAINING(Model, TrainingData, polann::optimizers::SGD, polann::loss::MSE);
+ *
+ * and define it in exactly one source file, e.g. model.cpp:
+ *
+ *     POLANN_INSTANTIATE_NN(Dense<ReLU, 32, 64>, Dense<Sigmoid, 64, 1>);
+ *     POLANN_INSTANTIATE_NN_TRAINING(Model, TrainingData, polann::optimizers::SGD, polann::loss::MSE);
+ *
+ * Every other file including model.hpp then links against that one copy
+ * instead of generating the network's code again. The class itself must be
+ * spelled out (C++ does not allow an alias there). Each argument of the
+ * training macros is a single macro argument, so a type whose name contains
+ * a comma, such as Dataset<32, 1>, must be passed through an alias.
+ */
+
+/// Members of NN<...> (predict, predictBatch, save, load, ...) are instantiated elsewhere
+#define POLANN_EXTERN_NN(...) extern template class polann::models::NN<__VA_ARGS__>
+
+/// Instantiates the members of NN<...>; pair with POLANN_EXTERN_NN
+#define POLANN_INSTANTIATE_NN(...) template class polann::models::NN<__VA_ARGS__>
+
+// fit and evaluate are member templates, which a class instantiation leaves out
+#define POLANN_DETAIL_NN_TRAINING(prefix, Model, Dataset, Optimizer, LossFunction)                          \
+    prefix template void Model::fit<Dataset, Optimizer, LossFunction>(Dataset &, Optimizer &, int, int, bool, bool); \
+    prefix template polann::models::Metrics Model::evaluate<Dataset, LossFunction>(                         \
+        const Dataset &, size_t, polann::core::ThreadPool &, bool) const
+
+/// Model::fit and Model::evaluate for these types, without callbacks, are instantiated elsewhere
+#define POLANN_EXTERN_NN_TRAINING(Model, Dataset, Optimizer, LossFunction) \
+    POLANN_DETAIL_NN_TRAINING(extern, Model, Dataset, Optimizer, LossFunction)
+
+/// Instantiates Model::fit and Model::evaluate; pair with POLANN_EXTERN_NN_TRAINING
+#define POLANN_INSTANTIATE_NN_TRAINING(Model, Dataset, Optimizer, LossFunction) \
+    POLANN_DETAIL_NN_TRAINING(, Model, Dataset, Optimizer, LossFunction)
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+
+namespace polann::models
+{
+    /**
+     * @brief Evaluation results of NN::evaluate
+     *
+     * Accuracy compares thresholded predictions (at 0.5) for a single output
+     * and the argmax of prediction and label for several outputs. AUC is the
+     * ROC area per output with labels thresholded at 0.5, averaged over the
+     * outputs that contain both classes (NaN if none do, if any prediction is
+     * NaN, or if evaluate was asked to skip it).
+     */
+    struct Metrics
+    {
+        float loss = 0.0f;     /// Mean per-sample value of the loss function
+        float accuracy = 0.0f; /// Fraction of correctly classified samples
+        float mae = 0.0f;      /// Mean absolute error over all outputs
+        float rmse = 0.0f;     /// Root mean squared error over all outputs
+        float auc = std::numeric_limits<float>::quiet_NaN();
+        size_t samples = 0;
+
+        void print(std::ostream &os) const
+        {
+            os << "loss " << loss << ", accuracy " << accuracy << ", MAE " << mae
+               << ", RMSE " << rmse << ", AUC " << auc << " (" << samples << " samples)\n";
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Area under the ROC curve via the Mann-Whitney rank statistic
+         *
+         * Tied scores get their average rank. Sorts scored in place.
+         *
+         * @param scored (score, is positive) pairs
+         * @return AUC, or NaN if only one class is present
+         */
+        inline double rocAuc(std::vector<std::pair<float, bool>> &scored)
+        {
+            std::sort(scored.begin(), scored.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+            double positives = 0.0;
+            double positiveRankSum = 0.0;
+            for (size_t i = 0; i < scored.size();)
+            {
+                size_t j = i;
+                size_t tiedPositives = 0;
+                for (; j < scored.size() && scored[j].first == scored[i].first; ++j)
+                    tiedPositives += scored[j].second;
+
+                double averageRank = 0.5 * static_cast<double>(i + 1 + j); // Ranks are 1-based
+                positiveRankSum += averageRank * tiedPositives;
+                positives += tiedPositives;
+                i = j;
+            }
+
+            double negatives = static_cast<double>(scored.size()) - positives;
+            if (positives == 0.0 || negatives == 0.0)
+                return std::numeric_limits<double>::quiet_NaN();
+
+            return (positiveRankSum - positives * (positives + 1.0) / 2.0) / (positives * negatives);
+        }
+
+        /**
+         * @brief Per-thread partial sums of the metrics for one output size
+         */
+        template <size_t OutputSize>
+        struct MetricsAccumulator
+        {
+            double loss = 0.0;
+            double absoluteError = 0.0;
+            double squaredError = 0.0;
+            size_t correct = 0;
+            size_t samples = 0;
+            bool withAuc = true;         /// Whether to keep scores and labels for AUC
+            std::vector<float> scores;   /// Row-major predictions kept for AUC
+            std::vector<uint8_t> labels; /// Row-major thresholded labels
+
+            void add(const float *prediction, const float *target, float sampleLoss)
+            {
+                loss += sampleLoss;
+                for (size_t o = 0; o < OutputSize; ++o)
+                {
+                    double diff = static_cast<double>(prediction[o]) - target[o];
+                    absoluteError += std::abs(diff);
+                    squaredError += diff * diff;
+                }
+
+                if (withAuc)
+                    for (size_t o = 0; o < OutputSize; ++o)
+                    {
+                        scores.push_back(prediction[o]);
+                        labels.push_back(target[o] >= 0.5f);
+                    }
+
+                if constexpr (OutputSize == 1)
+                    correct += (prediction[0] >= 0.5f) == (target[0] >= 0.5f);
+                else
+                    correct += std::max_element(prediction, prediction + OutputSize) - prediction ==
+                               std::max_element(target, target + OutputSize) - target;
+                ++samples;
+            }
+
+            void merge(const MetricsAccumulator &other)
+            {
+                loss += other.loss;
+                absoluteError += other.absoluteError;
+                squaredError += other.squaredError;
+                correct += other.correct;
+                samples += other.samples;
+                scores.insert(scores.end(), other.scores.begin(), other.scores.end());
+                labels.insert(labels.end(), other.labels.begin(), other.labels.end());
+            }
+
+            [[nodiscard]] Metrics finish() const
+            {
+                Metrics metrics;
+                metrics.samples = samples;
+                if (samples == 0)
+                    return metrics;
+
+                double n = static_cast<double>(samples);
+                metrics.loss = static_cast<float>(loss / n);
+                metrics.accuracy = static_cast<float>(correct / n);
+                metrics.mae = static_cast<float>(absoluteError / (n * OutputSize));
+                metrics.rmse = static_cast<float>(std::sqrt(squaredError / (n * OutputSize)));
+                // NaN predictions (a diverged model) have no rank, so AUC is undefined;
+                // they would also break the sort and the tie grouping in rocAuc
+                if (!withAuc || std::ranges::any_of(scores, [](float score) { return std::isnan(score); }))
+                    return metrics;
+
+                // Macro-average over outputs that have both classes
+                double aucSum = 0.0;
+                size_t aucCount = 0;
+                std::vector<std::pair<float, bool>> scored(samples);
+                for (size_t o = 0; o < OutputSize; ++o)
+                {
+                    for (size_t s = 0; s < samples; ++s)
+                        scored[s] = {scores[s * OutputSize + o], labels[s * OutputSize + o] != 0};
+
+                    double auc = rocAuc(scored);
+                    if (!std::isnan(auc))
+                    {
+                        aucSum += auc;
+                        ++aucCount;
+                    }
+                }
+                if (aucCount > 0)
+                    metrics.auc = static_cast<float>(aucSum / aucCount);
+
+                return metrics;
+            }
+        };
+    } // namespace detail
+
+} // namespace polann::models
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <istream>
+#include <optional>
+
+namespace polann::models
+{
+    // Binary model layout shared by NN and DynamicNN:
+    //   magic, uint32 version, uint32 layer count,
+    //   per layer: uint64 input size, uint64 output size, uint8 activation (version >= 2),
+    //              weights (row-major), biases,
+    //   uint8 normalizer flag, normalizer (see Normalizer::save)
+
+    inline constexpr char modelMagic[4] = {'P', 'L', 'N', 'N'}; /// Leading bytes of a serialized model
+    inline constexpr uint32_t modelFormatVersion = 2;            /// Bumped on incompatible format changes
+    inline constexpr uint32_t minModelFormatVersion = 1;         /// Oldest version load() still reads
+
+    /**
+     * @brief Whether a stored model of the given version carries per-layer activations
+     */
+    [[nodiscard]] constexpr bool storesActivations(uint32_t version) { return version >= 2; }
+
+    /**
+     * @brief Bytes left to read in a stream, or nullopt if it cannot seek
+     *
+     * Lets readers reject sizes stored in a file before allocating for them.
+     */
+    [[nodiscard]] inline std::optional<uint64_t> streamBytesLeft(std::istream &is)
+    {
+        std::istream::pos_type position = is.tellg();
+        if (position == std::istream::pos_type(-1))
+        {
+            is.clear(is.rdstate() & ~std::ios::failbit);
+            return std::nullopt;
+        }
+
+        is.seekg(0, std::ios::end);
+        std::istream::pos_type end = is.tellg();
+        is.seekg(position);
+        if (!is || end < position)
+        {
+            is.clear(is.rdstate() & ~std::ios::failbit);
+            is.seekg(position);
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(end - position);
+    }
+
+} // namespace polann::models
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <span>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "polann/callbacks/callback.hpp"
+#include "polann/core/aligned_allocator.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/models/metrics.hpp"
+
+namespace polann::models::detail
+{
+    using AlignedFloats = std::vector<float, polann::core::AlignedAllocator<float>>;
+
+    // Ping-pong activations of a batched forward pass
+    struct BatchScratch
+    {
+        AlignedFloats buf1;
+        AlignedFloats buf2;
+    };
+
+    // Restores the packing a model dropped for training, also when a callback or the optimizer throws
+    template <typename Model>
+    struct RepackGuard
+    {
+        Model &model;
+        bool enabled;
+
+        ~RepackGuard()
+        {
+            if (!enabled)
+                return;
+            try
+            {
+                model.finalizeForInference();
+            }
+            catch (...)
+            {
+                // Unpacked layers only run slower, so a failed repack must not escape a destructor
+            }
+        }
+    };
+
+    /**
+     * @brief Mini-batch gradient descent loop shared by NN and DynamicNN
+     *
+     * Owns the epochs, batches, loss and callbacks; the model supplies the
+     * layer iteration through steps:
+     *   - getBatch(dataset, batch, batchSize): normalized (inputs, labels) spans
+     *   - forward(inputs, rows): keeps every layer's outputs, returns the predictions
+     *   - lossGradients(): room for rows * outputs loss gradients read by backward
+     *   - backward(inputs, rows), clearGradients(), scaleGradients(scale)
+     *   - step(optimizer): updates every layer and bumps the model's revision
+     *   - profiler(): epoch, batch, loss and optimizerStep scopes (see utils::Profiler)
+     *
+     * Packed weights are dropped while training and restored however it ends.
+     */
+    template <typename LossFunction, typename Model, typename Steps, typename Dataset, typename Optimizer, typename... Callbacks>
+    void trainLoop(Model &model, Steps &steps, Dataset &dataset, Optimizer &optimizer, int epochs, int batchSize, bool shuffle,
+                   Callbacks &...hooks)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr size_t outputs = Dataset::outputSize;
+
+        // Batch timings are only taken when someone listens
+        constexpr bool timeBatches = (callbacks::HasBatchEnd<Callbacks, Model> || ...);
+
+        auto &profiler = steps.profiler();
+        size_t epochCount = static_cast<size_t>((std::max)(epochs, 0));
+
+        // Packed weights would go stale with every optimizer step
+        RepackGuard<Model> repack{model, model.isPacked()};
+        model.dropPackedWeights();
+        (callbacks::onTrainBegin(hooks, model), ...);
+
+        for (size_t epoch = 0; epoch < epochCount; epoch++)
+        {
+            [[maybe_unused]] auto epochScope = profiler.epoch(epoch);
+
+            callbacks::EpochInfo epochInfo{.epoch = epoch, .epochs = epochCount, .learningRate = callbacks::learningRate(optimizer)};
+            bool stop = ((callbacks::onEpochBegin(hooks, model, epochInfo) == callbacks::Action::Stop) | ... | false);
+            auto epochStart = Clock::now();
+
+            if (shuffle) // Shuffling helps generalizing the model
+                dataset.shuffle();
+
+            float epochLoss = 0.0f;
+            size_t numBatches = dataset.numBatches(batchSize);
+            size_t totalSamples = 0;
+
+            for (size_t batch = 0; batch < numBatches; batch++)
+            {
+                [[maybe_unused]] auto batchScope = profiler.batch(batch);
+
+                Clock::time_point batchStart;
+                if constexpr (timeBatches)
+                    batchStart = Clock::now();
+
+                // Get data batches from the dataset
+                auto [batchInputs, batchLabels] = steps.getBatch(dataset, batch, batchSize);
+                size_t currentBatchSize = batchInputs.size() / Dataset::inputSize;
+
+                if (currentBatchSize == 0)
+                    continue;
+
+                // Zero gradients at start of batch
+                steps.clearGradients();
+
+                // Forward and backward over the whole batch (inputs were normalized during gathering)
+                std::span<const float> predictions = steps.forward(batchInputs.data(), currentBatchSize);
+
+                float batchLoss = 0.0f;
+                {
+                    [[maybe_unused]] auto scope = profiler.loss();
+
+                    std::span<float> gradients = steps.lossGradients();
+                    for (size_t sample = 0; sample < currentBatchSize; sample++)
+                    {
+                        auto predSpan = predictions.subspan(sample * outputs, outputs);
+                        auto targetSpan = batchLabels.subspan(sample * outputs, outputs);
+                        batchLoss += LossFunction::compute(predSpan, targetSpan);
+                        LossFunction::gradient(predSpan, targetSpan, gradients.subspan(sample * outputs, outputs));
+                    }
+                }
+
+                steps.backward(batchInputs.data(), currentBatchSize);
+
+                // Scale gradients by 1/batchSize and update weights
+                steps.scaleGradients(1.0f / currentBatchSize);
+                {
+                    [[maybe_unused]] auto scope = profiler.optimizerStep();
+                    steps.step(optimizer);
+                }
+
+                epochLoss += batchLoss;
+                totalSamples += currentBatchSize;
+
+                if constexpr (timeBatches)
+                {
+                    double ns = std::chrono::duration<double, std::nano>(Clock::now() - batchStart).count();
+                    callbacks::BatchInfo batchInfo{
+                        .epoch = epoch,
+                        .batch = batch,
+                        .batchSize = currentBatchSize,
+                        .loss = batchLoss / currentBatchSize,
+                        .elapsedNs = ns,
+                        .samplesPerSecond = ns > 0.0 ? currentBatchSize * 1e9 / ns : 0.0,
+                        .learningRate = callbacks::learningRate(optimizer)};
+                    stop |= ((callbacks::onBatchEnd(hooks, model, batchInfo) == callbacks::Action::Stop) | ... | false);
+                }
+            }
+
+            if (totalSamples > 0)
+                epochLoss /= totalSamples;
+
+            epochInfo.loss = epochLoss;
+            epochInfo.samples = totalSamples;
+            epochInfo.batches = numBatches;
+            epochInfo.elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - epochStart).count();
+            epochInfo.samplesPerSecond = epochInfo.elapsedNs > 0.0 ? totalSamples * 1e9 / epochInfo.elapsedNs : 0.0;
+            stop |= ((callbacks::onEpochEnd(hooks, model, epochInfo) == callbacks::Action::Stop) | ... | false);
+
+            if (stop)
+                break;
+        }
+
+        (callbacks::onTrainEnd(hooks, model), ...);
+    }
+
+    /**
+     * @brief Batched, multi-threaded evaluation shared by NN and DynamicNN; see NN::evaluate
+     *
+     * @param getBatch Invoked as getBatch(batch, batchSize), returns normalized (inputs, labels)
+     * @param forwardBatch Invoked as forwardBatch(inputs, outputs, rows, BatchScratch &); thread-safe
+     */
+    template <typename LossFunction, typename Dataset, typename GetBatch, typename ForwardBatch>
+    [[nodiscard]] Metrics evaluateLoop(const Dataset &dataset, size_t batchSize, polann::core::ThreadPool &pool, bool withAuc,
+                                       GetBatch &&getBatch, ForwardBatch &&forwardBatch)
+    {
+        constexpr size_t inputs = Dataset::inputSize;
+        constexpr size_t outputs = Dataset::outputSize;
+        constexpr size_t minRowsPerThread = 32; /// Smallest chunk of an evaluate batch
+
+        size_t numBatches = dataset.numBatches(batchSize);
+        if (numBatches == 0)
+            return {};
+
+        // Give every chunk enough rows to amortize the fork-join
+        size_t rowsPerBatch = (std::min)(batchSize, dataset.size());
+        size_t grain = (std::max)(minRowsPerThread, (rowsPerBatch + pool.concurrency() - 1) / pool.concurrency());
+
+        struct alignas(64) Partial
+        {
+            MetricsAccumulator<outputs> metrics;
+            BatchScratch scratch;
+            AlignedFloats predictions;
+        };
+        std::vector<Partial> partials((rowsPerBatch + grain - 1) / grain);
+        for (auto &partial : partials)
+            partial.metrics.withAuc = withAuc;
+
+        for (size_t batch = 0; batch < numBatches; ++batch)
+        {
+            auto [batchInputs, batchLabels] = getBatch(batch, batchSize);
+            size_t rows = batchInputs.size() / inputs;
+
+            pool.parallelFor(0, rows, grain, [&](size_t begin, size_t end)
+            {
+                Partial &partial = partials[begin / grain];
+                partial.predictions.resize((end - begin) * outputs);
+                forwardBatch(batchInputs.data() + begin * inputs, partial.predictions.data(), end - begin, partial.scratch);
+
+                for (size_t r = begin; r < end; ++r)
+                {
+                    std::span<const float> prediction = std::span<const float>(partial.predictions).subspan((r - begin) * outputs, outputs);
+                    std::span<const float> target = batchLabels.subspan(r * outputs, outputs);
+                    partial.metrics.add(prediction.data(), target.data(), LossFunction::compute(prediction, target));
+                }
+            });
+        }
+
+        for (size_t t = 1; t < partials.size(); ++t)
+            partials[0].metrics.merge(partials[t].metrics);
+
+        return partials[0].metrics.finish();
+    }
+
+} // namespace polann::models::detail
@@ -3,7 +3,26 @@
 #include <span>
 #include <tuple>
 #include <array>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include "polann/callbacks/callback.hpp"
+#include "polann/callbacks/progress_logger.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/thread_pool.hpp"
 #include "polann/loss/mse.hpp"
+#include "polann/models/metrics.hpp"
+#include "polann/models/model_loops.hpp"
+#include "polann/models/model_format.hpp"
+#include "polann/models/revision.hpp"
+#include "polann/utils/activation_functions.hpp"
+#include "polann/utils/profiler.hpp"
 
 namespace polann::models
 {
@@ -11,6 +30,7 @@ namespace polann::models
     template <typename... Layers>
     constexpr size_t maxOutputSize = (std::max)({Layers::outputSize...});
 
+
     /**
      * @brief Template-based neural network
      *
@@ -25,10 +45,14 @@ namespace polann::models
         static_assert(sizeof...(Layers) > 0, "Neural network must have at least one layer");
 
     public:
-        static constexpr size_t maxLayerOutputSize = maxOutputSize<Layers...>; /// Maximum buffer size needed for any layer output
-        static constexpr size_t layerCount = sizeof...(Layers);                /// Number of layers in the network
-        static constexpr size_t inputSize = firstLayerType::inputSize;         /// Input size of the network
-        static constexpr size_t outputSize = finalLayerType::outputSize;       /// Output size of the network
+        static constexpr size_t layerCount = sizeof...(Layers);          /// Number of layers in the network
+        static constexpr size_t inputSize = firstLayerType::inputSize;   /// Input size of the network
+        static constexpr size_t outputSize = finalLayerType::outputSize; /// Output size of the network
+
+        /// Maximum buffer size needed for the network input or any layer output
+        static constexpr size_t maxLayerOutputSize = (std::max)(maxOutputSize<Layers...>, inputSize);
+
+        using NormalizerType = polann::core::Normalizer<inputSize>;
 
         /**
          * @brief Constructs the NN with given layer instances
@@ -44,6 +68,7 @@ namespace polann::models
          * @return std::array<float, outputSize> Output array produced by the final layer
          *
          * @note Internal buffers are reused to avoid heap allocations
+         * @note The attached normalizer, if any, is applied while copying the input
          */
         template <size_t InputSize>
         [[nodiscard]] std::array<float, outputSize> predict(const std::array<float, InputSize> &input) const
@@ -52,95 +77,465 @@ namespace polann::models
 
             alignas(32) std::array<float, maxLayerOutputSize> buf1{};
             alignas(32) std::array<float, maxLayerOutputSize> buf2{};
-            std::copy(input.begin(), input.end(), buf1.begin()); // Use first buffer as input
+
+            // Use first buffer as input
+            if (normalizer)
+                normalizer->apply(input.data(), buf1.data());
+            else
+                std::copy(input.begin(), input.end(), buf1.begin());
 
             return predictImpl(buf1, buf2, std::index_sequence_for<Layers...>{});
         }
 
+        /**
+         * @brief Redraws all layer parameters from a seed
+         *
+         * Layers are initialized in order from one generator, so equal seeds
+         * give equal networks.
+         */
+        void initialize(uint32_t seed)
+        {
+            std::mt19937 rng(seed);
+            std::apply([&](auto &...layer) { ((layer.initialize(rng)), ...); }, layers);
+            revision.bump();
+        }
+
+        /**
+         * @brief Packs every layer's weights once for inference
+         *
+         * predict, predictBatch and evaluate then run on the prepacked GEMM
+         * path instead of repacking per call. fit drops the packing while it
+         * updates the weights and restores it afterwards; load re-packs.
+         */
+        void finalizeForInference()
+        {
+            std::apply([](auto &...layer) { ((packLayer(layer)), ...); }, layers);
+        }
+
+        void dropPackedWeights()
+        {
+            std::apply([](auto &...layer) { ((dropLayerPacking(layer)), ...); }, layers);
+        }
+
+        [[nodiscard]] bool isPacked() const
+        {
+            return std::apply([](const auto &...layer) { return (layerPacked(layer) || ...); }, layers);
+        }
+
+        /**
+         * @brief Attaches an input normalizer
+         *
+         * fit and evaluate fuse it into batch gathering; predict applies it to raw
+         * inputs. It is serialized together with the weights.
+         *
+         * @param norm Normalizer fitted on the training data
+         */
+        void setNormalizer(const NormalizerType &norm)
+        {
+            normalizer = norm;
+            revision.bump();
+        }
+
+        void clearNormalizer()
+        {
+            normalizer.reset();
+            revision.bump();
+        }
+
+        [[nodiscard]] const std::optional<NormalizerType> &getNormalizer() const { return normalizer; }
+
+        [[nodiscard]] const std::tuple<Layers...> &getLayers() const { return layers; }
+
+        /**
+         * @brief Counter that changes whenever predictions may change
+         *
+         * Bumped by every optimizer step, load, initialize, normalizer change
+         * and assignment, so caches of predictions can tell when they went
+         * stale. Values are unique across all models of the process.
+         */
+        [[nodiscard]] uint64_t parameterRevision() const { return revision.get(); }
+
         /**
          * @brief Trains the model using mini-batch gradient descent
          *
-         * @tparam Dataset Dataset type
+         * @tparam Dataset Dataset or DatasetView type
          * @tparam Optimizer Optimizer type. Must implement step(layer)
          * @tparam LossFunction Loss function type. Must provide static compute() and gradient()
+         * @tparam Callbacks Objects implementing any of the hooks in callbacks/callback.hpp
          *
          * @param dataset Training dataset
          * @param optimizer Optimizer instance (e.g., SGD)
          * @param epochs Number of full passes over dataset
          * @param batchSize Number of samples per training batch
          * @param shuffle Whether to shuffle dataset each epoch
-         * @param verbose Whether to print training progress
+         * @param verbose Whether to print training progress (adds a ProgressLogger)
+         * @param hooks Callbacks invoked on epoch and batch events, resolved at compile time
          */
-        template <typename Dataset, typename Optimizer, typename LossFunction = polann::loss::MSE>
-        void fit(Dataset &dataset, Optimizer &optimizer, int epochs = 1, int batchSize = 32, bool shuffle = true, bool verbose = true)
+        template <polann::core::BatchSource Dataset, typename Optimizer, typename LossFunction = polann::loss::MSE, typename... Callbacks>
+        void fit(Dataset &dataset, Optimizer &optimizer, int epochs = 1, int batchSize = 32, bool shuffle = true, bool verbose = true, Callbacks &&...hooks)
         {
-            for (size_t epoch = 0; epoch < epochs; epoch++)
+            if (verbose)
             {
-                if (shuffle) // Shuffling helps generalizing the model
-                    dataset.shuffle();
+                callbacks::ProgressLogger logger;
+                train<LossFunction>(dataset, optimizer, epochs, batchSize, shuffle, logger, hooks...);
+            }
+            else
+                train<LossFunction>(dataset, optimizer, epochs, batchSize, shuffle, hooks...);
+        }
 
-                float epochLoss = 0.0f;
-                size_t numBatches = dataset.numBatches(batchSize);
-                size_t totalSamples = 0;
+        /**
+         * @brief Runs inference on several samples at once
+         *
+         * Thread-safe: unlike predict's training path, no layer state is
+         * recorded. The attached normalizer, if any, is applied to the inputs.
+         *
+         * @param inputs Row-major inputs, a multiple of inputSize
+         * @param outputs Row-major outputs with room for the same number of rows
+         */
+        void predictBatch(std::span<const float> inputs, std::span<float> outputs) const
+        {
+            size_t rows = inputs.size() / inputSize;
+            if (inputs.size() % inputSize != 0 || outputs.size() < rows * outputSize)
+                throw std::invalid_argument("Batch size mismatch");
 
-                for (size_t batch = 0; batch < numBatches; batch++)
+            BatchScratch scratch;
+            std::vector<float, polann::core::AlignedAllocator<float>> normalized;
+            for (size_t first = 0; first < rows; first += predictChunkRows)
+            {
+                size_t count = (std::min)(predictChunkRows, rows - first);
+                const float *in = inputs.data() + first * inputSize;
+
+                if (normalizer)
                 {
-                    // Get data batches from the dataset
-                    auto [batchInputs, batchLabels] = dataset.getBatch(batch, batchSize);
-                    size_t currentBatchSize = batchInputs.size() / inputSize;
+                    normalized.resize(count * inputSize);
+                    for (size_t r = 0; r < count; ++r)
+                        normalizer->apply(in + r * inputSize, normalized.data() + r * inputSize);
+                    in = normalized.data();
+                }
 
-                    if (currentBatchSize == 0)
-                        continue;
+                forwardBatchRaw(in, outputs.data() + first * outputSize, count, scratch);
+            }
+        }
 
-                    // Zero gradients at start of batch
-                    std::apply([](auto &...layer) { ((layer.clearGradients()), ...); }, layers);
+        /**
+         * @brief Computes loss, accuracy, MAE, RMSE and AUC over a dataset without training
+         *
+         * Batches are gathered on the calling thread; their rows are then split
+         * into chunks that the pool runs through batched inference, each chunk
+         * slot accumulating partial metrics. parallelFor joins once per batch.
+         *
+         * @tparam Dataset Dataset or DatasetView type
+         * @tparam LossFunction Loss function type. Must provide static compute()
+         *
+         * @param dataset Samples to evaluate
+         * @param batchSize Number of samples gathered per batch
+         * @param pool Threads to run inference on
+         * @param withAuc Whether to compute AUC, which keeps and sorts every
+         *        prediction; without it, auc is NaN and memory stays constant
+         * @return Metrics over all samples (zeros for an empty dataset)
+         */
+        template <polann::core::BatchSource Dataset, typename LossFunction = polann::loss::MSE>
+        [[nodiscard]] Metrics evaluate(const Dataset &dataset, size_t batchSize = 1024,
+                                       polann::core::ThreadPool &pool = polann::core::ThreadPool::global(),
+                                       bool withAuc = true) const
+        {
+            static_assert(Dataset::inputSize == inputSize, "Dataset input size mismatch");
+            static_assert(Dataset::outputSize == outputSize, "Dataset output size mismatch");
+
+            [[maybe_unused]] auto scope = profiler.evaluate();
+            return detail::evaluateLoop<LossFunction>(
+                dataset, batchSize, pool, withAuc,
+                [&](size_t batch, size_t size) { return timedGetBatch(dataset, batch, size); },
+                [this](const float *in, float *out, size_t rows, BatchScratch &scratch) { forwardBatchRaw(in, out, rows, scratch); });
+        }
 
-                    float batchLoss = 0.0f;
+        /**
+         * @brief Writes weights, biases and the normalizer in binary form
+         *
+         * Layout: magic, format version, layer count, then per layer the input and
+         * output size and activation followed by weights and biases, then an
+         * optional normalizer (see model_format.hpp).
+         *
+         * @param os Binary output stream
+         */
+        void save(std::ostream &os) const
+        {
+            uint32_t version = modelFormatVersion;
+            uint32_t count = layerCount;
+            os.write(modelMagic, sizeof(modelMagic));
+            os.write(reinterpret_cast<const char *>(&version), sizeof(version));
+            os.write(reinterpret_cast<const char *>(&count), sizeof(count));
 
-                    // Accululate gradients over all samples
-                    for (size_t sample = 0; sample < currentBatchSize; sample++)
-                    {
-                        std::array<float, inputSize> input{};
-                        std::array<float, outputSize> target{};
+            std::apply([&](const auto &...layer) { ((saveLayer(os, layer)), ...); }, layers);
 
-                        std::copy_n(batchInputs.data() + sample * inputSize, inputSize, input.begin());
-                        std::copy_n(batchLabels.data() + sample * outputSize, outputSize, target.begin());
+            uint8_t hasNormalizer = normalizer.has_value();
+            os.write(reinterpret_cast<const char *>(&hasNormalizer), sizeof(hasNormalizer));
+            if (normalizer)
+                normalizer->save(os);
 
-                        // Forward pass
-                        auto prediction = predict(input);
+            if (!os)
+                throw std::runtime_error("Failed to write model");
+        }
 
-                        // Loss
-                        std::span<const float> predSpan(prediction);
-                        std::span<const float> targetSpan(target);
-                        batchLoss += LossFunction::compute(predSpan, targetSpan);
+        void save(const std::filesystem::path &path) const
+        {
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for writing");
+            save(file);
+        }
 
-                        // Gradients
-                        std::array<float, outputSize> dLoss{};
-                        LossFunction::gradient(predSpan, targetSpan, std::span(dLoss));
+        /**
+         * @brief Reads parameters written by save() into this network
+         *
+         * The stored layer shapes must match this network's architecture.
+         * Everything is read before any of it is applied, so the network is
+         * unchanged if reading fails. Packed layers are re-packed.
+         *
+         * @param is Binary input stream
+         */
+        void load(std::istream &is)
+        {
+            char magic[sizeof(modelMagic)] = {};
+            uint32_t version = 0;
+            uint32_t count = 0;
+            is.read(magic, sizeof(magic));
+            is.read(reinterpret_cast<char *>(&version), sizeof(version));
+            is.read(reinterpret_cast<char *>(&count), sizeof(count));
+
+            if (!is || !std::equal(std::begin(magic), std::end(magic), std::begin(modelMagic)))
+                throw std::runtime_error("Not a polann model");
+            if (version < minModelFormatVersion || version > modelFormatVersion)
+                throw std::runtime_error("Unsupported model format version");
+            if (count != layerCount)
+                throw std::runtime_error("Layer count mismatch");
+
+            std::array<StagedParameters, layerCount> staged;
+            size_t index = 0;
+            std::apply([&](const auto &...layer) { ((staged[index++] = loadLayer(is, layer, version)), ...); }, layers);
+
+            uint8_t hasNormalizer = 0;
+            is.read(reinterpret_cast<char *>(&hasNormalizer), sizeof(hasNormalizer));
+            if (!is)
+                throw std::runtime_error("Truncated model data");
+
+            std::optional<NormalizerType> loadedNormalizer;
+            if (hasNormalizer)
+                loadedNormalizer = NormalizerType::load(is);
+
+            index = 0;
+            std::apply([&](auto &...layer) { ((commitLayer(layer, staged[index++])), ...); }, layers);
+            normalizer = std::move(loadedNormalizer);
+            revision.bump();
+            if (isPacked())
+                finalizeForInference();
+        }
 
-                        // Backward pass
-                        backward(dLoss);
-                    }
+        void load(const std::filesystem::path &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for reading");
+            load(file);
+        }
 
-                    // Scale gradients by 1/batchSize and update weights
-                    float scale = 1.0f / currentBatchSize;
-                    std::apply([&](auto &...layer) { ((layer.scaleGradients(scale)), ...); }, layers);
-                    std::apply([&](auto &...layer) { ((optimizer.step(layer)), ...); }, layers);
+        /**
+         * @brief Returns the accumulated per-layer and per-phase timings
+         *
+         * Counters are only recorded when polann is configured with
+         * POLANN_ENABLE_PROFILING; otherwise the profile is empty and the
+         * instrumentation compiles away entirely.
+         */
+        [[nodiscard]] utils::Profile profile() const { return profiler.snapshot(); }
 
-                    epochLoss += batchLoss;
-                    totalSamples += currentBatchSize;
-                }
+        void resetProfile() { profiler.reset(); }
 
-                if (totalSamples > 0)
-                    epochLoss /= totalSamples;
+        /**
+         * @brief Emits epoch, batch, layer, data and optimizer spans to a trace
+         *
+         * Requires POLANN_ENABLE_PROFILING; otherwise this is a no-op. Spans are
+         * tagged with the recording thread. Pass nullptr to stop tracing.
+         *
+         * @param recorder Recorder that must outlive the traced calls
+         */
+        void setTrace(utils::TraceRecorder *recorder) { profiler.setTrace(recorder); }
 
-                if (verbose && (epoch % 10 == 0 || epoch == epochs - 1))
-                    std::cout << "Epoch " << epoch << "/" << epochs << ", Loss: " << epochLoss << std::endl;
+    private:
+        std::tuple<Layers...> layers;
+        std::optional<NormalizerType> normalizer;
+        Revision revision; /// See parameterRevision()
+        [[no_unique_address]] mutable utils::DefaultProfiler<layerCount> profiler;
+
+        static constexpr size_t predictChunkRows = 256; /// Rows per batched forward pass in predictBatch
+
+        // One layer's parameters read by load, applied once the whole model was read
+        struct StagedParameters
+        {
+            std::vector<float> weights;
+            std::vector<float> biases;
+        };
+
+        using BatchScratch = detail::BatchScratch;
+
+        template <typename Layer>
+        using LayerBuffer = std::vector<float, polann::core::AlignedAllocator<float>>;
+
+        // Per-layer batch outputs and ping-pong gradients of a training step
+        struct TrainScratch
+        {
+            std::tuple<LayerBuffer<Layers>...> outputs;
+            std::vector<float, polann::core::AlignedAllocator<float>> grad1;
+            std::vector<float, polann::core::AlignedAllocator<float>> grad2;
+        };
+
+        [[nodiscard]] const NormalizerType *transform() const { return normalizer ? &*normalizer : nullptr; }
+
+        // Layer iteration of detail::trainLoop over the layer tuple
+        struct TrainSteps
+        {
+            NN &model;
+            TrainScratch scratch;
+
+            auto &profiler() { return model.profiler; }
+
+            template <typename Dataset>
+            auto getBatch(const Dataset &dataset, size_t batch, size_t batchSize) { return model.timedGetBatch(dataset, batch, batchSize); }
+
+            void clearGradients() { std::apply([](auto &...layer) { ((layer.clearGradients()), ...); }, model.layers); }
+
+            std::span<const float> forward(const float *input, size_t rows)
+            {
+                model.forwardTrain(input, rows, scratch, std::index_sequence_for<Layers...>{});
+                return std::get<layerCount - 1>(scratch.outputs);
+            }
+
+            std::span<float> lossGradients() { return scratch.grad1; }
+
+            void backward(const float *input, size_t rows) { model.backwardTrain(input, rows, scratch, std::index_sequence_for<Layers...>{}); }
+
+            void scaleGradients(float scale) { std::apply([&](auto &...layer) { ((layer.scaleGradients(scale)), ...); }, model.layers); }
+
+            template <typename Optimizer>
+            void step(Optimizer &optimizer)
+            {
+                std::apply([&](auto &...layer) { ((optimizer.step(layer)), ...); }, model.layers);
+                model.revision.bump();
             }
+        };
+
+        template <typename LossFunction, typename Dataset, typename Optimizer, typename... Callbacks>
+        void train(Dataset &dataset, Optimizer &optimizer, int epochs, int batchSize, bool shuffle, Callbacks &...hooks)
+        {
+            TrainSteps steps{*this, {}};
+            detail::trainLoop<LossFunction>(*this, steps, dataset, optimizer, epochs, batchSize, shuffle, hooks...);
         }
 
-    private:
-        std::tuple<Layers...> layers;
+        template <typename Dataset>
+        [[nodiscard]] auto timedGetBatch(const Dataset &dataset, size_t batch, size_t batchSize) const
+        {
+            [[maybe_unused]] auto scope = profiler.getBatch();
+            return dataset.getBatch(batch, batchSize, transform());
+        }
+
+        // Batched inference on already normalized rows; thread-safe
+        void forwardBatchRaw(const float *input, float *output, size_t rows, BatchScratch &scratch) const
+        {
+            if (rows == 0)
+                return;
+
+            if (scratch.buf1.size() < rows * maxLayerOutputSize)
+            {
+                scratch.buf1.resize(rows * maxLayerOutputSize);
+                scratch.buf2.resize(rows * maxLayerOutputSize);
+            }
+
+            forwardBatchImpl(input, output, rows, scratch, std::index_sequence_for<Layers...>{});
+        }
+
+        template <size_t... I>
+        void forwardBatchImpl(const float *input, float *output, size_t rows, BatchScratch &scratch, std::index_sequence<I...>) const
+        {
+            const float *src = input;
+            auto step = [&]<size_t LayerIndex>()
+            {
+                using Layer = std::tuple_element_t<LayerIndex, std::tuple<Layers...>>;
+
+                // The last layer writes straight into the output rows
+                float *dst = LayerIndex + 1 == layerCount ? output
+                             : LayerIndex % 2 == 0        ? scratch.buf1.data()
+                                                          : scratch.buf2.data();
+
+                [[maybe_unused]] auto scope = profiler.forward(LayerIndex, rows * Layer::forwardFlops, rows * Layer::forwardBytes);
+                std::get<LayerIndex>(layers).forwardBatch(src, dst, rows);
+                src = dst;
+            };
+            (step.template operator()<I>(), ...);
+        }
+
+        template <typename Layer>
+        static void saveLayer(std::ostream &os, const Layer &layer)
+        {
+            uint64_t shape[2] = {Layer::inputSize, Layer::outputSize};
+            uint8_t activation = static_cast<uint8_t>(utils::activationKind<typename Layer::ActivationType>);
+            os.write(reinterpret_cast<const char *>(shape), sizeof(shape));
+            os.write(reinterpret_cast<const char *>(&activation), sizeof(activation));
+            os.write(reinterpret_cast<const char *>(layer.weights.data()), sizeof(float) * layer.weights.size());
+            os.write(reinterpret_cast<const char *>(layer.biases.data()), sizeof(float) * layer.biases.size());
+        }
+
+        template <typename Layer>
+        static StagedParameters loadLayer(std::istream &is, const Layer &layer, uint32_t version)
+        {
+            uint64_t shape[2] = {};
+            is.read(reinterpret_cast<char *>(shape), sizeof(shape));
+            if (!is || shape[0] != Layer::inputSize || shape[1] != Layer::outputSize)
+                throw std::runtime_error("Layer shape mismatch");
+
+            if (storesActivations(version))
+            {
+                uint8_t stored = 0;
+                is.read(reinterpret_cast<char *>(&stored), sizeof(stored));
+                if (stored != static_cast<uint8_t>(utils::activationKind<typename Layer::ActivationType>))
+                    throw std::runtime_error("Layer activation mismatch");
+            }
+
+            StagedParameters staged{std::vector<float>(layer.weights.size()), std::vector<float>(layer.biases.size())};
+            is.read(reinterpret_cast<char *>(staged.weights.data()), sizeof(float) * staged.weights.size());
+            is.read(reinterpret_cast<char *>(staged.biases.data()), sizeof(float) * staged.biases.size());
+            if (!is)
+                throw std::runtime_error("Truncated model data");
+            return staged;
+        }
+
+        template <typename Layer>
+        static void commitLayer(Layer &layer, const StagedParameters &staged)
+        {
+            std::ranges::copy(staged.weights, layer.weights.begin());
+            std::ranges::copy(staged.biases, layer.biases.begin());
+        }
+
+        template <typename Layer>
+        static void packLayer(Layer &layer)
+        {
+            if constexpr (requires { layer.packForInference(); })
+                layer.packForInference();
+        }
+
+        template <typename Layer>
+        static void dropLayerPacking(Layer &layer)
+        {
+            if constexpr (requires { layer.dropPackedWeights(); })
+                layer.dropPackedWeights();
+        }
+
+        template <typename Layer>
+        [[nodiscard]] static bool layerPacked(const Layer &layer)
+        {
+            if constexpr (requires { layer.isPacked(); })
+                return layer.isPacked();
+            else
+                return false;
+        }
 
         template <size_t... I>
         [[nodiscard]] std::array<float, outputSize> predictImpl(
@@ -174,45 +569,66 @@ namespace polann::models
             auto &outBuf = selectOutputBuffer < LayerIndex % 2 == 0 > (buf1, buf2);
 
             // Run forward pass of the current layer
-            layer.forward(inBuf, outBuf);
+            using Layer = std::remove_cvref_t<decltype(layer)>;
+            [[maybe_unused]] auto scope = profiler.forward(LayerIndex, Layer::forwardFlops, Layer::forwardBytes);
+            if (layerPacked(layer))
+                layer.forwardBatch(inBuf.data(), outBuf.data(), 1); // Single-row kernel on the packed weights
+            else
+                layer.forward(inBuf, outBuf);
         }
 
-        template <size_t OutputSize>
-        void backward(const std::array<float, OutputSize> &dLoss)
+        // Forward over a batch keeping every layer's outputs for backwardTrain
+        template <size_t... I>
+        void forwardTrain(const float *input, size_t rows, TrainScratch &scratch, std::index_sequence<I...>)
         {
-            static_assert(OutputSize == outputSize, "Input size mismatch");
+            auto step = [&]<size_t LayerIndex>()
+            {
+                using Layer = std::tuple_element_t<LayerIndex, std::tuple<Layers...>>;
 
-            alignas(32) std::array<float, maxLayerOutputSize> buf1{};
-            alignas(32) std::array<float, maxLayerOutputSize> buf2{};
-            std::copy(dLoss.begin(), dLoss.end(), buf1.begin()); // Start with loss gradients in first buffer
+                const float *src = input;
+                if constexpr (LayerIndex > 0)
+                    src = std::get<LayerIndex - 1>(scratch.outputs).data();
 
-            return backwardImpl(buf1, buf2, std::index_sequence_for<Layers...>{});
+                auto &dst = std::get<LayerIndex>(scratch.outputs);
+                dst.resize(rows * Layer::outputSize);
+
+                [[maybe_unused]] auto scope = profiler.forward(LayerIndex, rows * Layer::forwardFlops, rows * Layer::forwardBytes);
+                std::get<LayerIndex>(layers).forwardBatch(src, dst.data(), rows);
+            };
+            (step.template operator()<I>(), ...);
+
+            if (scratch.grad1.size() < rows * maxLayerOutputSize)
+            {
+                scratch.grad1.resize(rows * maxLayerOutputSize);
+                scratch.grad2.resize(rows * maxLayerOutputSize);
+            }
         }
 
+        // Backward over a batch; expects the loss gradient in scratch.grad1
         template <size_t... I>
-        void backwardImpl(
-            std::array<float, maxLayerOutputSize> &buf1,
-            std::array<float, maxLayerOutputSize> &buf2,
-            std::index_sequence<I...>)
+        void backwardTrain(const float *input, size_t rows, TrainScratch &scratch, std::index_sequence<I...>)
         {
-            // Process layers using reverse fold
-            ((backwardLayer<sizeof...(Layers) - 1 - I>(buf1, buf2)), ...);
-        }
+            float *gradOut = scratch.grad1.data();
+            float *gradIn = scratch.grad2.data();
 
-        template <size_t LayerIndex>
-        void backwardLayer(
-            std::array<float, maxLayerOutputSize> &buf1,
-            std::array<float, maxLayerOutputSize> &buf2)
-        {
-            auto &layer = std::get<LayerIndex>(layers);
+            auto step = [&]<size_t LayerIndex>()
+            {
+                using Layer = std::tuple_element_t<LayerIndex, std::tuple<Layers...>>;
+
+                const float *src = input;
+                if constexpr (LayerIndex > 0)
+                    src = std::get<LayerIndex - 1>(scratch.outputs).data();
+
+                // The first layer's input gradient is not needed
+                float *dst = LayerIndex == 0 ? nullptr : gradIn;
 
-            // For backward pass, gradient flows from output to input
-            constexpr size_t reverseIndex = sizeof...(Layers) - 1 - LayerIndex;
-            auto &gradOut = selectInputBuffer < reverseIndex % 2 == 0 > (buf1, buf2);
-            auto &gradIn = selectOutputBuffer < reverseIndex % 2 == 0 > (buf1, buf2);
+                [[maybe_unused]] auto scope = profiler.backward(LayerIndex, rows * Layer::backwardFlops, rows * Layer::backwardBytes);
+                std::get<LayerIndex>(layers).backwardBatch(src, std::get<LayerIndex>(scratch.outputs).data(), gradOut, dst, rows);
+                std::swap(gradOut, gradIn);
+            };
 
-            // Run backward pass of the current layer
-            layer.backward(gradOut, gradIn);
+            // Process layers in reverse order
+            (step.template operator()<layerCount - 1 - I>(), ...);
         }
 
         template <bool useBuf1>
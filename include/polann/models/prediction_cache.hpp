@@ -0,0 +1,319 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include "polann/core/aligned_allocator.hpp"
+
+namespace polann::models
+{
+    struct PredictionCacheOptions
+    {
+        size_t capacity = size_t{1} << 16; /// Cached predictions over all shards
+        size_t shards = 16;                /// Independently locked partitions, rounded up to a power of two
+    };
+
+    struct CacheCounters
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+        [[nodiscard]] double hitRate() const
+        {
+            uint64_t lookups = hits + misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+        }
+    };
+
+    namespace detail
+    {
+        // Multiply-xorshift over 8-byte words with a splitmix64 finish; keys are compared exactly
+        inline uint64_t hashFloats(const float *data, size_t count)
+        {
+            uint64_t h = 0x9E3779B97F4A7C15ull ^ count;
+            size_t i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                h = (h ^ word) * 0xBF58476D1CE4E5B9ull;
+                h ^= h >> 29;
+            }
+            if (i < count)
+            {
+                uint32_t tail;
+                std::memcpy(&tail, data + i, sizeof(tail));
+                h = (h ^ tail) * 0xBF58476D1CE4E5B9ull;
+            }
+
+            h ^= h >> 30;
+            h *= 0xBF58476D1CE4E5B9ull;
+            h ^= h >> 27;
+            h *= 0x94D049BB133111EBull;
+            return h ^ (h >> 31);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Bounded memo of predictions in front of a model
+     *
+     * Inputs are keyed by a 64-bit hash and compared bit for bit, so a hit
+     * returns exactly what the model's predictBatch produced. Entries are spread over shards
+     * with one lock each and evicted with the CLOCK algorithm. Every entry
+     * remembers the model's parameterRevision(); once fit, load, assignment
+     * or a normalizer change bumps it, older entries count as misses and are
+     * overwritten. Lookups and inserts are thread-safe. The revision is
+     * atomic, but the weights are read without a lock: do not train or load
+     * the model while the cache serves predictions from other threads.
+     *
+     * @tparam Model NN, DynamicNN or anything with predictBatch, sizes and parameterRevision()
+     */
+    template <typename Model>
+    class PredictionCache
+    {
+    public:
+        /**
+         * @param model Network to memoize; must outlive the cache
+         * @param options Capacity and shard count
+         * @throws std::invalid_argument for a capacity smaller than the shard count
+         */
+        explicit PredictionCache(const Model &model, PredictionCacheOptions options = {})
+            : model(model), shardCount(std::bit_ceil((std::max)(options.shards, size_t{1})))
+        {
+            if (options.capacity < shardCount)
+                throw std::invalid_argument("Cache capacity must be at least the shard count");
+
+            slotsPerShard = options.capacity / shardCount;
+            shards = std::make_unique<Shard[]>(shardCount);
+            for (size_t s = 0; s < shardCount; ++s)
+                shards[s].reserve(slotsPerShard, inputSize(), outputSize());
+        }
+
+        [[nodiscard]] size_t inputSize() const
+        {
+            if constexpr (requires { model.inputSize(); })
+                return model.inputSize();
+            else
+                return Model::inputSize;
+        }
+
+        [[nodiscard]] size_t outputSize() const
+        {
+            if constexpr (requires { model.outputSize(); })
+                return model.outputSize();
+            else
+                return Model::outputSize;
+        }
+
+        [[nodiscard]] size_t capacity() const { return slotsPerShard * shardCount; }
+
+        /**
+         * @brief Cached counterpart of Model::predict
+         *
+         * @return The model's output type: std::array for NN, std::vector for DynamicNN
+         */
+        template <typename Input>
+        [[nodiscard]] auto predict(const Input &input) const
+        {
+            std::span<const float> in(input.data(), input.size());
+            if constexpr (requires { std::integral_constant<size_t, Model::outputSize>{}; })
+            {
+                std::array<float, Model::outputSize> output;
+                predictBatch(in, output);
+                return output;
+            }
+            else
+            {
+                std::vector<float> output(outputSize());
+                predictBatch(in, output);
+                return output;
+            }
+        }
+
+        /**
+         * @brief Answers cached rows from memory and runs the rest as one batch
+         *
+         * @param inputs Row-major inputs, a multiple of inputSize()
+         * @param outputs Row-major outputs with room for the same number of rows
+         */
+        void predictBatch(std::span<const float> inputs, std::span<float> outputs) const
+        {
+            const size_t in = inputSize();
+            const size_t out = outputSize();
+            const size_t rows = inputs.size() / in;
+            if (inputs.size() % in != 0 || outputs.size() < rows * out)
+                throw std::invalid_argument("Batch size mismatch");
+
+            const uint64_t revision = model.parameterRevision();
+
+            thread_local std::vector<size_t> missed;
+            thread_local std::vector<uint64_t> missedHashes;
+            missed.clear();
+            missedHashes.clear();
+
+            for (size_t r = 0; r < rows; ++r)
+            {
+                const float *row = inputs.data() + r * in;
+                uint64_t hash = detail::hashFloats(row, in);
+                if (!shardOf(hash).find(hash, revision, row, outputs.data() + r * out, in, out))
+                {
+                    missed.push_back(r);
+                    missedHashes.push_back(hash);
+                }
+            }
+
+            if (missed.empty())
+                return;
+
+            // Misses run through the model together, then fill the cache
+            thread_local std::vector<float, polann::core::AlignedAllocator<float>> missedInputs;
+            thread_local std::vector<float, polann::core::AlignedAllocator<float>> missedOutputs;
+            missedInputs.resize(missed.size() * in);
+            missedOutputs.resize(missed.size() * out);
+            for (size_t m = 0; m < missed.size(); ++m)
+                std::copy_n(inputs.data() + missed[m] * in, in, missedInputs.data() + m * in);
+
+            model.predictBatch(missedInputs, missedOutputs);
+
+            for (size_t m = 0; m < missed.size(); ++m)
+            {
+                const float *result = missedOutputs.data() + m * out;
+                std::copy_n(result, out, outputs.data() + missed[m] * out);
+                shardOf(missedHashes[m]).insert(missedHashes[m], revision, missedInputs.data() + m * in, result,
+                                                in, out, slotsPerShard);
+            }
+        }
+
+        /**
+         * @brief Hits and misses since construction or resetCounters()
+         */
+        [[nodiscard]] CacheCounters counters() const
+        {
+            CacheCounters total;
+            for (size_t s = 0; s < shardCount; ++s)
+            {
+                std::lock_guard lock(shards[s].mutex);
+                total.hits += shards[s].hits;
+                total.misses += shards[s].misses;
+            }
+            return total;
+        }
+
+        void resetCounters()
+        {
+            for (size_t s = 0; s < shardCount; ++s)
+            {
+                std::lock_guard lock(shards[s].mutex);
+                shards[s].hits = 0;
+                shards[s].misses = 0;
+            }
+        }
+
+        /**
+         * @brief Drops every entry; not needed after weight updates, which invalidate entries themselves
+         */
+        void clear()
+        {
+            for (size_t s = 0; s < shardCount; ++s)
+            {
+                std::lock_guard lock(shards[s].mutex);
+                shards[s].index.clear();
+                shards[s].used = 0;
+                shards[s].hand = 0;
+            }
+        }
+
+    private:
+        // One lock-striped partition: fixed slot arrays swept by a CLOCK hand
+        struct alignas(64) Shard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<uint64_t, uint32_t> index; /// Hash to slot
+            std::vector<float> keys;                      /// slots x inputSize
+            std::vector<float> values;                    /// slots x outputSize
+            std::vector<uint64_t> hashes;
+            std::vector<uint64_t> revisions;
+            std::vector<uint8_t> referenced; /// CLOCK bit, set on every hit
+            size_t used = 0;
+            size_t hand = 0;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+
+            void reserve(size_t slots, size_t in, size_t out)
+            {
+                index.reserve(slots);
+                keys.resize(slots * in);
+                values.resize(slots * out);
+                hashes.resize(slots);
+                revisions.resize(slots);
+                referenced.resize(slots);
+            }
+
+            bool find(uint64_t hash, uint64_t revision, const float *input, float *output, size_t in, size_t out)
+            {
+                std::lock_guard lock(mutex);
+                auto it = index.find(hash);
+                if (it == index.end() || revisions[it->second] != revision ||
+                    std::memcmp(keys.data() + it->second * in, input, in * sizeof(float)) != 0)
+                {
+                    ++misses;
+                    return false;
+                }
+
+                referenced[it->second] = 1;
+                std::copy_n(values.data() + it->second * out, out, output);
+                ++hits;
+                return true;
+            }
+
+            void insert(uint64_t hash, uint64_t revision, const float *input, const float *output,
+                        size_t in, size_t out, size_t slots)
+            {
+                std::lock_guard lock(mutex);
+
+                // Stale or colliding entries are overwritten in place
+                size_t slot;
+                auto it = index.find(hash);
+                if (it != index.end())
+                    slot = it->second;
+                else if (used < slots)
+                    slot = used++;
+                else
+                {
+                    while (referenced[hand])
+                    {
+                        referenced[hand] = 0;
+                        hand = (hand + 1) % slots;
+                    }
+                    slot = hand;
+                    hand = (hand + 1) % slots;
+                    index.erase(hashes[slot]);
+                }
+
+                index[hash] = static_cast<uint32_t>(slot);
+                hashes[slot] = hash;
+                revisions[slot] = revision;
+                referenced[slot] = 0;
+                std::copy_n(input, in, keys.data() + slot * in);
+                std::copy_n(output, out, values.data() + slot * out);
+            }
+        };
+
+        const Model &model;
+        size_t shardCount;
+        size_t slotsPerShard = 0;
+        std::unique_ptr<Shard[]> shards; // Mutable through a const cache: lookups insert
+
+        Shard &shardOf(uint64_t hash) const { return shards[(hash >> 32) & (shardCount - 1)]; }
+    };
+
+} // namespace polann::models
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace polann::models
+{
+    /**
+     * @brief Copyable atomic counter behind a model's parameterRevision()
+     *
+     * Prediction caches read it from serving threads while the model is
+     * updated elsewhere, and key their entries on its value alone. Every
+     * construction, copy, assignment and bump therefore draws a fresh value
+     * from one process-wide sequence: two models, or one model before and
+     * after `a = b`, never share a revision. Only the counters themselves
+     * need to be race-free, so every access is relaxed.
+     */
+    class Revision
+    {
+    public:
+        Revision() noexcept : value(next()) {}
+        Revision(const Revision &) noexcept : value(next()) {}
+
+        Revision &operator=(const Revision &) noexcept
+        {
+            bump();
+            return *this;
+        }
+
+        [[nodiscard]] uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+        void bump() { value.store(next(), std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64_t> value;
+
+        static uint64_t next()
+        {
+            static std::atomic<uint64_t> sequence{0};
+            return sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+    };
+
+} // namespace polann::models
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <span>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+#include "polann/core/dataset.hpp"
+#include "polann/core/dataset_view.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/loss/mse.hpp"
+#include "polann/models/metrics.hpp"
+#include "polann/optimizers/sgd.hpp"
+
+namespace polann::models
+{
+    /**
+     * @brief One point of a hyper-parameter sweep
+     */
+    struct SweepConfig
+    {
+        float learningRate = 0.01f;
+        int batchSize = 32;
+        uint32_t seed = 0; /// Seeds the weight initialization and the shuffle order
+        int epochs = 10;
+    };
+
+    struct SweepResult
+    {
+        size_t index = 0;   /// Position of the config in the sweep's input
+        SweepConfig config;
+        Metrics validation; /// Metrics of the trained model on the validation set
+        double seconds = 0.0;
+    };
+
+    namespace detail
+    {
+        // Private view over the same samples: views own their index order and
+        // batch buffers, so one per run makes a shared dataset safe to read
+        template <typename Source>
+        auto privateView(const Source &source)
+        {
+            if constexpr (requires { source.base(); source.sampleIndices(); })
+            {
+                using Base = std::remove_cvref_t<decltype(source.base())>;
+                auto indices = source.sampleIndices();
+                return core::DatasetView<Base>(source.base(), std::vector<size_t>(indices.begin(), indices.end()));
+            }
+            else
+                return core::DatasetView<Source>(source);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Trains one model per config concurrently and ranks them on a validation set
+     *
+     * Every config becomes one pool task, so small models that cannot keep a
+     * core busy on their own fill the machine together. Runs only read the
+     * datasets; each gets its own view and, when the model provides
+     * initialize(seed), a reproducible start. Each run trains and evaluates
+     * on its own thread, so no two runs contend for a worker.
+     *
+     * @tparam LossFunction Loss used for training and ranking
+     * @tparam Optimizer Constructed from the config's learning rate
+     *
+     * @param train Training samples, a Dataset or DatasetView
+     * @param validation Samples the results are ranked on
+     * @param configs Hyper-parameters of each run
+     * @param makeModel Callable invoked as makeModel(config) returning a fresh model
+     * @param pool Threads to run the sweep on
+     * @return Results ordered by ascending validation loss, diverged (NaN) runs last
+     */
+    template <typename LossFunction = polann::loss::MSE, typename Optimizer = polann::optimizers::SGD,
+              polann::core::BatchSource Train, polann::core::BatchSource Validation, typename MakeModel>
+    [[nodiscard]] std::vector<SweepResult> runSweep(const Train &train, const Validation &validation,
+                                                    std::span<const SweepConfig> configs, MakeModel &&makeModel,
+                                                    polann::core::ThreadPool &pool = polann::core::ThreadPool::global())
+    {
+        std::vector<SweepResult> results(configs.size());
+
+        pool.parallelFor(0, configs.size(), 1, [&](size_t begin, size_t end)
+        {
+            polann::core::ThreadPool serial(0);
+            for (size_t i = begin; i < end; ++i)
+            {
+                const SweepConfig &config = configs[i];
+                auto start = std::chrono::steady_clock::now();
+
+                auto model = makeModel(config);
+                if constexpr (requires { model.initialize(config.seed); })
+                    model.initialize(config.seed);
+
+                auto trainView = detail::privateView(train);
+                auto validationView = detail::privateView(validation);
+                trainView.seed(config.seed);
+
+                Optimizer optimizer(config.learningRate);
+                model.template fit<decltype(trainView), Optimizer, LossFunction>(
+                    trainView, optimizer, config.epochs, config.batchSize, true, false);
+
+                results[i].index = i;
+                results[i].config = config;
+                results[i].validation = model.template evaluate<decltype(validationView), LossFunction>(validationView, 1024, serial);
+                results[i].seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+        });
+
+        // A diverged run has a NaN loss, which has no order; ranking on (isnan, loss)
+        // keeps the comparison a strict weak ordering and puts those runs last
+        std::ranges::stable_sort(results, {}, [](const SweepResult &r)
+                                 { return std::pair(std::isnan(r.validation.loss), r.validation.loss); });
+        return results;
+    }
+
+    template <typename LossFunction = polann::loss::MSE, typename Optimizer = polann::optimizers::SGD,
+              polann::core::BatchSource Train, polann::core::BatchSource Validation, typename MakeModel>
+    [[nodiscard]] std::vector<SweepResult> runSweep(const Train &train, const Validation &validation,
+                                                    std::initializer_list<SweepConfig> configs, MakeModel &&makeModel,
+                                                    polann::core::ThreadPool &pool = polann::core::ThreadPool::global())
+    {
+        return runSweep<LossFunction, Optimizer>(train, validation, std::span<const SweepConfig>(configs.begin(), configs.size()),
+                                                 std::forward<MakeModel>(makeModel), pool);
+    }
+
+    /**
+     * @brief Prints sweep results as a table, one ranked run per line
+     */
+    inline void printSweepResults(std::ostream &os, std::span<const SweepResult> results)
+    {
+        os << std::left << std::setw(6) << "rank" << std::setw(6) << "run" << std::setw(12) << "lr"
+           << std::setw(8) << "batch" << std::setw(8) << "epochs" << std::setw(12) << "seed"
+           << std::setw(14) << "val loss" << std::setw(12) << "accuracy" << "seconds\n";
+
+        for (size_t rank = 0; rank < results.size(); ++rank)
+        {
+            const SweepResult &r = results[rank];
+            os << std::setw(6) << rank + 1 << std::setw(6) << r.index << std::setw(12) << r.config.learningRate
+               << std::setw(8) << r.config.batchSize << std::setw(8) << r.config.epochs << std::setw(12) << r.config.seed
+               << std::setw(14) << r.validation.loss << std::setw(12) << r.validation.accuracy
+               << std::fixed << std::setprecision(3) << r.seconds << std::defaultfloat << std::setprecision(6) << "\n";
+        }
+        os << std::right;
+    }
+
+} // namespace polann::models
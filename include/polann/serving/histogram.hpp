@@ -0,0 +1,132 @@
+#pragma once
+
+#include <bit>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include <string_view>
+
+namespace polann::serving
+{
+    /**
+     * @brief Lock-free log-linear histogram of non-negative integers, e.g. latencies in microseconds
+     *
+     * Values below 8 have exact buckets; above, every power of two is split
+     * into 8 buckets, so percentiles are accurate to 12.5%. Recording is a
+     * few relaxed atomic increments and safe from any number of threads.
+     */
+    class Histogram
+    {
+    public:
+        void record(uint64_t value)
+        {
+            buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_relaxed);
+            sum.fetch_add(value, std::memory_order_relaxed);
+
+            uint64_t seen = maximum.load(std::memory_order_relaxed);
+            while (value > seen && !maximum.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        [[nodiscard]] uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] uint64_t max() const { return maximum.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] double mean() const
+        {
+            uint64_t n = count();
+            return n == 0 ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(n);
+        }
+
+        /**
+         * @brief Upper bound of the bucket holding the q-quantile
+         *
+         * @param q Quantile in [0, 1]
+         * @return 0 for an empty histogram
+         */
+        [[nodiscard]] uint64_t percentile(double q) const
+        {
+            uint64_t n = count();
+            if (n == 0)
+                return 0;
+
+            uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(n - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t b = 0; b < bucketCount; ++b)
+            {
+                seen += buckets[b].load(std::memory_order_relaxed);
+                if (seen >= rank)
+                    return (std::min)(upperBound(b), max());
+            }
+            return max();
+        }
+
+        void reset()
+        {
+            for (auto &bucket : buckets)
+                bucket.store(0, std::memory_order_relaxed);
+            total.store(0, std::memory_order_relaxed);
+            sum.store(0, std::memory_order_relaxed);
+            maximum.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Prints count, mean, p50/p90/p99/p99.9 and max on one line
+         *
+         * @param name Label in front of the line
+         * @param unit Suffix of every value, e.g. "us"
+         */
+        void print(std::ostream &os, std::string_view name, std::string_view unit) const
+        {
+            // Leave the caller's formatting as it was
+            std::ios_base::fmtflags flags = os.flags();
+            std::streamsize precision = os.precision();
+
+            os << std::left << std::setw(10) << name << std::right << " n=" << count()
+               << " mean=" << std::fixed << std::setprecision(1) << mean() << unit << std::defaultfloat
+               << " p50=" << percentile(0.5) << unit << " p90=" << percentile(0.9) << unit
+               << " p99=" << percentile(0.99) << unit << " p99.9=" << percentile(0.999) << unit
+               << " max=" << max() << unit << "\n";
+
+            os.flags(flags);
+            os.precision(precision);
+        }
+
+    private:
+        static constexpr size_t subBuckets = 8;
+        static constexpr size_t subBits = 3;
+        static constexpr size_t bucketCount = subBuckets + (64 - subBits) * subBuckets;
+
+        std::array<std::atomic<uint64_t>, bucketCount> buckets{};
+        std::atomic<uint64_t> total{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> maximum{0};
+
+        static size_t bucketOf(uint64_t value)
+        {
+            if (value < subBuckets)
+                return static_cast<size_t>(value);
+
+            size_t exponent = static_cast<size_t>(std::bit_width(value)) - 1; // >= subBits
+            size_t sub = static_cast<size_t>(value >> (exponent - subBits)) & (subBuckets - 1);
+            return subBuckets + (exponent - subBits) * subBuckets + sub;
+        }
+
+        static uint64_t upperBound(size_t bucket)
+        {
+            if (bucket < subBuckets)
+                return bucket;
+
+            size_t exponent = (bucket - subBuckets) / subBuckets + subBits;
+            uint64_t sub = (bucket - subBuckets) % subBuckets;
+            uint64_t width = uint64_t{1} << (exponent - subBits);
+            return ((subBuckets + sub) << (exponent - subBits)) + width - 1;
+        }
+    };
+
+} // namespace polann::serving
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <span>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include <condition_variable>
+#include "polann/core/aligned_allocator.hpp"
+#include "polann/serving/histogram.hpp"
+
+namespace polann::serving
+{
+    struct BatchingOptions
+    {
+        size_t maxBatchRows = 64;               /// Rows that close a batch immediately
+        std::chrono::microseconds maxWait{200}; /// Longest the oldest request waits for company
+    };
+
+    /**
+     * @brief Histograms collected by a MicroBatcher
+     */
+    struct ServingStats
+    {
+        Histogram latency;   /// Enqueue to result, microseconds
+        Histogram queueWait; /// Enqueue to batch start, microseconds
+        Histogram compute;   /// Forward pass per batch, microseconds
+        Histogram batchRows; /// Rows per batch
+
+        void print(std::ostream &os) const
+        {
+            latency.print(os, "latency", "us");
+            queueWait.print(os, "queue", "us");
+            compute.print(os, "compute", "us");
+            batchRows.print(os, "batch", "");
+        }
+
+        void reset()
+        {
+            latency.reset();
+            queueWait.reset();
+            compute.reset();
+            batchRows.reset();
+        }
+    };
+
+    /**
+     * @brief Coalesces concurrent inference requests into micro-batches
+     *
+     * Callers block in predict() while a single worker thread collects queued
+     * requests until maxBatchRows rows are waiting or the oldest has waited
+     * maxWait, then runs them through one predictBatch call and hands every
+     * caller its rows back. A request is never split; one larger than
+     * maxBatchRows forms a batch of its own.
+     *
+     * @tparam Model NN, DynamicNN or anything with predictBatch and input/output sizes
+     */
+    template <typename Model>
+    class MicroBatcher
+    {
+    public:
+        /**
+         * @param model Network to serve; must outlive the batcher and not change while it runs
+         * @param options Batch size and wait bounds
+         * @throws std::invalid_argument if maxBatchRows is 0
+         */
+        explicit MicroBatcher(const Model &model, BatchingOptions options = {})
+            : model(model), options(validated(options)), worker([this](std::stop_token stop) { run(stop); })
+        {
+        }
+
+        /**
+         * @brief Finishes queued requests and stops the worker; callers must have returned
+         */
+        ~MicroBatcher()
+        {
+            worker.request_stop();
+            wake.notify_all();
+        }
+
+        MicroBatcher(const MicroBatcher &) = delete;
+        MicroBatcher &operator=(const MicroBatcher &) = delete;
+
+        [[nodiscard]] size_t inputSize() const
+        {
+            if constexpr (requires { model.inputSize(); })
+                return model.inputSize();
+            else
+                return Model::inputSize;
+        }
+
+        [[nodiscard]] size_t outputSize() const
+        {
+            if constexpr (requires { model.outputSize(); })
+                return model.outputSize();
+            else
+                return Model::outputSize;
+        }
+
+        /**
+         * @brief Runs rows through the model as part of the next batch; thread-safe and blocking
+         *
+         * @param inputs Row-major inputs, a positive multiple of inputSize()
+         * @param outputs Row-major outputs with room for the same number of rows
+         * @throws std::invalid_argument on size mismatch, or whatever the model threw
+         */
+        void predict(std::span<const float> inputs, std::span<float> outputs)
+        {
+            size_t rows = inputs.size() / inputSize();
+            if (rows == 0 || inputs.size() % inputSize() != 0 || outputs.size() < rows * outputSize())
+                throw std::invalid_argument("Batch size mismatch");
+
+            Request request{inputs.data(), outputs.data(), rows, Clock::now(), {}};
+            auto done = request.done.get_future();
+            {
+                std::lock_guard lock(mutex);
+                queue.push_back(&request);
+                queuedRows += rows;
+            }
+            wake.notify_one();
+            done.get();
+        }
+
+        /**
+         * @brief Rows queued and not yet picked up by the worker
+         */
+        [[nodiscard]] size_t pendingRows() const
+        {
+            std::lock_guard lock(mutex);
+            return queuedRows;
+        }
+
+        [[nodiscard]] const ServingStats &stats() const { return statistics; }
+
+        [[nodiscard]] ServingStats &stats() { return statistics; }
+
+        [[nodiscard]] const BatchingOptions &getOptions() const { return options; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request
+        {
+            const float *inputs;
+            float *outputs;
+            size_t rows;
+            Clock::time_point arrival;
+            std::promise<void> done;
+        };
+
+        const Model &model;
+        BatchingOptions options;
+        ServingStats statistics;
+
+        mutable std::mutex mutex;
+        std::condition_variable_any wake;
+        std::deque<Request *> queue;
+        size_t queuedRows = 0;
+
+        std::jthread worker; /// Declared last: starts after, and joins before, the state above
+
+        static BatchingOptions validated(BatchingOptions options)
+        {
+            if (options.maxBatchRows == 0)
+                throw std::invalid_argument("maxBatchRows must be positive");
+            return options;
+        }
+
+        static uint64_t micros(Clock::duration duration)
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+        }
+
+        void run(std::stop_token stop)
+        {
+            std::vector<Request *> batch;
+            std::vector<float, polann::core::AlignedAllocator<float>> inputs;
+            std::vector<float, polann::core::AlignedAllocator<float>> outputs;
+
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    if (!wake.wait(lock, stop, [&] { return !queue.empty(); }))
+                        return; // Stopped with nothing queued: no caller is waiting
+
+                    // Give the oldest request's batch until its deadline to fill up
+                    Clock::time_point deadline = queue.front()->arrival + options.maxWait;
+                    wake.wait_until(lock, stop, deadline, [&] { return queuedRows >= options.maxBatchRows; });
+
+                    size_t rows = 0;
+                    batch.clear();
+                    while (!queue.empty() && (batch.empty() || rows + queue.front()->rows <= options.maxBatchRows))
+                    {
+                        rows += queue.front()->rows;
+                        batch.push_back(queue.front());
+                        queue.pop_front();
+                    }
+                    queuedRows -= rows;
+                }
+
+                execute(batch, inputs, outputs);
+            }
+        }
+
+        template <typename Buffer>
+        void execute(const std::vector<Request *> &batch, Buffer &inputs, Buffer &outputs)
+        {
+            const size_t in = inputSize();
+            const size_t out = outputSize();
+            Clock::time_point start = Clock::now();
+
+            size_t rows = 0;
+            for (const Request *request : batch)
+            {
+                statistics.queueWait.record(micros(start - request->arrival));
+                rows += request->rows;
+            }
+
+            try
+            {
+                // A lone request is already contiguous
+                if (batch.size() == 1)
+                    model.predictBatch({batch[0]->inputs, rows * in}, {batch[0]->outputs, rows * out});
+                else
+                {
+                    inputs.resize(rows * in);
+                    outputs.resize(rows * out);
+
+                    size_t offset = 0;
+                    for (const Request *request : batch)
+                    {
+                        std::copy_n(request->inputs, request->rows * in, inputs.data() + offset * in);
+                        offset += request->rows;
+                    }
+
+                    model.predictBatch(inputs, outputs);
+
+                    offset = 0;
+                    for (const Request *request : batch)
+                    {
+                        std::copy_n(outputs.data() + offset * out, request->rows * out, request->outputs);
+                        offset += request->rows;
+                    }
+                }
+            }
+            catch (...)
+            {
+                for (Request *request : batch)
+                    request->done.set_exception(std::current_exception());
+                return;
+            }
+
+            Clock::time_point end = Clock::now();
+            statistics.compute.record(micros(end - start));
+            statistics.batchRows.record(rows);
+            for (Request *request : batch)
+            {
+                statistics.latency.record(micros(end - request->arrival));
+                request->done.set_value();
+            }
+        }
+    };
+
+} // namespace polann::serving
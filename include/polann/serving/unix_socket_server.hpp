@@ -0,0 +1,318 @@
+#pragma once
+
+#include <list>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include "polann/config.h"
+#include "polann/serving/micro_batcher.hpp"
+
+#if defined(POLANN_PLATFORM_LINUX) || defined(POLANN_PLATFORM_MACOS)
+#define POLANN_UNIX_SOCKETS
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace polann::serving
+{
+    /**
+     * @brief Wire format of UnixSocketServer, shared with clients
+     *
+     * Every request starts with a uint32 in host byte order. A plain value is
+     * the number of float inputs that follow (whole rows); the reply is a
+     * uint32 float count and the outputs. The reserved values below ask for
+     * the model shape or the server's statistics instead. Errors are replied
+     * as errorReply followed by a text message.
+     */
+    namespace protocol
+    {
+        inline constexpr uint32_t infoRequest = 0xFFFFFFFD;  /// Reply: uint32 inputSize, uint32 outputSize
+        inline constexpr uint32_t statsRequest = 0xFFFFFFFE; /// Reply: text message with the histograms
+        inline constexpr uint32_t errorReply = 0xFFFFFFFF;   /// Followed by a text message
+        inline constexpr uint32_t maxFloats = 1u << 24;      /// Largest accepted request
+
+#ifdef POLANN_UNIX_SOCKETS
+#ifdef MSG_NOSIGNAL
+        inline constexpr int sendFlags = MSG_NOSIGNAL; // A vanished client must not raise SIGPIPE
+#else
+        inline constexpr int sendFlags = 0;
+#endif
+
+        /**
+         * @brief Reads exactly size bytes, retrying partial reads
+         *
+         * @return false on end of stream or error
+         */
+        inline bool readAll(int fd, void *data, size_t size)
+        {
+            auto *bytes = static_cast<char *>(data);
+            while (size > 0)
+            {
+                ssize_t n = ::read(fd, bytes, size);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                bytes += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        inline bool writeAll(int fd, const void *data, size_t size)
+        {
+            const auto *bytes = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                ssize_t n = ::send(fd, bytes, size, sendFlags);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                bytes += n;
+                size -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Writes a uint32 length and the text
+         */
+        inline bool writeText(int fd, std::string_view text)
+        {
+            uint32_t length = static_cast<uint32_t>(text.size());
+            return writeAll(fd, &length, sizeof(length)) && writeAll(fd, text.data(), text.size());
+        }
+
+        inline bool readText(int fd, std::string &text)
+        {
+            uint32_t length = 0;
+            if (!readAll(fd, &length, sizeof(length)) || length > maxFloats)
+                return false;
+            text.resize(length);
+            return readAll(fd, text.data(), length);
+        }
+
+        /**
+         * @brief Opens a client connection to a server socket
+         *
+         * @throws std::system_error if the server cannot be reached
+         */
+        inline int connect(const std::filesystem::path &path)
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (path.native().size() >= sizeof(address.sun_path))
+                throw std::invalid_argument("Socket path too long: " + path.string());
+            std::strcpy(address.sun_path, path.c_str());
+
+            int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "socket");
+            if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+            {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot connect to " + path.string());
+            }
+            return fd;
+        }
+#endif
+    } // namespace protocol
+
+#ifdef POLANN_UNIX_SOCKETS
+    /**
+     * @brief Serves a MicroBatcher on a Unix domain stream socket
+     *
+     * Each connection gets a thread that reads requests (see protocol) and
+     * blocks in the batcher, so concurrent connections are what fill the
+     * micro-batches. Requests on one connection are answered in order.
+     *
+     * @tparam Model Model type of the batcher
+     */
+    template <typename Model>
+    class UnixSocketServer
+    {
+    public:
+        /**
+         * @brief Binds and listens on path, replacing a stale socket file
+         *
+         * @throws std::system_error if the socket cannot be created or bound
+         */
+        UnixSocketServer(MicroBatcher<Model> &batcher, std::filesystem::path path)
+            : batcher(batcher), path(std::move(path))
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (this->path.native().size() >= sizeof(address.sun_path))
+                throw std::invalid_argument("Socket path too long: " + this->path.string());
+            std::strcpy(address.sun_path, this->path.c_str());
+
+            listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener < 0)
+                throw std::system_error(errno, std::generic_category(), "socket");
+
+            std::error_code ignored;
+            if (std::filesystem::is_socket(this->path, ignored))
+                std::filesystem::remove(this->path, ignored);
+
+            if (::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::listen(listener, SOMAXCONN) != 0)
+            {
+                int error = errno;
+                ::close(listener);
+                throw std::system_error(error, std::generic_category(), "Cannot listen on " + this->path.string());
+            }
+        }
+
+        /**
+         * @brief Closes all connections and removes the socket file
+         */
+        ~UnixSocketServer()
+        {
+            {
+                std::lock_guard lock(mutex);
+                for (int fd : clients)
+                    ::shutdown(fd, SHUT_RDWR);
+            }
+            connections.clear(); // Joins
+            ::close(listener);
+
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+        }
+
+        UnixSocketServer(const UnixSocketServer &) = delete;
+        UnixSocketServer &operator=(const UnixSocketServer &) = delete;
+
+        [[nodiscard]] const std::filesystem::path &socketPath() const { return path; }
+
+        /**
+         * @brief Accepts connections until stop becomes true
+         *
+         * stop is polled every 100 ms, so it may be set from a signal handler.
+         */
+        void run(const std::atomic<bool> &stop)
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                pollfd pending{listener, POLLIN, 0};
+                int ready = ::poll(&pending, 1, pollIntervalMs);
+                if (ready < 0 && errno != EINTR)
+                    throw std::system_error(errno, std::generic_category(), "poll");
+                if (ready <= 0)
+                    continue;
+
+                int fd = ::accept(listener, nullptr, nullptr);
+                if (fd < 0)
+                    continue;
+
+                std::lock_guard lock(mutex);
+                reapFinished();
+                clients.insert(fd);
+                connections.emplace_back([this, fd] { serve(fd); });
+            }
+        }
+
+    private:
+        static constexpr int pollIntervalMs = 100; /// How often run() checks its stop flag
+
+        MicroBatcher<Model> &batcher;
+        std::filesystem::path path;
+        int listener = -1;
+
+        std::mutex mutex;
+        std::unordered_set<int> clients; /// Open connection sockets
+        std::list<std::jthread> connections;
+        std::vector<std::thread::id> finished; /// Connection threads that are about to exit
+
+        // Joins threads whose connection has closed; caller holds mutex
+        void reapFinished()
+        {
+            for (std::thread::id id : finished)
+                std::erase_if(connections, [&](std::jthread &thread)
+                {
+                    if (thread.get_id() != id)
+                        return false;
+                    thread.join();
+                    return true;
+                });
+            finished.clear();
+        }
+
+        void serve(int fd)
+        {
+            const size_t in = batcher.inputSize();
+            const size_t out = batcher.outputSize();
+            std::vector<float> inputs;
+            std::vector<float> outputs;
+
+            uint32_t count = 0;
+            while (protocol::readAll(fd, &count, sizeof(count)))
+            {
+                bool ok = true;
+                if (count == protocol::infoRequest)
+                {
+                    uint32_t shape[2] = {static_cast<uint32_t>(in), static_cast<uint32_t>(out)};
+                    ok = protocol::writeAll(fd, shape, sizeof(shape));
+                }
+                else if (count == protocol::statsRequest)
+                {
+                    std::ostringstream text;
+                    batcher.stats().print(text);
+                    ok = protocol::writeText(fd, text.str());
+                }
+                else if (count == 0 || count > protocol::maxFloats || count % in != 0)
+                {
+                    // The payload cannot be skipped reliably, so the connection ends here
+                    protocol::writeAll(fd, &protocol::errorReply, sizeof(uint32_t));
+                    protocol::writeText(fd, "Request must hold whole rows of " + std::to_string(in) + " inputs");
+                    break;
+                }
+                else
+                {
+                    inputs.resize(count);
+                    outputs.resize(count / in * out);
+                    if (!protocol::readAll(fd, inputs.data(), count * sizeof(float)))
+                        break;
+
+                    try
+                    {
+                        batcher.predict(inputs, outputs);
+                        uint32_t replyCount = static_cast<uint32_t>(outputs.size());
+                        ok = protocol::writeAll(fd, &replyCount, sizeof(replyCount)) &&
+                             protocol::writeAll(fd, outputs.data(), outputs.size() * sizeof(float));
+                    }
+                    catch (const std::exception &e)
+                    {
+                        ok = protocol::writeAll(fd, &protocol::errorReply, sizeof(uint32_t)) && protocol::writeText(fd, e.what());
+                    }
+                }
+
+                if (!ok)
+                    break;
+            }
+
+            std::lock_guard lock(mutex);
+            clients.erase(fd);
+            ::close(fd);
+            finished.push_back(std::this_thread::get_id());
+        }
+    };
+#endif
+
+} // namespace polann::serving
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <stdexcept>
 
 namespace polann::utils
 {
@@ -35,4 +37,60 @@ namespace polann::utils
         [[nodiscard]] static inline float derivative(float /*y*/) { return 1.0f; }
     };
 
+    /**
+     * @brief Runtime tag of the built-in activations
+     *
+     * Used where activations are chosen at runtime (DynamicDense, the JIT) and
+     * stored per layer in serialized models.
+     */
+    enum class ActivationKind : uint8_t
+    {
+        Identity,
+        ReLU,
+        Sigmoid,
+        Tanh,
+        Custom = 255 /// Any other activation type; cannot be selected at runtime
+    };
+
+    template <typename Activation>
+    inline constexpr ActivationKind activationKind = ActivationKind::Custom;
+
+    template <>
+    inline constexpr ActivationKind activationKind<Identity> = ActivationKind::Identity;
+
+    template <>
+    inline constexpr ActivationKind activationKind<ReLU> = ActivationKind::ReLU;
+
+    template <>
+    inline constexpr ActivationKind activationKind<Sigmoid> = ActivationKind::Sigmoid;
+
+    template <>
+    inline constexpr ActivationKind activationKind<Tanh> = ActivationKind::Tanh;
+
+    /**
+     * @brief Calls visitor.template operator()<Activation>() for a runtime kind
+     *
+     * Lets hot loops be written once as a template and dispatched per call
+     * rather than per element.
+     *
+     * @throws std::invalid_argument for ActivationKind::Custom or unknown values
+     */
+    template <typename Visitor>
+    decltype(auto) visitActivation(ActivationKind kind, Visitor &&visitor)
+    {
+        switch (kind)
+        {
+        case ActivationKind::Identity:
+            return visitor.template operator()<Identity>();
+        case ActivationKind::ReLU:
+            return visitor.template operator()<ReLU>();
+        case ActivationKind::Sigmoid:
+            return visitor.template operator()<Sigmoid>();
+        case ActivationKind::Tanh:
+            return visitor.template operator()<Tanh>();
+        default:
+            throw std::invalid_argument("Activation is not available at runtime");
+        }
+    }
+
 } // namespace polann::utils
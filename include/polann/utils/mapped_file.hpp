@@ -0,0 +1,144 @@
+#pragma once
+
+#include <span>
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <utility>
+#include <vector>
+#include <streambuf>
+#include <stdexcept>
+#include <filesystem>
+#include <system_error>
+#include "polann/config.h"
+
+#if defined(POLANN_PLATFORM_LINUX) || defined(POLANN_PLATFORM_MACOS)
+#define POLANN_HAS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace polann::utils
+{
+    /**
+     * @brief Read-only view of a whole file, memory-mapped where the platform allows
+     *
+     * Loading a model from the mapping parses it straight out of the page
+     * cache instead of copying it through a stream buffer first. Elsewhere the
+     * file is read into memory once.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @throws std::system_error if the file cannot be opened or mapped
+         */
+        explicit MappedFile(const std::filesystem::path &path)
+        {
+#ifdef POLANN_HAS_MMAP
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "Cannot open " + path.string());
+
+            struct stat info{};
+            if (::fstat(fd, &info) != 0)
+            {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot stat " + path.string());
+            }
+
+            length = static_cast<size_t>(info.st_size);
+            if (length > 0)
+            {
+                void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED)
+                {
+                    int error = errno;
+                    ::close(fd);
+                    throw std::system_error(error, std::generic_category(), "Cannot map " + path.string());
+                }
+                address = static_cast<const std::byte *>(mapped);
+                ::madvise(mapped, length, MADV_SEQUENTIAL);
+            }
+            ::close(fd); // The mapping keeps the file alive
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+                throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "Cannot open " + path.string());
+
+            copy.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char *>(copy.data()), static_cast<std::streamsize>(copy.size()));
+            address = copy.data();
+            length = copy.size();
+#endif
+        }
+
+        ~MappedFile()
+        {
+#ifdef POLANN_HAS_MMAP
+            if (address)
+                ::munmap(const_cast<std::byte *>(address), length);
+#endif
+        }
+
+        MappedFile(MappedFile &&other) noexcept
+            : address(std::exchange(other.address, nullptr)), length(std::exchange(other.length, 0)), copy(std::move(other.copy))
+        {
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile &operator=(MappedFile &&) = delete;
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return {address, length}; }
+
+    private:
+        const std::byte *address = nullptr;
+        size_t length = 0;
+        std::vector<std::byte> copy; /// Backing storage without mmap
+    };
+
+    /**
+     * @brief std::istream over bytes that stay owned by the caller
+     */
+    class MemoryStream : private std::streambuf, public std::istream
+    {
+    public:
+        explicit MemoryStream(std::span<const std::byte> bytes) : std::istream(static_cast<std::streambuf *>(this))
+        {
+            // The get area is only read from
+            char *begin = const_cast<char *>(reinterpret_cast<const char *>(bytes.data()));
+            setg(begin, begin, begin + bytes.size());
+        }
+
+    private:
+        using pos_type = std::streambuf::pos_type;
+        using off_type = std::streambuf::off_type;
+
+        // Seeking lets readers such as DynamicNN::load tell how many bytes are left
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+        {
+            if (!(which & std::ios_base::in))
+                return pos_type(off_type(-1));
+
+            off_type base = dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? gptr() - eback() : egptr() - eback();
+            return seekpos(pos_type(base + offset), which);
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+        {
+            off_type offset = position;
+            if (!(which & std::ios_base::in) || offset < 0 || offset > egptr() - eback())
+                return pos_type(off_type(-1));
+
+            setg(eback(), eback() + offset, egptr());
+            return position;
+        }
+    };
+
+} // namespace polann::utils
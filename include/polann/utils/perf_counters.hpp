@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "polann/config.h"
+
+#ifdef POLANN_PLATFORM_LINUX
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace polann::utils
+{
+    /**
+     * @brief Hardware events sampled by PerfCounters
+     */
+    enum class PerfEvent : size_t
+    {
+        Cycles,
+        Instructions,
+        Branches,
+        BranchMisses,
+        L1DAccesses,
+        L1DMisses,
+        LLCReferences,
+        LLCMisses,
+        Count
+    };
+
+    inline constexpr size_t perfEventCount = static_cast<size_t>(PerfEvent::Count);
+
+    inline constexpr std::array<std::string_view, perfEventCount> perfEventNames = {
+        "cycles", "instructions", "branches", "branch_misses",
+        "l1d_accesses", "l1d_misses", "llc_references", "llc_misses"};
+
+    /**
+     * @brief Counter values between PerfCounters::start() and stop()
+     *
+     * Values are scaled for multiplexing. Events the kernel refused to open are
+     * marked invalid and read as zero.
+     */
+    struct PerfSample
+    {
+        std::array<double, perfEventCount> values{};
+        std::array<bool, perfEventCount> valid{};
+
+        [[nodiscard]] double operator[](PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+        [[nodiscard]] bool has(PerfEvent event) const { return valid[static_cast<size_t>(event)]; }
+
+        [[nodiscard]] double ipc() const { return ratio(PerfEvent::Instructions, PerfEvent::Cycles); }
+        [[nodiscard]] double branchMissRate() const { return ratio(PerfEvent::BranchMisses, PerfEvent::Branches); }
+        [[nodiscard]] double l1dMissRate() const { return ratio(PerfEvent::L1DMisses, PerfEvent::L1DAccesses); }
+        [[nodiscard]] double llcMissRate() const { return ratio(PerfEvent::LLCMisses, PerfEvent::LLCReferences); }
+
+    private:
+        [[nodiscard]] double ratio(PerfEvent num, PerfEvent den) const
+        {
+            return has(num) && has(den) && (*this)[den] > 0.0 ? (*this)[num] / (*this)[den] : 0.0;
+        }
+    };
+
+    /**
+     * @brief Hardware performance counters via perf_event_open (Linux only)
+     *
+     * Counts user-space events of the constructing thread and of threads it
+     * creates afterwards (perf inherit). Threads that already exist, such as
+     * the workers of a ThreadPool built earlier, are not counted; construct
+     * the counters before the pool to include its work. Each event is opened on
+     * its own so a missing event (common in VMs) does not disable the others.
+     * On other platforms, or when perf_event_paranoid forbids access,
+     * available() returns false and samples are empty.
+     */
+    class PerfCounters
+    {
+    public:
+        PerfCounters()
+        {
+            fds.fill(-1);
+#ifdef POLANN_PLATFORM_LINUX
+            constexpr auto cache = [](uint64_t level, uint64_t result)
+            {
+                return level | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+            };
+
+            const std::array<std::pair<uint32_t, uint64_t>, perfEventCount> configs = {{
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+                {PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            }};
+
+            for (size_t i = 0; i < perfEventCount; ++i)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = configs[i].first;
+                attr.config = configs[i].second;
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.inherit = 1; // Follow threads spawned after opening (e.g. a new ThreadPool)
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#ifdef POLANN_PLATFORM_LINUX
+            for (int fd : fds)
+                if (fd >= 0)
+                    close(fd);
+#endif
+        }
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        /**
+         * @brief Whether at least cycles and instructions can be counted
+         */
+        [[nodiscard]] bool available() const
+        {
+            return fds[static_cast<size_t>(PerfEvent::Cycles)] >= 0 && fds[static_cast<size_t>(PerfEvent::Instructions)] >= 0;
+        }
+
+        /**
+         * @brief Reset and enable all open counters
+         */
+        void start()
+        {
+#ifdef POLANN_PLATFORM_LINUX
+            for (int fd : fds)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            for (int fd : fds)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+        }
+
+        /**
+         * @brief Disable all counters and return their values since start()
+         */
+        PerfSample stop()
+        {
+            PerfSample sample;
+#ifdef POLANN_PLATFORM_LINUX
+            for (int fd : fds)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            for (size_t i = 0; i < perfEventCount; ++i)
+            {
+                uint64_t data[3] = {}; // value, time enabled, time running
+                if (fds[i] < 0 || read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0)
+                    continue;
+
+                // Scale up when the kernel multiplexed this event
+                sample.values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+                sample.valid[i] = true;
+            }
+#endif
+            return sample;
+        }
+
+    private:
+        std::array<int, perfEventCount> fds;
+    };
+
+} // namespace polann::utils
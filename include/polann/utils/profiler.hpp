@@ -0,0 +1,296 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include "polann/config.h"
+#include "polann/utils/trace.hpp"
+
+namespace polann::utils
+{
+    /**
+     * @brief Accumulated timing of one instrumented section
+     */
+    struct TimingStats
+    {
+        uint64_t calls = 0;
+        double totalNs = 0.0;
+        uint64_t flops = 0; /// Total floating point operations over all calls
+        uint64_t bytes = 0; /// Total bytes touched over all calls
+
+        [[nodiscard]] double averageNs() const { return calls ? totalNs / calls : 0.0; }
+        [[nodiscard]] double gflops() const { return totalNs > 0.0 ? flops / totalNs : 0.0; }
+        [[nodiscard]] double gbytesPerSecond() const { return totalNs > 0.0 ? bytes / totalNs : 0.0; }
+    };
+
+    struct LayerProfile
+    {
+        TimingStats forward;
+        TimingStats backward;
+    };
+
+    /**
+     * @brief Snapshot of the instrumentation counters of a network
+     */
+    struct Profile
+    {
+        std::vector<LayerProfile> layers; /// Indexed like the network's layers
+        TimingStats getBatch;             /// Batch assembly in fit/evaluate
+        TimingStats loss;                 /// Loss value and gradient computation
+        TimingStats optimizerStep;        /// optimizer.step over all layers
+
+        /**
+         * @brief Print a table with one row per section and its share of the total
+         */
+        void print(std::ostream &os) const
+        {
+            double total = getBatch.totalNs + loss.totalNs + optimizerStep.totalNs;
+            for (const auto &layer : layers)
+                total += layer.forward.totalNs + layer.backward.totalNs;
+
+            // Leave the caller's formatting as it was
+            std::ios_base::fmtflags flags = os.flags();
+            std::streamsize precision = os.precision();
+
+            os << std::left << std::setw(20) << "section"
+               << std::right << std::setw(12) << "calls"
+               << std::setw(14) << "total ms"
+               << std::setw(12) << "avg us"
+               << std::setw(10) << "GFLOP/s"
+               << std::setw(10) << "GB/s"
+               << std::setw(9) << "share" << "\n";
+
+            auto row = [&](const std::string &name, const TimingStats &stats)
+            {
+                os << std::left << std::setw(20) << name
+                   << std::right << std::setw(12) << stats.calls
+                   << std::fixed << std::setprecision(3)
+                   << std::setw(14) << stats.totalNs / 1e6
+                   << std::setw(12) << stats.averageNs() / 1e3
+                   << std::setprecision(2)
+                   << std::setw(10) << stats.gflops()
+                   << std::setw(10) << stats.gbytesPerSecond()
+                   << std::setw(8) << (total > 0.0 ? 100.0 * stats.totalNs / total : 0.0) << "%\n";
+            };
+
+            for (size_t i = 0; i < layers.size(); ++i)
+            {
+                row("layer" + std::to_string(i) + ".forward", layers[i].forward);
+                row("layer" + std::to_string(i) + ".backward", layers[i].backward);
+            }
+            row("getBatch", getBatch);
+            row("loss", loss);
+            row("optimizer.step", optimizerStep);
+
+            os.flags(flags);
+            os.precision(precision);
+        }
+    };
+
+    /**
+     * @brief Instrumented section of a training or inference run
+     */
+    enum class Section
+    {
+        Forward,
+        Backward,
+        GetBatch,
+        Loss,
+        OptimizerStep,
+        Epoch,
+        Batch,
+        Evaluate
+    };
+
+    /**
+     * @brief Thread-safe section timer used when POLANN_ENABLE_PROFILING is defined
+     *
+     * Optionally forwards every timed section to a TraceRecorder as a span.
+     *
+     * @tparam LayerCount Number of layers in the instrumented network
+     */
+    template <size_t LayerCount>
+    class Profiler
+    {
+        struct Counters
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> ns{0};
+            std::atomic<uint64_t> flops{0};
+            std::atomic<uint64_t> bytes{0};
+
+            Counters() = default;
+            Counters(const Counters &other) { *this = other; }
+
+            Counters &operator=(const Counters &other)
+            {
+                calls = other.calls.load();
+                ns = other.ns.load();
+                flops = other.flops.load();
+                bytes = other.bytes.load();
+                return *this;
+            }
+
+            TimingStats stats() const
+            {
+                return {calls.load(), static_cast<double>(ns.load()), flops.load(), bytes.load()};
+            }
+        };
+
+    public:
+        /**
+         * @brief RAII timer adding its lifetime to a section on destruction
+         */
+        class Scope
+        {
+        public:
+            Scope(Counters *counters, TraceRecorder *trace, Section section, size_t index, uint64_t flops, uint64_t bytes)
+                : counters(counters), trace(trace), section(section), index(index), flops(flops), bytes(bytes),
+                  start(TraceRecorder::Clock::now()) {}
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+            ~Scope()
+            {
+                auto end = TraceRecorder::Clock::now();
+                if (counters)
+                {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+                    counters->calls.fetch_add(1, std::memory_order_relaxed);
+                    counters->ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+                    counters->flops.fetch_add(flops, std::memory_order_relaxed);
+                    counters->bytes.fetch_add(bytes, std::memory_order_relaxed);
+                }
+
+                if (trace)
+                    traceSpan(end);
+            }
+
+        private:
+            Counters *counters;
+            TraceRecorder *trace;
+            Section section;
+            size_t index;
+            uint64_t flops;
+            uint64_t bytes;
+            TraceRecorder::Clock::time_point start;
+
+            void traceSpan(TraceRecorder::Clock::time_point end)
+            {
+                switch (section)
+                {
+                case Section::Forward:
+                    trace->record("layer", index, ".forward", "layer", start, end);
+                    break;
+                case Section::Backward:
+                    trace->record("layer", index, ".backward", "layer", start, end);
+                    break;
+                case Section::GetBatch:
+                    trace->record("getBatch", "data", start, end);
+                    break;
+                case Section::Loss:
+                    trace->record("loss", "loss", start, end);
+                    break;
+                case Section::OptimizerStep:
+                    trace->record("optimizer.step", "optimizer", start, end);
+                    break;
+                case Section::Epoch:
+                    trace->record("epoch ", index, {}, "train", start, end);
+                    break;
+                case Section::Batch:
+                    trace->record("batch ", index, {}, "train", start, end);
+                    break;
+                case Section::Evaluate:
+                    trace->record("evaluate", "eval", start, end);
+                    break;
+                }
+            }
+        };
+
+        [[nodiscard]] Scope forward(size_t layer, uint64_t flops, uint64_t bytes) { return Scope(&forwardCounters[layer], trace, Section::Forward, layer, flops, bytes); }
+        [[nodiscard]] Scope backward(size_t layer, uint64_t flops, uint64_t bytes) { return Scope(&backwardCounters[layer], trace, Section::Backward, layer, flops, bytes); }
+        [[nodiscard]] Scope getBatch() { return Scope(&getBatchCounters, trace, Section::GetBatch, 0, 0, 0); }
+        [[nodiscard]] Scope loss() { return Scope(&lossCounters, trace, Section::Loss, 0, 0, 0); }
+        [[nodiscard]] Scope optimizerStep() { return Scope(&stepCounters, trace, Section::OptimizerStep, 0, 0, 0); }
+
+        // Trace-only spans; they nest the sections above and have no counters
+        [[nodiscard]] Scope epoch(size_t index) { return Scope(nullptr, trace, Section::Epoch, index, 0, 0); }
+        [[nodiscard]] Scope batch(size_t index) { return Scope(nullptr, trace, Section::Batch, index, 0, 0); }
+        [[nodiscard]] Scope evaluate() { return Scope(nullptr, trace, Section::Evaluate, 0, 0, 0); }
+
+        /**
+         * @brief Forward spans to a recorder (nullptr stops tracing)
+         */
+        void setTrace(TraceRecorder *recorder) { trace = recorder; }
+
+        [[nodiscard]] Profile snapshot() const
+        {
+            Profile profile;
+            profile.layers.resize(LayerCount);
+            for (size_t i = 0; i < LayerCount; ++i)
+            {
+                profile.layers[i].forward = forwardCounters[i].stats();
+                profile.layers[i].backward = backwardCounters[i].stats();
+            }
+            profile.getBatch = getBatchCounters.stats();
+            profile.loss = lossCounters.stats();
+            profile.optimizerStep = stepCounters.stats();
+            return profile;
+        }
+
+        void reset()
+        {
+            TraceRecorder *recorder = trace;
+            *this = Profiler();
+            trace = recorder;
+        }
+
+    private:
+        std::array<Counters, LayerCount> forwardCounters;
+        std::array<Counters, LayerCount> backwardCounters;
+        Counters getBatchCounters;
+        Counters lossCounters;
+        Counters stepCounters;
+        TraceRecorder *trace = nullptr;
+    };
+
+    /**
+     * @brief No-op stand-in for Profiler; every call compiles away
+     */
+    template <size_t LayerCount>
+    class NullProfiler
+    {
+    public:
+        struct Scope
+        {
+        };
+
+        [[nodiscard]] static Scope forward(size_t, uint64_t, uint64_t) { return {}; }
+        [[nodiscard]] static Scope backward(size_t, uint64_t, uint64_t) { return {}; }
+        [[nodiscard]] static Scope getBatch() { return {}; }
+        [[nodiscard]] static Scope loss() { return {}; }
+        [[nodiscard]] static Scope optimizerStep() { return {}; }
+        [[nodiscard]] static Scope epoch(size_t) { return {}; }
+        [[nodiscard]] static Scope batch(size_t) { return {}; }
+        [[nodiscard]] static Scope evaluate() { return {}; }
+
+        static void setTrace(TraceRecorder *) {}
+        [[nodiscard]] static Profile snapshot() { return {}; }
+        static void reset() {}
+    };
+
+#ifdef POLANN_ENABLE_PROFILING
+    template <size_t LayerCount>
+    using DefaultProfiler = Profiler<LayerCount>;
+#else
+    template <size_t LayerCount>
+    using DefaultProfiler = NullProfiler<LayerCount>;
+#endif
+
+} // namespace polann::utils
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+
+namespace polann::utils
+{
+    /**
+     * @brief Collects timed spans and writes them in Chrome trace event format
+     *
+     * Each recording thread appends to its own buffer, so concurrent spans from
+     * worker threads do not contend. The output loads in chrome://tracing and
+     * Perfetto (ui.perfetto.dev). Call write() after the traced work finished.
+     */
+    class TraceRecorder
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        TraceRecorder() : id(nextId()), origin(Clock::now()) {}
+
+        TraceRecorder(const TraceRecorder &) = delete;
+        TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+        /**
+         * @brief Record a completed span on the calling thread
+         *
+         * Names are not copied, so they must outlive write(); string literals
+         * are the intended use. Numbered spans store the number and only
+         * format "<prefix><index><suffix>" in write(), keeping the hot path
+         * free of allocations beyond the buffer's own growth.
+         *
+         * @param name Span label shown in the viewer
+         * @param category Comma-separated categories used for filtering
+         * @param start Span start
+         * @param end Span end
+         */
+        void record(std::string_view name, std::string_view category, Clock::time_point start, Clock::time_point end)
+        {
+            record(name, noIndex, {}, category, start, end);
+        }
+
+        /**
+         * @brief Record a numbered span, e.g. "layer" 2 ".forward" or "epoch " 5 ""
+         */
+        void record(std::string_view prefix, size_t index, std::string_view suffix, std::string_view category,
+                    Clock::time_point start, Clock::time_point end)
+        {
+            ThreadBuffer &buffer = localBuffer();
+            std::lock_guard lock(buffer.mutex); // Uncontended unless write() or clear() runs
+            buffer.events.push_back({prefix, suffix, index, category,
+                                     std::chrono::duration<double, std::micro>(start - origin).count(),
+                                     std::chrono::duration<double, std::micro>(end - start).count()});
+        }
+
+        /**
+         * @brief Drop all recorded events, keeping thread assignments
+         */
+        void clear()
+        {
+            std::lock_guard lock(mutex);
+            for (auto &buffer : buffers)
+            {
+                std::lock_guard bufferLock(buffer->mutex);
+                buffer->events.clear();
+            }
+        }
+
+        /**
+         * @brief Write all events as a Chrome JSON trace
+         */
+        void write(std::ostream &os) const
+        {
+            std::lock_guard lock(mutex);
+
+            std::ios_base::fmtflags flags = os.flags();
+            std::streamsize precision = os.precision();
+            os << std::fixed << std::setprecision(3);
+            os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+            bool first = true;
+            auto separator = [&]() -> std::ostream &
+            {
+                os << (first ? "\n" : ",\n");
+                first = false;
+                return os;
+            };
+
+            for (const auto &buffer : buffers)
+            {
+                separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+                            << ", \"args\": {\"name\": \"" << (buffer->tid == 0 ? "main" : "worker " + std::to_string(buffer->tid)) << "\"}}";
+
+                std::lock_guard bufferLock(buffer->mutex);
+                for (const auto &event : buffer->events)
+                {
+                    separator() << "{\"name\": \"" << event.prefix;
+                    if (event.index != noIndex)
+                        os << event.index << event.suffix;
+                    os << "\", \"cat\": \"" << event.category
+                                << "\", \"ph\": \"X\", \"ts\": " << event.ts << ", \"dur\": " << event.dur
+                                << ", \"pid\": 1, \"tid\": " << buffer->tid << "}";
+                }
+            }
+
+            os << "\n]}\n";
+            os.flags(flags);
+            os.precision(precision);
+        }
+
+        void write(const std::filesystem::path &path) const
+        {
+            std::ofstream file(path);
+            if (!file)
+                throw std::runtime_error("Cannot open " + path.string() + " for writing");
+            write(file);
+        }
+
+    private:
+        static constexpr size_t noIndex = static_cast<size_t>(-1);
+
+        struct Event
+        {
+            std::string_view prefix;
+            std::string_view suffix;
+            size_t index; /// noIndex for plain names
+            std::string_view category;
+            double ts;  /// Microseconds since recorder creation
+            double dur; /// Microseconds
+        };
+
+        struct ThreadBuffer
+        {
+            std::thread::id owner;
+            uint32_t tid; /// Dense id in order of first use (0 = first thread)
+            std::mutex mutex; /// Guards events against write() and clear() from other threads
+            std::vector<Event> events;
+        };
+
+        uint64_t id; /// Distinguishes recorders in the thread-local cache
+        Clock::time_point origin;
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+        static uint64_t nextId()
+        {
+            static std::atomic<uint64_t> counter{1};
+            return counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ThreadBuffer &localBuffer()
+        {
+            thread_local uint64_t cachedId = 0;
+            thread_local ThreadBuffer *cached = nullptr;
+            if (cachedId == id)
+                return *cached;
+
+            std::lock_guard lock(mutex);
+            auto self = std::this_thread::get_id();
+
+            cached = nullptr;
+            for (auto &buffer : buffers)
+                if (buffer->owner == self)
+                    cached = buffer.get();
+
+            if (!cached)
+            {
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->owner = self;
+                buffer->tid = static_cast<uint32_t>(buffers.size());
+                cached = buffer.get();
+                buffers.push_back(std::move(buffer));
+            }
+
+            cachedId = id;
+            return *cached;
+        }
+    };
+
+} // namespace polann::utils
@@ -0,0 +1,128 @@
+#include "polann/c_api.h"
+
+#include <new>
+#include <span>
+#include <limits>
+#include <memory>
+#include <string>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/utils/mapped_file.hpp"
+
+struct polann_model
+{
+    polann::models::DynamicNN network;
+};
+
+namespace
+{
+    thread_local std::string lastError;
+
+    polann_status fail(polann_status status, const char *message)
+    {
+        lastError = message;
+        return status;
+    }
+
+    // Exceptions must not cross the C boundary
+    template <typename F>
+    polann_status guarded(polann_status parseError, F &&body)
+    {
+        try
+        {
+            body();
+            lastError.clear();
+            return POLANN_OK;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return fail(POLANN_ERROR_OUT_OF_MEMORY, "Out of memory");
+        }
+        catch (const std::system_error &e)
+        {
+            return fail(POLANN_ERROR_IO, e.what());
+        }
+        catch (const std::invalid_argument &e)
+        {
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, e.what());
+        }
+        catch (const std::exception &e)
+        {
+            return fail(parseError, e.what());
+        }
+        catch (...)
+        {
+            return fail(POLANN_ERROR_INTERNAL, "Unknown error");
+        }
+    }
+
+    polann_status loadModel(std::span<const std::byte> bytes, polann_model **model)
+    {
+        return guarded(POLANN_ERROR_FORMAT, [&]
+        {
+            auto loaded = std::make_unique<polann_model>();
+            polann::utils::MemoryStream stream(bytes);
+            loaded->network.load(stream);
+            loaded->network.finalizeForInference();
+            *model = loaded.release();
+        });
+    }
+
+} // namespace
+
+extern "C"
+{
+    int polann_abi_version(void) { return POLANN_C_ABI_VERSION; }
+
+    const char *polann_version(void) { return POLANN_VERSION; }
+
+    polann_status polann_model_load(const char *path, polann_model **model)
+    {
+        if (!path || !model)
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, "path and model must not be null");
+        *model = nullptr;
+
+        std::optional<polann::utils::MappedFile> file;
+        polann_status status = guarded(POLANN_ERROR_IO, [&] { file.emplace(path); });
+        return status == POLANN_OK ? loadModel(file->bytes(), model) : status;
+    }
+
+    polann_status polann_model_load_memory(const void *data, size_t size, polann_model **model)
+    {
+        if (!data || !model)
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, "data and model must not be null");
+        *model = nullptr;
+
+        return loadModel({static_cast<const std::byte *>(data), size}, model);
+    }
+
+    void polann_model_free(polann_model *model) { delete model; }
+
+    size_t polann_model_input_size(const polann_model *model) { return model ? model->network.inputSize() : 0; }
+
+    size_t polann_model_output_size(const polann_model *model) { return model ? model->network.outputSize() : 0; }
+
+    polann_status polann_predict_batch(const polann_model *model, const float *inputs, size_t rows, float *outputs)
+    {
+        if (!model)
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, "model must not be null");
+        if (rows == 0)
+            return POLANN_OK;
+        if (!inputs || !outputs)
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, "inputs and outputs must not be null");
+
+        const auto &network = model->network;
+        constexpr size_t maxCount = (std::numeric_limits<size_t>::max)();
+        if (rows > maxCount / network.inputSize() || rows > maxCount / network.outputSize())
+            return fail(POLANN_ERROR_INVALID_ARGUMENT, "rows is too large for the model's input or output size");
+
+        return guarded(POLANN_ERROR_INTERNAL, [&]
+        {
+            network.predictBatch({inputs, rows * network.inputSize()}, {outputs, rows * network.outputSize()});
+        });
+    }
+
+    const char *polann_last_error(void) { return lastError.c_str(); }
+}
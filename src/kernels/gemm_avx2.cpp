@@ -0,0 +1,11 @@
+// AVX2 and FMA kernels whatever the rest of the library targets; only the
+// kernel functions are compiled for them (see gemm_impl.hpp)
+#define POLANN_GEMM_TARGET avx2
+#define POLANN_GEMM_AVX2
+#include "polann/kernels/gemm_impl.hpp"
+#include "kernels/kernel_table.hpp"
+
+namespace polann::kernels::gemm::avx2
+{
+    extern const KernelTable table{"avx2", &sgemmBlocked, &packMatrix, &sgemmPacked};
+}
@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <string_view>
+#include "polann/kernels/gemm.hpp"
+#include "kernels/kernel_table.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace polann::kernels
+{
+    namespace
+    {
+        // CPU and OS both support AVX2 and FMA (the OS must save the ymm registers)
+        [[maybe_unused]] bool cpuSupportsAvx2()
+        {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            __cpuid(info, 1);
+            bool fma = info[2] & (1 << 12);
+            bool osxsave = info[2] & (1 << 27);
+            __cpuidex(info, 7, 0);
+            bool avx2 = info[1] & (1 << 5);
+            return fma && avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            return false;
+#endif
+        }
+
+        const gemm::KernelTable &select()
+        {
+            // POLANN_KERNELS=generic forces the portable kernels, e.g. to compare against them
+            const char *forced = std::getenv("POLANN_KERNELS");
+            [[maybe_unused]] bool generic = forced && std::string_view(forced) == "generic";
+
+#ifdef POLANN_GEMM_HAVE_AVX2
+            if (!generic && cpuSupportsAvx2())
+                return gemm::avx2::table;
+#endif
+            return gemm::generic::table;
+        }
+
+        const gemm::KernelTable &active()
+        {
+            static const gemm::KernelTable &table = select();
+            return table;
+        }
+
+    } // namespace
+
+    void gemm::sgemmBlocked(size_t m, size_t n, size_t k, float alpha,
+                            const float *a, size_t aRowStride, size_t aColStride,
+                            const float *b, size_t bRowStride, size_t bColStride,
+                            float beta, float *c, size_t ldc)
+    {
+        active().sgemmBlocked(m, n, k, alpha, a, aRowStride, aColStride, b, bRowStride, bColStride, beta, c, ldc);
+    }
+
+    PackedMatrix packMatrix(Transpose transB, size_t k, size_t n, const float *b, size_t ldb)
+    {
+        return active().packMatrix(transB, k, n, b, ldb);
+    }
+
+    void sgemmPacked(size_t m, float alpha, const float *a, size_t lda, const PackedMatrix &b,
+                     float beta, float *c, size_t ldc)
+    {
+        active().sgemmPacked(m, alpha, a, lda, b, beta, c, ldc);
+    }
+
+    const char *kernelVariant() { return active().name; }
+
+} // namespace polann::kernels
@@ -0,0 +1,9 @@
+// Compiled for the baseline instruction set of the target (see src/CMakeLists.txt)
+#define POLANN_GEMM_TARGET generic
+#include "polann/kernels/gemm_impl.hpp"
+#include "kernels/kernel_table.hpp"
+
+namespace polann::kernels::gemm::generic
+{
+    extern const KernelTable table{"generic", &sgemmBlocked, &packMatrix, &sgemmPacked};
+}
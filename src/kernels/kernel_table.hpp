@@ -0,0 +1,28 @@
+#pragma once
+
+#include "polann/kernels/gemm.hpp"
+
+namespace polann::kernels::gemm
+{
+    /**
+     * @brief Entry points of one compiled copy of gemm_impl.hpp
+     */
+    struct KernelTable
+    {
+        const char *name;
+        decltype(&gemm::sgemmBlocked) sgemmBlocked;
+        decltype(&kernels::packMatrix) packMatrix;
+        decltype(&kernels::sgemmPacked) sgemmPacked;
+    };
+
+    namespace generic
+    {
+        extern const KernelTable table; /// Baseline instruction set, always present
+    }
+
+    namespace avx2
+    {
+        extern const KernelTable table; /// Only linked in with POLANN_GEMM_HAVE_AVX2
+    }
+
+} // namespace polann::kernels::gemm
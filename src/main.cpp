@@ -1 +0,0 @@
-// Placeholder to make library build
\ No newline at end of file
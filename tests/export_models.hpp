@@ -0,0 +1,51 @@
+#pragma once
+
+#include "polann/core/normalizer.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/header_export.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+// Networks shared by generate_export_headers.cpp, which exports them at build time, and test_header_export.cpp
+namespace polann::tests
+{
+    /// Small enough to be fully unrolled, no normalizer
+    using UnrolledModel = models::NN<layers::Dense<utils::ReLU, 3, 4>, layers::Dense<utils::Sigmoid, 4, 2>>;
+
+    /// A loop layer (320 weights) followed by an unrolled one (120 weights) under mixedUnrollLimit, with a normalizer
+    using MixedModel = models::NN<layers::Dense<utils::Tanh, 8, 40>, layers::Dense<utils::Identity, 40, 3>>;
+    inline constexpr size_t mixedUnrollLimit = 200;
+
+    /// Only constexpr activations, so the exported predict is constexpr
+    using ConstexprModel = models::NN<layers::Dense<utils::ReLU, 2, 3>, layers::Dense<utils::Identity, 3, 1>>;
+
+    inline UnrolledModel makeUnrolledModel()
+    {
+        UnrolledModel model{layers::Dense<utils::ReLU, 3, 4>(), layers::Dense<utils::Sigmoid, 4, 2>()};
+        model.initialize(11);
+        return model;
+    }
+
+    inline MixedModel makeMixedModel()
+    {
+        MixedModel model{layers::Dense<utils::Tanh, 8, 40>(), layers::Dense<utils::Identity, 40, 3>()};
+        model.initialize(12);
+
+        core::Normalizer<8> normalizer;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            normalizer.shift[i] = 0.1f * static_cast<float>(i) - 0.3f;
+            normalizer.scale[i] = 1.0f + 0.25f * static_cast<float>(i);
+        }
+        model.setNormalizer(normalizer);
+        return model;
+    }
+
+    inline ConstexprModel makeConstexprModel()
+    {
+        ConstexprModel model{layers::Dense<utils::ReLU, 2, 3>(), layers::Dense<utils::Identity, 3, 1>()};
+        model.initialize(13);
+        return model;
+    }
+
+} // namespace polann::tests
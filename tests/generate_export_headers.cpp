@@ -0,0 +1,32 @@
+#include <iostream>
+#include <exception>
+#include <filesystem>
+#include "export_models.hpp"
+
+// Writes the headers test_header_export.cpp compiles; the argument is the output directory
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: generate_export_headers <directory>\n";
+        return 1;
+    }
+
+    try
+    {
+        std::filesystem::path directory = argv[1];
+        std::filesystem::create_directories(directory);
+
+        using namespace polann;
+        models::exportHeader(tests::makeUnrolledModel(), directory / "unrolled_model.hpp", {.namespaceName = "exported::unrolled"});
+        models::exportHeader(tests::makeMixedModel(), directory / "mixed_model.hpp",
+                             {.namespaceName = "exported::mixed", .unrollLimit = tests::mixedUnrollLimit});
+        models::exportHeader(tests::makeConstexprModel(), directory / "constexpr_model.hpp", {.namespaceName = "exported::constant"});
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <string_view>
+
+namespace polann::tests
+{
+    /**
+     * @brief One registered test case
+     */
+    struct TestCase
+    {
+        const char *name;
+        void (*body)();
+    };
+
+    /**
+     * @brief All test cases of the executable, in registration order
+     */
+    inline std::vector<TestCase> &registry()
+    {
+        static std::vector<TestCase> cases;
+        return cases;
+    }
+
+    /**
+     * @brief Failed checks of the running test case
+     */
+    inline size_t &failedChecks()
+    {
+        static size_t count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Thrown by POLANN_REQUIRE to abandon the running test case
+     */
+    struct RequireFailed
+    {
+    };
+
+    struct Registrar
+    {
+        Registrar(const char *name, void (*body)()) { registry().push_back({name, body}); }
+    };
+
+    inline void reportFailure(const char *file, int line, std::string_view message)
+    {
+        ++failedChecks();
+        std::cerr << file << ":" << line << ": check failed: " << message << "\n";
+    }
+
+    /**
+     * @brief Whether |actual - expected| is within an absolute plus relative tolerance
+     */
+    inline bool near(double actual, double expected, double tolerance)
+    {
+        return std::abs(actual - expected) <= tolerance * (1.0 + std::abs(expected));
+    }
+
+    /**
+     * @brief Runs every test whose name contains filter
+     *
+     * @return Process exit code: 0 if all checks passed
+     */
+    int runAll(std::string_view filter);
+
+} // namespace polann::tests
+
+#define POLANN_TEST_CONCAT_IMPL(a, b) a##b
+#define POLANN_TEST_CONCAT(a, b) POLANN_TEST_CONCAT_IMPL(a, b)
+
+/// Defines and registers a test case; the body follows as a block
+#define POLANN_TEST(name)                                                                                      \
+    static void name();                                                                                        \
+    static const polann::tests::Registrar POLANN_TEST_CONCAT(name, Registrar)(#name, &name);                   \
+    static void name()
+
+/// Records a failure and continues the test case
+#define POLANN_CHECK(condition)                                                                                \
+    do                                                                                                         \
+    {                                                                                                          \
+        if (!(condition))                                                                                      \
+            polann::tests::reportFailure(__FILE__, __LINE__, #condition);                                      \
+    } while (false)
+
+/// Records a failure and ends the test case
+#define POLANN_REQUIRE(condition)                                                                              \
+    do                                                                                                         \
+    {                                                                                                          \
+        if (!(condition))                                                                                      \
+        {                                                                                                      \
+            polann::tests::reportFailure(__FILE__, __LINE__, #condition);                                      \
+            throw polann::tests::RequireFailed{};                                                              \
+        }                                                                                                      \
+    } while (false)
+
+/// Checks that two floating point values agree within a relative tolerance
+#define POLANN_CHECK_NEAR(actual, expected, tolerance)                                                         \
+    do                                                                                                         \
+    {                                                                                                          \
+        double polannActual = (actual);                                                                        \
+        double polannExpected = (expected);                                                                    \
+        if (!polann::tests::near(polannActual, polannExpected, (tolerance)))                                   \
+        {                                                                                                      \
+            std::ostringstream polannMessage;                                                                  \
+            polannMessage << #actual << " = " << polannActual << ", expected " << polannExpected;              \
+            polann::tests::reportFailure(__FILE__, __LINE__, polannMessage.str());                             \
+        }                                                                                                      \
+    } while (false)
+
+/// Checks that an expression throws the given exception type
+#define POLANN_CHECK_THROWS(expression, Exception)                                                             \
+    do                                                                                                         \
+    {                                                                                                          \
+        bool polannThrown = false;                                                                             \
+        try                                                                                                    \
+        {                                                                                                      \
+            (void)(expression);                                                                                \
+        }                                                                                                      \
+        catch (const Exception &)                                                                              \
+        {                                                                                                      \
+            polannThrown = true;                                                                               \
+        }                                                                                                      \
+        if (!polannThrown)                                                                                     \
+            polann::tests::reportFailure(__FILE__, __LINE__, #expression " does not throw " #Exception);       \
+    } while (false)
@@ -0,0 +1,4 @@
+#include "instantiation_model.hpp"
+
+POLANN_INSTANTIATE_NN(polann::layers::Dense<polann::utils::ReLU, 4, 8>, polann::layers::Dense<polann::utils::Sigmoid, 8, 2>);
+POLANN_INSTANTIATE_NN_TRAINING(polann::tests::InstantiatedModel, polann::tests::InstantiatedDataset, polann::optimizers::SGD, polann::loss::MSE);
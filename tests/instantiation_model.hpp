@@ -0,0 +1,19 @@
+#pragma once
+
+#include "polann/core/dataset.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/loss/mse.hpp"
+#include "polann/models/instantiation.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+// Network shared by test_instantiation.cpp and instantiation_model.cpp, declared as a user's model.hpp would
+namespace polann::tests
+{
+    using InstantiatedModel = models::NN<layers::Dense<utils::ReLU, 4, 8>, layers::Dense<utils::Sigmoid, 8, 2>>;
+    using InstantiatedDataset = core::Dataset<4, 2>;
+
+} // namespace polann::tests
+
+POLANN_EXTERN_NN(polann::layers::Dense<polann::utils::ReLU, 4, 8>, polann::layers::Dense<polann::utils::Sigmoid, 8, 2>);
+POLANN_EXTERN_NN_TRAINING(polann::tests::InstantiatedModel, polann::tests::InstantiatedDataset, polann::optimizers::SGD, polann::loss::MSE);
@@ -0,0 +1,45 @@
+#include "harness.hpp"
+
+#include <exception>
+
+namespace polann::tests
+{
+    int runAll(std::string_view filter)
+    {
+        size_t failedCases = 0;
+        size_t ran = 0;
+        for (const TestCase &test : registry())
+        {
+            if (!filter.empty() && std::string_view(test.name).find(filter) == std::string_view::npos)
+                continue;
+
+            ++ran;
+            failedChecks() = 0;
+            try
+            {
+                test.body();
+            }
+            catch (const RequireFailed &)
+            {
+            }
+            catch (const std::exception &e)
+            {
+                reportFailure(__FILE__, __LINE__, std::string("unexpected exception: ") + e.what());
+            }
+
+            bool passed = failedChecks() == 0;
+            failedCases += !passed;
+            std::cout << (passed ? "[ pass ] " : "[ FAIL ] ") << test.name << "\n";
+        }
+
+        std::cout << ran - failedCases << "/" << ran << " test cases passed\n";
+        return failedCases == 0 ? 0 : 1;
+    }
+
+} // namespace polann::tests
+
+int main(int argc, char **argv)
+{
+    // Optional argument: only run test cases whose name contains it
+    return polann::tests::runAll(argc > 1 ? argv[1] : "");
+}
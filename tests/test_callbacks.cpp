@@ -0,0 +1,203 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <string>
+#include <vector>
+#include <sstream>
+#include "polann/callbacks/callback.hpp"
+#include "polann/callbacks/progress_logger.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::Tanh, 2, 4>, layers::Dense<utils::Sigmoid, 4, 1>>;
+
+    Model makeModel()
+    {
+        Model model{layers::Dense<utils::Tanh, 2, 4>(), layers::Dense<utils::Sigmoid, 4, 1>()};
+        model.initialize(11);
+        return model;
+    }
+
+    core::Dataset<2, 1> makeDataset(size_t samples)
+    {
+        core::Dataset<2, 1> dataset;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            float x = static_cast<float>(i) / static_cast<float>(samples);
+            dataset.addSample(std::array<float, 2>{x, 1.0f - x}, std::array<float, 1>{x > 0.5f ? 1.0f : 0.0f});
+        }
+        return dataset;
+    }
+
+    enum class Hook
+    {
+        None,
+        EpochBegin,
+        BatchEnd,
+        EpochEnd
+    };
+
+    // Records every hook; returns Stop from stopHook once stopEpoch is reached
+    struct Recorder
+    {
+        std::vector<std::string> events;
+        std::vector<callbacks::BatchInfo> batches;
+        std::vector<callbacks::EpochInfo> epochBegins;
+        std::vector<callbacks::EpochInfo> epochEnds;
+        Hook stopHook = Hook::None;
+        size_t stopEpoch = 0;
+
+        callbacks::Action stopAt(Hook hook, size_t epoch) const
+        {
+            return hook == stopHook && epoch >= stopEpoch ? callbacks::Action::Stop : callbacks::Action::Continue;
+        }
+
+        void onTrainBegin(Model &) { events.push_back("trainBegin"); }
+
+        callbacks::Action onEpochBegin(Model &, const callbacks::EpochInfo &info)
+        {
+            events.push_back("epochBegin" + std::to_string(info.epoch));
+            epochBegins.push_back(info);
+            return stopAt(Hook::EpochBegin, info.epoch);
+        }
+
+        callbacks::Action onBatchEnd(Model &, const callbacks::BatchInfo &info)
+        {
+            events.push_back("batch" + std::to_string(info.epoch) + "." + std::to_string(info.batch));
+            batches.push_back(info);
+            return stopAt(Hook::BatchEnd, info.epoch);
+        }
+
+        callbacks::Action onEpochEnd(Model &, const callbacks::EpochInfo &info)
+        {
+            events.push_back("epochEnd" + std::to_string(info.epoch));
+            epochEnds.push_back(info);
+            return stopAt(Hook::EpochEnd, info.epoch);
+        }
+
+        void onTrainEnd(Model &) { events.push_back("trainEnd"); }
+    };
+
+    // Observes epoch ends only, returning void
+    struct EpochCounter
+    {
+        size_t epochs = 0;
+
+        void onEpochEnd(Model &, const callbacks::EpochInfo &) { ++epochs; }
+    };
+
+} // namespace
+
+POLANN_TEST(hooksRunInOrder)
+{
+    Model model = makeModel();
+    auto dataset = makeDataset(10);
+    optimizers::SGD optimizer(0.1f);
+    Recorder recorder;
+    EpochCounter counter;
+
+    model.fit(dataset, optimizer, 2, 4, false, false, recorder, counter);
+
+    std::vector<std::string> expected = {
+        "trainBegin",
+        "epochBegin0", "batch0.0", "batch0.1", "batch0.2", "epochEnd0",
+        "epochBegin1", "batch1.0", "batch1.1", "batch1.2", "epochEnd1",
+        "trainEnd"};
+    POLANN_CHECK(recorder.events == expected);
+    POLANN_CHECK(counter.epochs == 2);
+}
+
+POLANN_TEST(infoStructsDescribeTheRun)
+{
+    Model model = makeModel();
+    auto dataset = makeDataset(10);
+    optimizers::SGD optimizer(0.25f);
+    Recorder recorder;
+
+    model.fit(dataset, optimizer, 3, 4, true, false, recorder);
+
+    POLANN_REQUIRE(recorder.batches.size() == 9);
+    POLANN_REQUIRE(recorder.epochEnds.size() == 3);
+
+    for (size_t epoch = 0; epoch < 3; ++epoch)
+    {
+        const callbacks::EpochInfo &begin = recorder.epochBegins[epoch];
+        POLANN_CHECK(begin.epoch == epoch && begin.epochs == 3);
+        POLANN_CHECK(begin.learningRate == 0.25f);
+
+        // The epoch loss is the sample-weighted mean of its batch losses
+        double weighted = 0.0;
+        for (size_t b = 0; b < 3; ++b)
+        {
+            const callbacks::BatchInfo &batch = recorder.batches[epoch * 3 + b];
+            POLANN_CHECK(batch.epoch == epoch && batch.batch == b);
+            POLANN_CHECK(batch.batchSize == (b < 2 ? 4u : 2u));
+            POLANN_CHECK(std::isfinite(batch.loss) && batch.loss >= 0.0f);
+            POLANN_CHECK(batch.elapsedNs > 0.0 && batch.samplesPerSecond > 0.0);
+            POLANN_CHECK(batch.learningRate == 0.25f);
+            weighted += batch.loss * batch.batchSize;
+        }
+
+        const callbacks::EpochInfo &end = recorder.epochEnds[epoch];
+        POLANN_CHECK(end.epoch == epoch && end.epochs == 3);
+        POLANN_CHECK(end.samples == 10 && end.batches == 3);
+        POLANN_CHECK_NEAR(end.loss, weighted / 10.0, 1e-5);
+        POLANN_CHECK(end.elapsedNs > 0.0 && end.samplesPerSecond > 0.0);
+        POLANN_CHECK(end.learningRate == 0.25f);
+    }
+}
+
+POLANN_TEST(stopEndsTrainingAfterTheCurrentEpoch)
+{
+    for (Hook hook : {Hook::EpochBegin, Hook::BatchEnd, Hook::EpochEnd})
+    {
+        Model model = makeModel();
+        auto dataset = makeDataset(10);
+        optimizers::SGD optimizer(0.1f);
+        Recorder recorder;
+        recorder.stopHook = hook;
+        recorder.stopEpoch = 1;
+
+        model.fit(dataset, optimizer, 5, 4, false, false, recorder);
+
+        // Epoch 1 still runs all its batches, epoch 2 never begins
+        POLANN_CHECK(recorder.epochEnds.size() == 2);
+        POLANN_CHECK(recorder.batches.size() == 6);
+        POLANN_CHECK(recorder.events.back() == "trainEnd");
+        POLANN_CHECK(recorder.events[recorder.events.size() - 2] == "epochEnd1");
+    }
+}
+
+POLANN_TEST(progressLoggerPrintsEveryNthAndLastEpoch)
+{
+    auto run = [](size_t interval)
+    {
+        std::ostringstream os;
+        callbacks::ProgressLogger logger(os, interval);
+        Model model = makeModel();
+        auto dataset = makeDataset(8);
+        optimizers::SGD optimizer(0.1f);
+        model.fit(dataset, optimizer, 5, 4, false, false, logger);
+
+        std::vector<std::string> epochs;
+        std::istringstream lines(os.str());
+        for (std::string line; std::getline(lines, line);)
+            epochs.push_back(line.substr(0, line.find(',')));
+        return epochs;
+    };
+
+    POLANN_CHECK(run(2) == (std::vector<std::string>{"Epoch 0/5", "Epoch 2/5", "Epoch 4/5"}));
+    POLANN_CHECK(run(3) == (std::vector<std::string>{"Epoch 0/5", "Epoch 3/5", "Epoch 4/5"}));
+
+    // Interval 0 means only the last epoch
+    POLANN_CHECK(run(0) == (std::vector<std::string>{"Epoch 4/5"}));
+}
@@ -0,0 +1,308 @@
+#include "harness.hpp"
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <memory_resource>
+#include "polann/core/aligned_allocator.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/core/dataset_view.hpp"
+#include "polann/core/encoded_dataset.hpp"
+#include "polann/core/encoding.hpp"
+#include "polann/core/thread_pool.hpp"
+
+using namespace polann;
+
+namespace
+{
+    core::Dataset<2, 1> makeDataset(size_t samples)
+    {
+        core::Dataset<2, 1> dataset;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            float x = static_cast<float>(i);
+            dataset.addSample(std::array<float, 2>{x, -x}, std::array<float, 1>{0.5f * x});
+        }
+        return dataset;
+    }
+
+    std::vector<size_t> sorted(std::span<const size_t> indices)
+    {
+        std::vector<size_t> result(indices.begin(), indices.end());
+        std::ranges::sort(result);
+        return result;
+    }
+
+    // Whether the views partition [0, size) between them
+    bool partitions(std::initializer_list<std::span<const size_t>> views, size_t size)
+    {
+        std::vector<size_t> all;
+        for (auto view : views)
+            all.insert(all.end(), view.begin(), view.end());
+        std::vector<size_t> expected(size);
+        for (size_t i = 0; i < size; ++i)
+            expected[i] = i;
+        return sorted(all) == expected;
+    }
+
+    // Index-only source for split sizes past float precision without storing the rows
+    struct SizedSource
+    {
+        static constexpr size_t inputSize = 1;
+        static constexpr size_t outputSize = 1;
+        size_t count;
+
+        size_t size() const { return count; }
+    };
+
+    bool alignedTo(const void *ptr, size_t alignment)
+    {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    }
+
+    // Whether [ptr, ptr + bytes) lies inside the arena's buffer
+    bool insideArena(const std::vector<std::byte> &buffer, const void *ptr, size_t bytes)
+    {
+        auto begin = reinterpret_cast<uintptr_t>(buffer.data());
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        return address >= begin && address + bytes <= begin + buffer.size();
+    }
+}
+
+POLANN_TEST(allocatorsAlignEveryAllocation)
+{
+    core::AlignedAllocator<float> aligned;
+    core::AlignedAllocator<double, 128> wide;
+    for (size_t n : {1, 3, 17, 1000, 4097})
+    {
+        float *floats = aligned.allocate(n);
+        double *doubles = wide.allocate(n);
+        POLANN_CHECK(alignedTo(floats, core::cacheLineSize));
+        POLANN_CHECK(alignedTo(doubles, 128));
+        aligned.deallocate(floats, n);
+        wide.deallocate(doubles, n);
+    }
+
+    // Large huge-page allocations start on a huge page boundary
+    core::HugePageAllocator<float> huge;
+    size_t large = core::hugePageThreshold / sizeof(float);
+    float *pages = huge.allocate(large);
+    POLANN_CHECK(alignedTo(pages, core::hugePageSize));
+    huge.deallocate(pages, large);
+
+    // Odd-sized requests in between leave the arena misaligned for the next one
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::polymorphic_allocator<char> bytes(&arena);
+    core::pmr::AlignedPolymorphicAllocator<float> fromArena(&arena);
+    for (size_t n : {1, 3, 17, 1000})
+    {
+        (void)bytes.allocate(1);
+        float *floats = fromArena.allocate(n);
+        POLANN_CHECK(alignedTo(floats, core::cacheLineSize));
+        fromArena.deallocate(floats, n);
+    }
+}
+
+POLANN_TEST(datasetsShareOnePmrArena)
+{
+    // Without an upstream, anything not drawn from the buffer throws
+    std::vector<std::byte> buffer(1 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    core::pmr::Dataset<2, 1> first(&arena);
+    core::pmr::Dataset<3, 2> second(&arena);
+    for (size_t i = 0; i < 1500; ++i) // Past the first growth step
+    {
+        float x = static_cast<float>(i);
+        first.addSample(std::array<float, 2>{x, -x}, std::array<float, 1>{x});
+        second.addSample(std::array<float, 3>{x, x, x}, std::array<float, 2>{-x, -x});
+    }
+    first.getBatch(0, 64);
+    second.getBatch(1, 100);
+
+    auto check = [&](const auto &data, size_t elementSize)
+    {
+        POLANN_CHECK(alignedTo(data.data(), core::cacheLineSize));
+        POLANN_CHECK(insideArena(buffer, data.data(), data.size() * elementSize));
+    };
+    check(first.inputs, sizeof(float));
+    check(first.outputs, sizeof(float));
+    check(first.indices, sizeof(size_t));
+    check(first.batchInputBuffer, sizeof(float));
+    check(first.batchOutputBuffer, sizeof(float));
+    check(second.inputs, sizeof(float));
+    check(second.outputs, sizeof(float));
+    check(second.indices, sizeof(size_t));
+    check(second.batchInputBuffer, sizeof(float));
+    check(second.batchOutputBuffer, sizeof(float));
+
+    POLANN_CHECK(first.inputs.get_allocator().getResource() == &arena);
+    POLANN_CHECK(second.batchOutputBuffer.get_allocator().getResource() == &arena);
+    POLANN_CHECK(second.inputRow(1499)[2] == 1499.0f);
+}
+
+POLANN_TEST(chunkedAppendsGrowGeometrically)
+{
+    core::Dataset<4, 1> dataset;
+    std::vector<float> in(100 * 4, 1.0f);
+    std::vector<float> out(100, 0.5f);
+
+    // 1000 chunks of 100 rows; exact-fit reserves would reallocate on every call
+    size_t reallocations = 0;
+    const float *storage = dataset.inputs.data();
+    for (size_t chunk = 0; chunk < 1000; ++chunk)
+    {
+        dataset.addSamples(in, out);
+        reallocations += dataset.inputs.data() != storage;
+        storage = dataset.inputs.data();
+    }
+
+    POLANN_CHECK(dataset.size() == 100000);
+    POLANN_CHECK(reallocations <= 8);
+    POLANN_CHECK(dataset.indices.size() == 100000);
+    POLANN_CHECK(dataset.indices[99999] == 99999);
+}
+
+POLANN_TEST(parallelFillWritesUninitializedRows)
+{
+    core::ThreadPool pool(3);
+    core::Dataset<3, 2> dataset;
+    dataset.addSample(std::array<float, 3>{-1.0f, -2.0f, -3.0f}, std::array<float, 2>{-4.0f, -5.0f});
+
+    // Rows are not zeroed before the generator runs, so every value must come from it
+    dataset.addSamples(5000, [](size_t i, std::span<float, 3> in, std::span<float, 2> out)
+    {
+        float x = static_cast<float>(i);
+        in[0] = x, in[1] = x + 0.5f, in[2] = -x;
+        out[0] = 2.0f * x, out[1] = 1.0f;
+    }, pool);
+
+    POLANN_REQUIRE(dataset.size() == 5001);
+    POLANN_CHECK(dataset.inputs[0] == -1.0f && dataset.outputs[1] == -5.0f);
+    bool allWritten = true;
+    for (size_t i = 1; i < 5001; ++i)
+    {
+        float x = static_cast<float>(i);
+        allWritten &= dataset.inputs[i * 3] == x && dataset.inputs[i * 3 + 1] == x + 0.5f && dataset.inputs[i * 3 + 2] == -x;
+        allWritten &= dataset.outputs[i * 2] == 2.0f * x && dataset.outputs[i * 2 + 1] == 1.0f;
+    }
+    POLANN_CHECK(allWritten);
+
+    // A throwing generator leaves the dataset as it was
+    POLANN_CHECK_THROWS(dataset.addSamples(100, [](size_t i, std::span<float, 3>, std::span<float, 2>)
+    {
+        if (i == 5050)
+            throw std::runtime_error("generator failed");
+    }, pool), std::runtime_error);
+    POLANN_CHECK(dataset.size() == 5001);
+    POLANN_CHECK(dataset.inputs.size() == 5001 * 3);
+}
+
+POLANN_TEST(int8RequiresCalibratedCodec)
+{
+    std::array<float, 2> in{300.0f, -0.25f};
+    std::array<float, 1> out{1.0f};
+
+    // Default scales would clamp 300 to 127 without a word
+    using Int8Data = core::Int8Dataset<2, 1>;
+    Int8Data uncalibrated;
+    POLANN_CHECK_THROWS(uncalibrated.addSample(in, out), std::invalid_argument);
+    POLANN_CHECK_THROWS(uncalibrated.addSamples(in, out), std::invalid_argument);
+    POLANN_CHECK(uncalibrated.size() == 0);
+    core::encoding::Int8<2> defaultCodec;
+    POLANN_CHECK_THROWS(Int8Data{defaultCodec}, std::invalid_argument);
+
+    core::Dataset<2, 1> source;
+    source.addSample(in, out);
+    source.addSample(std::array<float, 2>{-100.0f, 0.75f}, out);
+
+    auto calibrated = Int8Data(core::encoding::Int8<2>::calibrate(source));
+    calibrated.addSample(in, out);
+    auto row = calibrated.inputRow(0);
+    POLANN_CHECK_NEAR(row[0], 300.0f, 1.0f);
+    POLANN_CHECK_NEAR(row[1], -0.25f, 0.01f);
+
+    // Float codecs need no calibration
+    core::Float16Dataset<2, 1> half;
+    half.addSample(in, out);
+    POLANN_CHECK_NEAR(half.inputRow(0)[0], 300.0f, 0.5f);
+}
+
+POLANN_TEST(splitIsDisjointAndCovering)
+{
+    auto dataset = makeDataset(101);
+    auto parts = core::split(dataset, 0.2f, 0.1f, 7);
+
+    POLANN_CHECK(parts.validation.size() == 20);
+    POLANN_CHECK(parts.test.size() == 10);
+    POLANN_CHECK(parts.train.size() == 71);
+    POLANN_CHECK(partitions({parts.train.sampleIndices(), parts.validation.sampleIndices(), parts.test.sampleIndices()}, 101));
+
+    // Views read through to the source rows
+    size_t sample = parts.validation.sampleIndices()[3];
+    POLANN_CHECK(parts.validation.inputRow(3)[0] == static_cast<float>(sample));
+    POLANN_CHECK(parts.validation.outputRow(3)[0] == 0.5f * static_cast<float>(sample));
+
+    // Same seed, same split; another seed shuffles differently
+    auto again = core::split(dataset, 0.2f, 0.1f, 7);
+    auto other = core::split(dataset, 0.2f, 0.1f, 8);
+    POLANN_CHECK(sorted(again.validation.sampleIndices()) == sorted(parts.validation.sampleIndices()));
+    POLANN_CHECK(std::ranges::equal(again.train.sampleIndices(), parts.train.sampleIndices()));
+    POLANN_CHECK(!std::ranges::equal(other.train.sampleIndices(), parts.train.sampleIndices()));
+
+    // Everything may go to training, nothing may go past the whole dataset
+    POLANN_CHECK(core::split(dataset, 0.0f).train.size() == 101);
+    POLANN_CHECK_THROWS(core::split(dataset, 0.7f, 0.4f), std::invalid_argument);
+    POLANN_CHECK_THROWS(core::split(dataset, -0.1f), std::invalid_argument);
+}
+
+POLANN_TEST(kFoldValidationViewsPartitionTheDataset)
+{
+    auto dataset = makeDataset(23);
+    auto folds = core::kFold(dataset, 5, 3);
+    POLANN_REQUIRE(folds.size() == 5);
+
+    std::vector<size_t> allValidation;
+    for (const auto &fold : folds)
+    {
+        // Fold sizes differ by at most one
+        POLANN_CHECK(fold.validation.size() == 4 || fold.validation.size() == 5);
+        POLANN_CHECK(fold.train.size() + fold.validation.size() == 23);
+        POLANN_CHECK(partitions({fold.train.sampleIndices(), fold.validation.sampleIndices()}, 23));
+        allValidation.insert(allValidation.end(), fold.validation.sampleIndices().begin(), fold.validation.sampleIndices().end());
+    }
+    POLANN_CHECK(partitions({allValidation}, 23));
+
+    auto again = core::kFold(dataset, 5, 3);
+    for (size_t f = 0; f < folds.size(); ++f)
+        POLANN_CHECK(std::ranges::equal(again[f].validation.sampleIndices(), folds[f].validation.sampleIndices()));
+
+    // Leave-one-out is the largest fold count
+    POLANN_CHECK(core::kFold(dataset, 23).size() == 23);
+    POLANN_CHECK_THROWS(core::kFold(dataset, 24), std::invalid_argument);
+    POLANN_CHECK_THROWS(core::kFold(dataset, 1), std::invalid_argument);
+    POLANN_CHECK_THROWS(core::kFold(makeDataset(0), 2), std::invalid_argument);
+}
+
+POLANN_TEST(splitFractionsSummingToOne)
+{
+    auto dataset = makeDataset(10);
+    auto parts = core::split(dataset, 0.7f, 0.3f, 1);
+    POLANN_CHECK(parts.train.size() + parts.validation.size() + parts.test.size() == 10);
+    POLANN_CHECK(partitions({parts.train.sampleIndices(), parts.validation.sampleIndices(), parts.test.sampleIndices()}, 10));
+
+    auto halves = core::split(dataset, 0.5f, 0.5f, 1);
+    POLANN_CHECK(halves.train.size() == 0);
+    POLANN_CHECK(halves.validation.size() == 5 && halves.test.size() == 5);
+
+    // An odd count above 2^24 rounds up in float, so the halves used to overrun n
+    constexpr size_t large = (size_t{1} << 24) + 3;
+    auto big = core::split(SizedSource{large}, 0.5f, 0.5f, 1);
+    POLANN_CHECK(big.validation.size() == large / 2);
+    POLANN_CHECK(big.test.size() == large / 2);
+    POLANN_CHECK(big.train.size() == 1);
+}
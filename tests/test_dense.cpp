@@ -0,0 +1,101 @@
+#include "harness.hpp"
+
+#include <span>
+#include <random>
+#include <vector>
+#include "polann/layers/dense.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    std::vector<float> randomValues(size_t size, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> values(size);
+        for (auto &v : values)
+            v = dist(rng);
+        return values;
+    }
+
+    // backwardBatch over rows samples must accumulate what rows calls of backward do
+    template <typename Activation, size_t In, size_t Out>
+    void checkBackwardBatch(size_t rows)
+    {
+        std::mt19937 rng(static_cast<uint32_t>(In * 131 + Out * 7 + rows));
+        layers::Dense<Activation, In, Out> layer;
+        layer.initialize(rng);
+        std::uniform_real_distribution<float> biasDist(-0.5f, 0.5f);
+        for (auto &bias : layer.biases)
+            bias = biasDist(rng);
+
+        auto inputs = randomValues(rows * In, rng);
+        auto gradOutputs = randomValues(rows * Out, rng);
+
+        // Per sample
+        auto single = layer;
+        single.clearGradients();
+        std::vector<float> singleOutputs(rows * Out), singleGradInputs(rows * In);
+        for (size_t r = 0; r < rows; ++r)
+        {
+            single.forward(std::span<const float>(inputs).subspan(r * In, In), std::span<float>(singleOutputs).subspan(r * Out, Out));
+            single.backward(std::span<const float>(gradOutputs).subspan(r * Out, Out), std::span<float>(singleGradInputs).subspan(r * In, In));
+        }
+
+        // Batched
+        auto batched = layer;
+        batched.clearGradients();
+        std::vector<float> outputs(rows * Out), gradInputs(rows * In);
+        auto gradients = gradOutputs;
+        batched.forwardBatch(inputs.data(), outputs.data(), rows);
+        batched.backwardBatch(inputs.data(), outputs.data(), gradients.data(), gradInputs.data(), rows);
+
+        for (size_t i = 0; i < outputs.size(); ++i)
+            POLANN_CHECK_NEAR(outputs[i], singleOutputs[i], 1e-5);
+        for (size_t i = 0; i < gradInputs.size(); ++i)
+            POLANN_CHECK_NEAR(gradInputs[i], singleGradInputs[i], 1e-4);
+        for (size_t i = 0; i < batched.gradWeights.size(); ++i)
+            POLANN_CHECK_NEAR(batched.gradWeights[i], single.gradWeights[i], 1e-4);
+        for (size_t o = 0; o < Out; ++o)
+            POLANN_CHECK_NEAR(batched.gradBiases[o], single.gradBiases[o], 1e-4);
+
+        // The first layer skips the input gradient but accumulates the same parameter gradients
+        auto first = layer;
+        first.clearGradients();
+        gradients = gradOutputs;
+        first.backwardBatch(inputs.data(), outputs.data(), gradients.data(), nullptr, rows);
+        for (size_t i = 0; i < first.gradWeights.size(); ++i)
+            POLANN_CHECK(first.gradWeights[i] == batched.gradWeights[i]);
+    }
+
+} // namespace
+
+POLANN_TEST(backwardBatchMatchesPerSampleBackward)
+{
+    checkBackwardBatch<utils::Sigmoid, 7, 19>(13);
+    checkBackwardBatch<utils::ReLU, 33, 5>(64);
+    checkBackwardBatch<utils::Tanh, 64, 64>(37);
+    checkBackwardBatch<utils::ReLU, 300, 17>(1);
+}
+
+POLANN_TEST(packedForwardBatchMatchesForward)
+{
+    std::mt19937 rng(5);
+    layers::Dense<utils::Tanh, 45, 23> layer;
+    layer.initialize(rng);
+    auto inputs = randomValues(9 * 45, rng);
+
+    std::vector<float> unpacked(9 * 23), packed(9 * 23);
+    layer.forwardBatch(inputs.data(), unpacked.data(), 9);
+    layer.packForInference();
+    POLANN_REQUIRE(layer.isPacked());
+    layer.forwardBatch(inputs.data(), packed.data(), 9);
+    for (size_t i = 0; i < packed.size(); ++i)
+        POLANN_CHECK_NEAR(packed[i], unpacked[i], 1e-5);
+
+    std::vector<float> one(23);
+    layer.forwardBatch(inputs.data() + 4 * 45, one.data(), 1);
+    for (size_t o = 0; o < 23; ++o)
+        POLANN_CHECK_NEAR(one[o], unpacked[4 * 23 + o], 1e-5);
+}
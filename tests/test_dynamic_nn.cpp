@@ -0,0 +1,184 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/layers/dynamic_dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::ReLU, 3, 7>, layers::Dense<utils::Tanh, 7, 5>,
+                             layers::Dense<utils::Sigmoid, 5, 2>>;
+
+    Model makeModel(uint32_t seed)
+    {
+        Model model{layers::Dense<utils::ReLU, 3, 7>(), layers::Dense<utils::Tanh, 7, 5>(), layers::Dense<utils::Sigmoid, 5, 2>()};
+        model.initialize(seed);
+
+        core::Normalizer<3> normalizer;
+        normalizer.shift = {0.5f, -0.25f, 0.0f};
+        normalizer.scale = {2.0f, 1.5f, 0.5f};
+        model.setNormalizer(normalizer);
+        return model;
+    }
+
+    core::Dataset<3, 2> makeDataset(size_t samples)
+    {
+        core::Dataset<3, 2> dataset;
+        dataset.addSamples(samples, [](size_t i, std::span<float, 3> in, std::span<float, 2> out)
+        {
+            float x = static_cast<float>(i);
+            in[0] = std::sin(0.3f * x);
+            in[1] = std::cos(0.7f * x);
+            in[2] = 0.01f * x;
+            out[0] = in[0] * in[1] > 0.0f ? 1.0f : 0.0f;
+            out[1] = 1.0f - out[0];
+        });
+        return dataset;
+    }
+
+    template <typename Source>
+    models::DynamicNN dynamicCopy(const Source &source)
+    {
+        std::stringstream bytes;
+        source.save(bytes);
+        models::DynamicNN copy;
+        copy.load(bytes);
+        return copy;
+    }
+
+    // Flattened weights and biases of every layer, in layer order
+    std::vector<float> parameters(const Model &model)
+    {
+        std::vector<float> all;
+        std::apply([&](const auto &...layer)
+        {
+            ((all.insert(all.end(), layer.weights.begin(), layer.weights.end()),
+              all.insert(all.end(), layer.biases.begin(), layer.biases.end())), ...);
+        }, model.getLayers());
+        return all;
+    }
+
+    std::vector<float> parameters(const models::DynamicNN &model)
+    {
+        std::vector<float> all;
+        for (const auto &layer : model.getLayers())
+        {
+            all.insert(all.end(), layer.weights.begin(), layer.weights.end());
+            all.insert(all.end(), layer.biases.begin(), layer.biases.end());
+        }
+        return all;
+    }
+
+    void checkSamePredictions(const Model &model, const models::DynamicNN &dynamic)
+    {
+        auto dataset = makeDataset(300);
+        std::vector<float> inputs(dataset.inputs.begin(), dataset.inputs.end());
+        std::vector<float> expected(300 * 2), actual(300 * 2);
+        model.predictBatch(inputs, expected);
+        dynamic.predictBatch(inputs, actual);
+        for (size_t i = 0; i < expected.size(); ++i)
+            POLANN_CHECK_NEAR(actual[i], expected[i], 1e-5);
+
+        std::array<float, 3> input = {0.1f, -0.4f, 2.0f};
+        auto single = model.predict(input);
+        auto dynamicSingle = dynamic.predict(input);
+        POLANN_REQUIRE(dynamicSingle.size() == 2);
+        for (size_t o = 0; o < 2; ++o)
+            POLANN_CHECK_NEAR(dynamicSingle[o], single[o], 1e-5);
+    }
+
+} // namespace
+
+POLANN_TEST(sameWeightsGiveSamePredictions)
+{
+    Model model = makeModel(1);
+    models::DynamicNN dynamic = dynamicCopy(model);
+
+    POLANN_CHECK(dynamic.inputSize() == 3 && dynamic.outputSize() == 2 && dynamic.layerCount() == 3);
+    POLANN_CHECK(parameters(dynamic) == parameters(model));
+    checkSamePredictions(model, dynamic);
+
+    auto dataset = makeDataset(500);
+    auto expected = model.evaluate(dataset, 128);
+    auto actual = dynamic.evaluate(dataset, 128);
+    POLANN_CHECK_NEAR(actual.loss, expected.loss, 1e-5);
+    POLANN_CHECK_NEAR(actual.accuracy, expected.accuracy, 1e-6);
+    POLANN_CHECK_NEAR(actual.auc, expected.auc, 1e-5);
+}
+
+POLANN_TEST(sameWeightsGiveSameGradients)
+{
+    Model model = makeModel(2);
+    models::DynamicNN dynamic = dynamicCopy(model);
+    auto dataset = makeDataset(96);
+
+    // Identical batches in identical order, so every SGD step applies the same gradients
+    optimizers::SGD modelOptimizer(0.2f);
+    optimizers::SGD dynamicOptimizer(0.2f);
+    model.fit(dataset, modelOptimizer, 3, 16, false, false);
+    dynamic.fit(dataset, dynamicOptimizer, 3, 16, false, false);
+
+    std::vector<float> expected = parameters(model);
+    std::vector<float> actual = parameters(dynamic);
+    POLANN_REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        POLANN_CHECK_NEAR(actual[i], expected[i], 1e-4);
+    POLANN_CHECK(parameters(makeModel(2)) != expected); // Training moved the weights
+    checkSamePredictions(model, dynamic);
+}
+
+POLANN_TEST(filesRoundTripAcrossModelTypes)
+{
+    // NN -> DynamicNN -> NN keeps weights and the normalizer
+    Model model = makeModel(3);
+    models::DynamicNN dynamic = dynamicCopy(model);
+    POLANN_REQUIRE(dynamic.getNormalizer().has_value());
+
+    std::stringstream bytes;
+    dynamic.save(bytes);
+    Model restored = makeModel(4);
+    restored.load(bytes);
+
+    POLANN_CHECK(parameters(restored) == parameters(model));
+    POLANN_REQUIRE(restored.getNormalizer().has_value());
+    POLANN_CHECK(restored.getNormalizer()->shift == model.getNormalizer()->shift);
+    POLANN_CHECK(restored.getNormalizer()->scale == model.getNormalizer()->scale);
+    checkSamePredictions(restored, dynamic);
+
+    // A DynamicNN of another shape does not load into NN
+    models::DynamicNN other(3);
+    other.addLayer(4, utils::ActivationKind::ReLU).addLayer(2, utils::ActivationKind::Sigmoid);
+    other.initialize(5);
+    std::stringstream otherBytes;
+    other.save(otherBytes);
+    POLANN_CHECK_THROWS(restored.load(otherBytes), std::runtime_error);
+}
+
+POLANN_TEST(uninitializedLayersAreZeroed)
+{
+    layers::DynamicDense layer(3, 4, utils::ActivationKind::Tanh, layers::uninitialized);
+    POLANN_CHECK(layer.inputSize == 3 && layer.outputSize == 4);
+    POLANN_CHECK(layer.weights.size() == 12 && layer.biases.size() == 4);
+    POLANN_CHECK(std::ranges::all_of(layer.weights, [](float w) { return w == 0.0f; }));
+    POLANN_CHECK(std::ranges::all_of(layer.biases, [](float b) { return b == 0.0f; }));
+
+    // Shapes and activations are still validated
+    POLANN_CHECK_THROWS(layers::DynamicDense(0, 4, utils::ActivationKind::Tanh, layers::uninitialized), std::invalid_argument);
+    POLANN_CHECK_THROWS(layers::DynamicDense(3, 4, static_cast<utils::ActivationKind>(200), layers::uninitialized),
+                        std::invalid_argument);
+}
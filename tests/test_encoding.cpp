@@ -0,0 +1,164 @@
+#include "harness.hpp"
+
+#include <bit>
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include "polann/core/encoding.hpp"
+
+using namespace polann;
+using namespace polann::core::encoding;
+
+namespace
+{
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    // Features that leave a scalar tail after the 8-wide decode loop
+    constexpr size_t features = 19;
+
+    template <typename Codec, typename Scalar>
+    bool decodeMatchesScalar(const Codec &codec, const std::array<typename Codec::storage_type, features> &codes,
+                             Scalar scalar)
+    {
+        std::array<float, features> decoded;
+        codec.decode(codes.data(), decoded.data());
+        for (size_t j = 0; j < features; ++j)
+            if (std::bit_cast<uint32_t>(decoded[j]) != std::bit_cast<uint32_t>(scalar(codec, codes[j], j)))
+                return false;
+        return true;
+    }
+
+} // namespace
+
+POLANN_TEST(halfRoundTripsEveryValue)
+{
+    bool exact = true;
+    for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits)
+    {
+        uint16_t half = static_cast<uint16_t>(bits);
+        float value = halfToFloat(half);
+        if ((half & 0x7C00u) == 0x7C00u && (half & 0x03FFu) != 0)
+            exact &= std::isnan(value) && (floatToHalf(value) & 0x7C00u) == 0x7C00u && (floatToHalf(value) & 0x03FFu) != 0;
+        else
+            exact &= floatToHalf(value) == half;
+    }
+    POLANN_CHECK(exact);
+}
+
+POLANN_TEST(halfHandlesSpecialValuesAndTies)
+{
+    // Subnormals: 2^-24 is the smallest, 1023 * 2^-24 the largest
+    POLANN_CHECK(halfToFloat(0x0001) == std::ldexp(1.0f, -24));
+    POLANN_CHECK(halfToFloat(0x03FF) == std::ldexp(1023.0f, -24));
+    POLANN_CHECK(floatToHalf(std::ldexp(1.0f, -24)) == 0x0001);
+    POLANN_CHECK(floatToHalf(std::ldexp(1.0f, -14)) == 0x0400); // Smallest normal
+
+    // Infinities, overflow and signed zero
+    POLANN_CHECK(floatToHalf(infinity) == 0x7C00);
+    POLANN_CHECK(floatToHalf(-infinity) == 0xFC00);
+    POLANN_CHECK(halfToFloat(0xFC00) == -infinity);
+    POLANN_CHECK(floatToHalf(65504.0f) == 0x7BFF);
+    POLANN_CHECK(floatToHalf(65519.0f) == 0x7BFF); // Below the halfway point to 2^16
+    POLANN_CHECK(floatToHalf(65520.0f) == 0x7C00); // Ties to even, which is infinity
+    POLANN_CHECK(floatToHalf(-0.0f) == 0x8000);
+    POLANN_CHECK(std::signbit(halfToFloat(0x8000)));
+
+    // NaN stays a quiet NaN of the same sign
+    uint16_t nan = floatToHalf(std::numeric_limits<float>::quiet_NaN());
+    POLANN_CHECK((nan & 0x7C00u) == 0x7C00u && (nan & 0x0200u) != 0);
+    POLANN_CHECK(std::isnan(halfToFloat(nan)));
+    uint16_t signalling = floatToHalf(std::bit_cast<float>(0x7F800001u)); // Payload below the half mantissa
+    POLANN_CHECK((signalling & 0x03FFu) != 0);
+
+    // Ties round to even, for normals and subnormals
+    POLANN_CHECK(floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+    POLANN_CHECK(floatToHalf(1.0f + std::ldexp(3.0f, -11)) == 0x3C02);
+    POLANN_CHECK(floatToHalf(std::ldexp(1.0f, -25)) == 0x0000);
+    POLANN_CHECK(floatToHalf(std::ldexp(3.0f, -25)) == 0x0002);
+    POLANN_CHECK(floatToHalf(-std::ldexp(3.0f, -25)) == 0x8002);
+}
+
+POLANN_TEST(bfloat16RoundTripsEveryValue)
+{
+    bool exact = true;
+    for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits)
+    {
+        uint16_t value = static_cast<uint16_t>(bits);
+        float decoded = bfloat16ToFloat(value);
+        if (std::isnan(decoded))
+            exact &= std::isnan(bfloat16ToFloat(floatToBFloat16(decoded)));
+        else
+            exact &= floatToBFloat16(decoded) == value;
+    }
+    POLANN_CHECK(exact);
+}
+
+POLANN_TEST(bfloat16HandlesSpecialValuesAndTies)
+{
+    POLANN_CHECK(floatToBFloat16(infinity) == 0x7F80);
+    POLANN_CHECK(floatToBFloat16(-infinity) == 0xFF80);
+    POLANN_CHECK(floatToBFloat16(std::numeric_limits<float>::max()) == 0x7F80); // Rounds past the largest finite
+
+    // A NaN whose payload sits in the dropped bits stays NaN
+    uint16_t nan = floatToBFloat16(std::bit_cast<float>(0x7F800001u));
+    POLANN_CHECK(std::isnan(bfloat16ToFloat(nan)));
+
+    // fp32 subnormals keep their top mantissa bits
+    POLANN_CHECK(floatToBFloat16(std::bit_cast<float>(0x00010000u)) == 0x0001);
+    POLANN_CHECK(floatToBFloat16(std::bit_cast<float>(0x00018000u)) == 0x0002); // Tie to even upwards
+    POLANN_CHECK(floatToBFloat16(std::bit_cast<float>(0x00008000u)) == 0x0000); // Tie to even downwards
+
+    POLANN_CHECK(floatToBFloat16(1.0f + std::ldexp(1.0f, -8)) == 0x3F80);
+    POLANN_CHECK(floatToBFloat16(1.0f + std::ldexp(3.0f, -8)) == 0x3F82);
+    POLANN_CHECK(floatToBFloat16(-0.0f) == 0x8000);
+}
+
+POLANN_TEST(vectorDecodeMatchesScalar)
+{
+    std::array<uint16_t, features> halves;
+    std::array<uint16_t, features> bfloats;
+    std::array<int8_t, features> bytes;
+    for (size_t j = 0; j < features; ++j)
+    {
+        halves[j] = static_cast<uint16_t>(0x0001u + j * 0x0D31u); // Subnormals, normals, infinity and NaN
+        bfloats[j] = static_cast<uint16_t>(0x0001u + j * 0x0E17u);
+        bytes[j] = static_cast<int8_t>(static_cast<int>(j * 29) - 128);
+    }
+    halves[7] = 0x7C00;
+    halves[18] = 0xFE00;
+
+    POLANN_CHECK(decodeMatchesScalar(Float16<features>{}, halves, [](const Float16<features> &, uint16_t code, size_t)
+    {
+        return halfToFloat(code);
+    }));
+    POLANN_CHECK(decodeMatchesScalar(BFloat16<features>{}, bfloats, [](const BFloat16<features> &, uint16_t code, size_t)
+    {
+        return bfloat16ToFloat(code);
+    }));
+
+    Int8<features> codec;
+    for (size_t j = 0; j < features; ++j)
+    {
+        codec.scale[j] = 0.013f * static_cast<float>(j + 1);
+        codec.offset[j] = -1.7f + 0.31f * static_cast<float>(j);
+    }
+    POLANN_CHECK(decodeMatchesScalar(codec, bytes, [](const Int8<features> &c, int8_t code, size_t j)
+    {
+        return std::fma(static_cast<float>(code), c.scale[j], c.offset[j]);
+    }));
+}
+
+POLANN_TEST(int8EncodesNanAsZero)
+{
+    Int8<3> codec;
+    codec.scale = {0.1f, 0.1f, 0.1f};
+    codec.offset = {0.0f, 0.0f, 0.0f};
+
+    std::array<float, 3> in = {std::numeric_limits<float>::quiet_NaN(), 1000.0f, -infinity};
+    std::array<int8_t, 3> out;
+    codec.encode(in.data(), out.data());
+    POLANN_CHECK(out[0] == 0);
+    POLANN_CHECK(out[1] == 127);
+    POLANN_CHECK(out[2] == -128);
+}
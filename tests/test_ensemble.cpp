@@ -0,0 +1,185 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#include "polann/core/normalizer.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/ensemble.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::ReLU, 4, 9>, layers::Dense<utils::Tanh, 9, 6>,
+                             layers::Dense<utils::Sigmoid, 6, 3>>;
+    using BinaryModel = models::NN<layers::Dense<utils::ReLU, 4, 8>, layers::Dense<utils::Sigmoid, 8, 1>>;
+
+    constexpr size_t memberCount = 5;
+
+    template <typename... Layers>
+    models::NN<Layers...> blankNet(std::type_identity<models::NN<Layers...>>)
+    {
+        return models::NN<Layers...>(Layers()...);
+    }
+
+    template <typename Net>
+    std::vector<Net> makeMembers(bool withNormalizer)
+    {
+        std::vector<Net> nets;
+        for (uint32_t k = 0; k < memberCount; ++k)
+        {
+            Net net = blankNet(std::type_identity<Net>{});
+            net.initialize(100 + k);
+            if (withNormalizer)
+            {
+                core::Normalizer<4> normalizer;
+                normalizer.shift = {0.25f, -0.5f, 0.0f, 1.0f};
+                normalizer.scale = {2.0f, 0.5f, 1.5f, 1.0f};
+                net.setNormalizer(normalizer);
+            }
+            nets.push_back(std::move(net));
+        }
+        return nets;
+    }
+
+    std::vector<float> makeInputs(size_t rows)
+    {
+        std::vector<float> inputs(rows * 4);
+        for (size_t i = 0; i < inputs.size(); ++i)
+            inputs[i] = std::sin(0.37f * static_cast<float>(i)) * 2.0f;
+        return inputs;
+    }
+
+    template <typename Net>
+    std::array<float, Net::outputSize> memberOutput(const Net &net, const std::vector<float> &inputs, size_t row)
+    {
+        std::array<float, 4> input;
+        std::copy_n(inputs.begin() + row * 4, 4, input.begin());
+        return net.predict(input);
+    }
+
+    // Mean of the members' own predict per row, checked against one predictBatch call
+    void checkMean(size_t rows, bool withNormalizer)
+    {
+        std::vector<Model> nets = makeMembers<Model>(withNormalizer);
+        models::Ensemble ensemble(nets);
+        POLANN_CHECK(ensemble.size() == memberCount);
+
+        std::vector<float> inputs = makeInputs(rows);
+        std::vector<float> outputs(rows * Model::outputSize);
+        ensemble.predictBatch(inputs, outputs);
+
+        for (size_t r = 0; r < rows; ++r)
+        {
+            std::array<float, Model::outputSize> expected{};
+            for (const Model &net : nets)
+            {
+                auto output = memberOutput(net, inputs, r);
+                for (size_t o = 0; o < Model::outputSize; ++o)
+                    expected[o] += output[o] / memberCount;
+            }
+            for (size_t o = 0; o < Model::outputSize; ++o)
+                POLANN_CHECK_NEAR(outputs[r * Model::outputSize + o], expected[o], 1e-5f);
+        }
+    }
+}
+
+POLANN_TEST(meanMatchesMembersForOneRow)
+{
+    checkMean(1, false);
+}
+
+POLANN_TEST(meanMatchesMembersAcrossChunks)
+{
+    // More than one 256-row fused pass, with a ragged last chunk
+    checkMean(600, true);
+}
+
+POLANN_TEST(predictMatchesPredictBatch)
+{
+    std::vector<Model> nets = makeMembers<Model>(true);
+    models::Ensemble ensemble(nets);
+
+    std::vector<float> inputs = makeInputs(3);
+    std::vector<float> outputs(3 * Model::outputSize);
+    ensemble.predictBatch(inputs, outputs);
+
+    std::array<float, 4> input;
+    std::copy_n(inputs.begin() + 8, 4, input.begin());
+    auto single = ensemble.predict(input);
+    for (size_t o = 0; o < Model::outputSize; ++o)
+        POLANN_CHECK_NEAR(single[o], outputs[2 * Model::outputSize + o], 1e-6f);
+}
+
+POLANN_TEST(voteCountsArgmaxPerMember)
+{
+    constexpr size_t rows = 300;
+    std::vector<Model> nets = makeMembers<Model>(false);
+    models::Ensemble ensemble(nets, models::EnsembleReduction::Vote);
+    POLANN_CHECK(ensemble.getReduction() == models::EnsembleReduction::Vote);
+
+    std::vector<float> inputs = makeInputs(rows);
+    std::vector<float> outputs(rows * Model::outputSize);
+    ensemble.predictBatch(inputs, outputs);
+
+    for (size_t r = 0; r < rows; ++r)
+    {
+        std::array<float, Model::outputSize> expected{};
+        for (const Model &net : nets)
+        {
+            auto output = memberOutput(net, inputs, r);
+            expected[std::ranges::max_element(output) - output.begin()] += 1.0f / memberCount;
+        }
+        float total = 0.0f;
+        for (size_t o = 0; o < Model::outputSize; ++o)
+        {
+            POLANN_CHECK_NEAR(outputs[r * Model::outputSize + o], expected[o], 1e-6f);
+            total += outputs[r * Model::outputSize + o];
+        }
+        POLANN_CHECK_NEAR(total, 1.0f, 1e-6f);
+    }
+}
+
+POLANN_TEST(voteThresholdsSingleOutput)
+{
+    constexpr size_t rows = 300;
+    std::vector<BinaryModel> nets = makeMembers<BinaryModel>(true);
+    models::Ensemble ensemble(nets, models::EnsembleReduction::Vote);
+
+    std::vector<float> inputs = makeInputs(rows);
+    std::vector<float> outputs(rows);
+    ensemble.predictBatch(inputs, outputs);
+
+    for (size_t r = 0; r < rows; ++r)
+    {
+        float expected = 0.0f;
+        for (const BinaryModel &net : nets)
+            expected += memberOutput(net, inputs, r)[0] >= 0.5f ? 1.0f / memberCount : 0.0f;
+        POLANN_CHECK_NEAR(outputs[r], expected, 1e-6f);
+    }
+}
+
+POLANN_TEST(ensembleRejectsInvalidInput)
+{
+    POLANN_CHECK_THROWS(models::Ensemble(std::span<const Model>{}), std::invalid_argument);
+
+    std::vector<Model> nets = makeMembers<Model>(false);
+    core::Normalizer<4> normalizer;
+    normalizer.shift = {1.0f, 1.0f, 1.0f, 1.0f};
+    nets[1].setNormalizer(normalizer);
+    POLANN_CHECK_THROWS(models::Ensemble(nets), std::invalid_argument);
+
+    std::vector<Model> valid = makeMembers<Model>(false);
+    models::Ensemble ensemble(valid);
+    std::vector<float> inputs(6);
+    std::vector<float> outputs(Model::outputSize);
+    POLANN_CHECK_THROWS(ensemble.predictBatch(inputs, outputs), std::invalid_argument);
+}
@@ -0,0 +1,196 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include "polann/kernels/gemm.hpp"
+
+using namespace polann;
+using kernels::Transpose;
+
+namespace
+{
+    // Shapes straddle the 6 x 16 micro-tile, the small-problem cutoff and the mc / kc / nc cache blocks
+    constexpr size_t ms[] = {1, 2, 5, 7, 13, 170};
+    constexpr size_t ns[] = {1, 3, 15, 17, 33};
+    constexpr size_t ks[] = {1, 4, 31, 259};
+
+    std::vector<float> randomMatrix(size_t size, std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> values(size);
+        for (auto &v : values)
+            v = dist(rng);
+        return values;
+    }
+
+    // Same contract as sgemm, in double and summing magnitudes for an error bound
+    struct Expected
+    {
+        std::vector<double> value;
+        std::vector<double> magnitude;
+    };
+
+    Expected reference(Transpose transA, Transpose transB, size_t m, size_t n, size_t k, float alpha,
+                       const std::vector<float> &a, size_t lda, const std::vector<float> &b, size_t ldb,
+                       float beta, const std::vector<float> &c, size_t ldc)
+    {
+        Expected expected{std::vector<double>(m * n), std::vector<double>(m * n)};
+        for (size_t i = 0; i < m; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                double sum = 0.0, magnitude = 0.0;
+                for (size_t p = 0; p < k; ++p)
+                {
+                    double av = transA == Transpose::Yes ? a[p * lda + i] : a[i * lda + p];
+                    double bv = transB == Transpose::Yes ? b[j * ldb + p] : b[p * ldb + j];
+                    sum += av * bv;
+                    magnitude += std::abs(av * bv);
+                }
+                double old = beta == 0.0f ? 0.0 : beta * static_cast<double>(c[i * ldc + j]);
+                expected.value[i * n + j] = alpha * sum + old;
+                expected.magnitude[i * n + j] = std::abs(alpha) * magnitude + std::abs(old);
+            }
+        return expected;
+    }
+
+    // Compares the m x n result and checks that the padding columns of C were left alone
+    bool matches(const Expected &expected, const std::vector<float> &c, const std::vector<float> &original,
+                 size_t m, size_t n, size_t ldc)
+    {
+        for (size_t i = 0; i < m; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                double error = std::abs(c[i * ldc + j] - expected.value[i * n + j]);
+                if (!(error <= 1e-5 * (1.0 + expected.magnitude[i * n + j])))
+                    return false;
+            }
+            for (size_t j = n; j < ldc; ++j)
+                if (std::memcmp(&c[i * ldc + j], &original[i * ldc + j], sizeof(float)) != 0)
+                    return false;
+        }
+        return true;
+    }
+
+    void reportCase(const char *kernel, Transpose ta, Transpose tb, size_t m, size_t n, size_t k, float beta)
+    {
+        std::cerr << "  " << kernel << " transA=" << (ta == Transpose::Yes) << " transB=" << (tb == Transpose::Yes)
+                  << " m=" << m << " n=" << n << " k=" << k << " beta=" << beta << "\n";
+    }
+
+    // C before the call; with beta == 0 it is NaN, which sgemm must not read
+    std::vector<float> initialC(size_t m, size_t ldc, float beta, std::mt19937 &rng)
+    {
+        if (beta == 0.0f)
+            return std::vector<float>(m * ldc, std::numeric_limits<float>::quiet_NaN());
+        return randomMatrix(m * ldc, rng);
+    }
+
+} // namespace
+
+POLANN_TEST(reportsKernelVariant)
+{
+    std::string variant = kernels::kernelVariant();
+    std::cout << "kernel variant: " << variant << "\n";
+    POLANN_CHECK(variant == "avx2" || variant == "generic");
+}
+
+POLANN_TEST(sgemmMatchesReference)
+{
+    std::mt19937 rng(42);
+    for (Transpose ta : {Transpose::No, Transpose::Yes})
+        for (Transpose tb : {Transpose::No, Transpose::Yes})
+            for (size_t m : ms)
+                for (size_t n : ns)
+                    for (size_t k : ks)
+                        for (float beta : {0.0f, 0.5f})
+                        {
+                            // Leading dimensions wider than the matrices, as for sub-blocks
+                            size_t lda = (ta == Transpose::Yes ? m : k) + 3;
+                            size_t ldb = (tb == Transpose::Yes ? k : n) + 2;
+                            size_t ldc = n + 1;
+                            auto a = randomMatrix((ta == Transpose::Yes ? k : m) * lda, rng);
+                            auto b = randomMatrix((tb == Transpose::Yes ? n : k) * ldb, rng);
+                            auto c = initialC(m, ldc, beta, rng);
+                            auto original = c;
+                            float alpha = 0.75f;
+
+                            auto expected = reference(ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+                            kernels::sgemm(ta, tb, m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+                            if (!matches(expected, c, original, m, n, ldc))
+                            {
+                                reportCase("sgemm", ta, tb, m, n, k, beta);
+                                POLANN_CHECK(false);
+                            }
+                        }
+}
+
+POLANN_TEST(sgemmHandlesWideAndDegenerateShapes)
+{
+    std::mt19937 rng(7);
+
+    // Wider than one nc block of B
+    size_t m = 7, n = kernels::gemm::nc + 21, k = 5;
+    auto a = randomMatrix(m * k, rng);
+    auto b = randomMatrix(k * n, rng);
+    std::vector<float> c(m * n, 1.0f);
+    auto expected = reference(Transpose::No, Transpose::No, m, n, k, 1.0f, a, k, b, n, 1.0f, c, n);
+    kernels::sgemm(Transpose::No, Transpose::No, m, n, k, 1.0f, a.data(), k, b.data(), n, 1.0f, c.data(), n);
+    POLANN_CHECK(matches(expected, c, c, m, n, n));
+
+    // k == 0 and alpha == 0 only scale C by beta
+    std::vector<float> scaled(4 * 4, 2.0f);
+    kernels::sgemm(Transpose::No, Transpose::No, 4, 4, 0, 1.0f, a.data(), 1, b.data(), 4, 0.5f, scaled.data(), 4);
+    POLANN_CHECK(scaled[0] == 1.0f && scaled[15] == 1.0f);
+    kernels::sgemm(Transpose::No, Transpose::No, 4, 4, 3, 0.0f, a.data(), 3, b.data(), 4, 0.0f, scaled.data(), 4);
+    POLANN_CHECK(scaled[0] == 0.0f && scaled[15] == 0.0f);
+}
+
+POLANN_TEST(sgemmPackedMatchesReference)
+{
+    std::mt19937 rng(3);
+    for (Transpose tb : {Transpose::No, Transpose::Yes})
+        for (size_t n : ns)
+            for (size_t k : ks)
+            {
+                size_t ldb = (tb == Transpose::Yes ? k : n) + 1;
+                auto b = randomMatrix((tb == Transpose::Yes ? n : k) * ldb, rng);
+                kernels::PackedMatrix packed = kernels::packMatrix(tb, k, n, b.data(), ldb);
+                POLANN_REQUIRE(packed.rows == k && packed.cols == n);
+
+                for (size_t m : ms)
+                    for (float beta : {0.0f, 0.5f})
+                    {
+                        size_t lda = k + 2;
+                        size_t ldc = n + 3;
+                        auto a = randomMatrix(m * lda, rng);
+                        auto c = initialC(m, ldc, beta, rng);
+                        auto original = c;
+
+                        auto expected = reference(Transpose::No, tb, m, n, k, 1.25f, a, lda, b, ldb, beta, c, ldc);
+                        kernels::sgemmPacked(m, 1.25f, a.data(), lda, packed, beta, c.data(), ldc);
+                        if (!matches(expected, c, original, m, n, ldc))
+                        {
+                            reportCase("sgemmPacked", Transpose::No, tb, m, n, k, beta);
+                            POLANN_CHECK(false);
+                        }
+                    }
+            }
+}
+
+POLANN_TEST(sgemmReferenceMatchesDoublePrecision)
+{
+    std::mt19937 rng(11);
+    size_t m = 9, n = 10, k = 11;
+    auto a = randomMatrix(k * m, rng);
+    auto b = randomMatrix(n * k, rng);
+    std::vector<float> c(m * n, 0.5f);
+    auto expected = reference(Transpose::Yes, Transpose::Yes, m, n, k, 2.0f, a, m, b, k, -1.0f, c, n);
+    kernels::sgemmReference(Transpose::Yes, Transpose::Yes, m, n, k, 2.0f, a.data(), m, b.data(), k, -1.0f, c.data(), n);
+    POLANN_CHECK(matches(expected, c, c, m, n, n));
+}
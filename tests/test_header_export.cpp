@@ -0,0 +1,85 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include "export_models.hpp"
+
+// Generated at build time from the same models by generate_export_headers
+#include "constexpr_model.hpp"
+#include "mixed_model.hpp"
+#include "unrolled_model.hpp"
+
+using namespace polann;
+
+namespace
+{
+    template <size_t Inputs>
+    std::array<float, Inputs> sampleInput(size_t sample)
+    {
+        std::array<float, Inputs> input{};
+        for (size_t i = 0; i < Inputs; ++i)
+            input[i] = std::sin(0.37f * static_cast<float>(sample * Inputs + i)) * 2.0f;
+        return input;
+    }
+
+    template <typename Model, typename Predict>
+    void checkMatchesModel(const Model &model, Predict &&exported)
+    {
+        for (size_t sample = 0; sample < 50; ++sample)
+        {
+            auto input = sampleInput<Model::inputSize>(sample);
+            auto expected = model.predict(input);
+            auto actual = exported(input);
+            static_assert(std::tuple_size_v<decltype(actual)> == Model::outputSize);
+            for (size_t o = 0; o < Model::outputSize; ++o)
+                POLANN_CHECK_NEAR(actual[o], expected[o], 1e-5);
+        }
+    }
+
+} // namespace
+
+POLANN_TEST(unrolledHeaderMatchesPredict)
+{
+    static_assert(exported::unrolled::inputSize == 3 && exported::unrolled::outputSize == 2);
+    checkMatchesModel(tests::makeUnrolledModel(), [](const auto &input) { return exported::unrolled::predict(input); });
+}
+
+POLANN_TEST(loopHeaderWithNormalizerMatchesPredict)
+{
+    static_assert(exported::mixed::inputSize == 8 && exported::mixed::outputSize == 3);
+    checkMatchesModel(tests::makeMixedModel(), [](const auto &input) { return exported::mixed::predict(input); });
+}
+
+POLANN_TEST(constexprHeaderMatchesPredict)
+{
+    // Evaluated by the compiler
+    constexpr std::array<float, 1> atCompileTime = exported::constant::predict({0.5f, -0.25f});
+    auto model = tests::makeConstexprModel();
+    POLANN_CHECK_NEAR(atCompileTime[0], model.predict(std::array<float, 2>{0.5f, -0.25f})[0], 1e-5);
+
+    checkMatchesModel(model, [](const auto &input) { return exported::constant::predict(input); });
+}
+
+POLANN_TEST(exportRejectsInvalidInput)
+{
+    std::ostringstream os;
+    POLANN_CHECK_THROWS(models::exportHeader(tests::makeUnrolledModel(), os, {.namespaceName = ""}), std::invalid_argument);
+
+    auto model = tests::makeUnrolledModel();
+    std::stringstream bytes;
+    model.save(bytes);
+    std::string data = bytes.str();
+
+    // A NaN weight has no literal; patch the first weight of the saved file
+    size_t firstWeight = sizeof(models::modelMagic) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + 1;
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    data.replace(firstWeight, sizeof(float), reinterpret_cast<const char *>(&nan), sizeof(float));
+    std::istringstream patched(data);
+    model.load(patched);
+    POLANN_CHECK_THROWS(models::exportHeader(model, os), std::runtime_error);
+}
@@ -0,0 +1,35 @@
+#include "harness.hpp"
+
+#include <array>
+#include <span>
+#include "instantiation_model.hpp"
+
+using namespace polann;
+using polann::tests::InstantiatedDataset;
+using polann::tests::InstantiatedModel;
+
+// Builds the four macros as a model.hpp/model.cpp pair would; calls may still be inlined here
+POLANN_TEST(externModelTrainsAndPredicts)
+{
+    InstantiatedDataset dataset;
+    dataset.addSamples(64, [](size_t i, std::span<float, 4> in, std::span<float, 2> out)
+    {
+        for (size_t j = 0; j < 4; ++j)
+            in[j] = static_cast<float>((i + j) % 5) / 5.0f;
+        out[0] = in[0] > 0.4f ? 1.0f : 0.0f;
+        out[1] = 1.0f - out[0];
+    });
+
+    InstantiatedModel model{layers::Dense<utils::ReLU, 4, 8>(), layers::Dense<utils::Sigmoid, 8, 2>()};
+    model.initialize(5);
+    optimizers::SGD optimizer(0.1f);
+
+    float before = model.evaluate(dataset).loss;
+    model.fit(dataset, optimizer, 20, 16, true, false);
+    float after = model.evaluate(dataset).loss;
+    POLANN_CHECK(after < before);
+
+    std::array<float, 4> input = {0.2f, 0.4f, 0.6f, 0.8f};
+    auto output = model.predict(input);
+    POLANN_CHECK(output[0] >= 0.0f && output[0] <= 1.0f);
+}
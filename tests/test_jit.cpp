@@ -0,0 +1,226 @@
+#include "harness.hpp"
+
+#include <array>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include "polann/core/normalizer.hpp"
+#include "polann/kernels/jit.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/model_format.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+using utils::ActivationKind;
+
+namespace
+{
+    constexpr ActivationKind activations[] = {ActivationKind::Identity, ActivationKind::ReLU, ActivationKind::Sigmoid, ActivationKind::Tanh};
+
+    std::vector<float> randomValues(size_t size, std::mt19937 &rng, float limit = 1.0f)
+    {
+        std::uniform_real_distribution<float> dist(-limit, limit);
+        std::vector<float> values(size);
+        for (auto &v : values)
+            v = dist(rng);
+        return values;
+    }
+
+    template <size_t Features>
+    core::Normalizer<Features> randomNormalizer(std::mt19937 &rng)
+    {
+        std::uniform_real_distribution<float> shift(-2.0f, 2.0f);
+        std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+        core::Normalizer<Features> normalizer;
+        for (size_t j = 0; j < Features; ++j)
+        {
+            normalizer.shift[j] = shift(rng);
+            normalizer.scale[j] = scale(rng);
+        }
+        return normalizer;
+    }
+
+    // Random non-zero biases, so a wrong bias offset in the generated code shows up
+    void randomizeBiases(models::DynamicNN &model, std::mt19937 &rng)
+    {
+        std::ostringstream saved;
+        model.save(saved);
+        std::string bytes = saved.str();
+
+        size_t offset = sizeof(models::modelMagic) + 2 * sizeof(uint32_t);
+        for (const auto &layer : model.getLayers())
+        {
+            offset += 2 * sizeof(uint64_t) + 1 + sizeof(float) * layer.weights.size();
+            auto biases = randomValues(layer.outputSize, rng, 0.5f);
+            std::memcpy(bytes.data() + offset, biases.data(), sizeof(float) * biases.size());
+            offset += sizeof(float) * layer.outputSize;
+        }
+
+        std::istringstream is(bytes);
+        model.load(is);
+    }
+
+    // Compares the chain with predict on a few samples, one by one and through run()
+    template <typename Model>
+    bool matchesPredict(const kernels::JitChain &chain, const Model &model, size_t inputSize, std::mt19937 &rng)
+    {
+        constexpr size_t samples = 5;
+        auto inputs = randomValues(samples * inputSize, rng, 3.0f);
+        size_t outputSize = chain.outputSize();
+
+        std::vector<float> jitOutputs(samples * outputSize);
+        chain.run(inputs.data(), jitOutputs.data(), samples);
+
+        bool ok = true;
+        std::vector<float> single(outputSize);
+        for (size_t s = 0; s < samples; ++s)
+        {
+            std::vector<float> input(inputs.begin() + s * inputSize, inputs.begin() + (s + 1) * inputSize);
+            auto expected = model.predict(input);
+            chain(input.data(), single.data());
+            for (size_t o = 0; o < outputSize; ++o)
+            {
+                // The normalizer is folded into the weights, so allow rounding differences
+                ok = ok && tests::near(single[o], expected[o], 1e-4);
+                ok = ok && single[o] == jitOutputs[s * outputSize + o];
+            }
+        }
+        return ok;
+    }
+
+    template <size_t InputSize>
+    void checkDynamic(size_t outputSize, ActivationKind activation, bool withNormalizer, std::mt19937 &rng)
+    {
+        models::DynamicNN model(InputSize);
+        model.addLayer(outputSize, activation);
+        model.initialize(rng());
+        randomizeBiases(model, rng);
+        if (withNormalizer)
+            model.setNormalizer(randomNormalizer<InputSize>(rng));
+
+        auto chain = kernels::compileJit(model);
+        POLANN_REQUIRE(chain.inputSize() == InputSize && chain.outputSize() == outputSize);
+        if (!matchesPredict(chain, model, InputSize, rng))
+        {
+            std::cerr << "  input " << InputSize << " output " << outputSize << " activation "
+                      << static_cast<int>(activation) << " normalizer " << withNormalizer << "\n";
+            POLANN_CHECK(false);
+        }
+    }
+
+} // namespace
+
+POLANN_TEST(unsupportedPlatformsThrow)
+{
+    if (kernels::JitChain::supported())
+        return;
+
+    models::DynamicNN model(4);
+    model.addLayer(2, ActivationKind::ReLU);
+    POLANN_CHECK_THROWS(kernels::compileJit(model), std::runtime_error);
+}
+
+POLANN_TEST(singleLayersMatchPredict)
+{
+    if (!kernels::JitChain::supported())
+        return;
+
+    // Odd input sizes, outputs inside one block, at a block edge and spanning several 64-wide blocks
+    std::mt19937 rng(17);
+    for (ActivationKind activation : activations)
+        for (bool withNormalizer : {false, true})
+            for (size_t outputs : {1, 7, 8, 63, 64, 65, 100, 130})
+            {
+                checkDynamic<1>(outputs, activation, withNormalizer, rng);
+                checkDynamic<3>(outputs, activation, withNormalizer, rng);
+                checkDynamic<13>(outputs, activation, withNormalizer, rng);
+                checkDynamic<64>(outputs, activation, withNormalizer, rng);
+                checkDynamic<97>(outputs, activation, withNormalizer, rng);
+            }
+}
+
+POLANN_TEST(deepChainsMatchPredict)
+{
+    if (!kernels::JitChain::supported())
+        return;
+
+    std::mt19937 rng(23);
+    for (bool withNormalizer : {false, true})
+    {
+        // Every activation between layers, with widths that alternate around the block size
+        models::DynamicNN model(13);
+        model.addLayer(67, ActivationKind::Tanh)
+            .addLayer(5, ActivationKind::ReLU)
+            .addLayer(129, ActivationKind::Identity)
+            .addLayer(31, ActivationKind::Sigmoid)
+            .addLayer(3, ActivationKind::Identity);
+        model.initialize(rng());
+        randomizeBiases(model, rng);
+        if (withNormalizer)
+            model.setNormalizer(randomNormalizer<13>(rng));
+
+        auto chain = kernels::compileJit(model);
+        POLANN_CHECK(matchesPredict(chain, model, 13, rng));
+    }
+}
+
+POLANN_TEST(compileTimeModelsMatchPredict)
+{
+    if (!kernels::JitChain::supported())
+        return;
+
+    std::mt19937 rng(29);
+    layers::Dense<utils::ReLU, 7, 70> hidden;
+    layers::Dense<utils::Sigmoid, 70, 9> output;
+    hidden.initialize(rng);
+    output.initialize(rng);
+    hidden.biases[0] = 0.3f;
+    output.biases[8] = -0.2f;
+
+    models::NN<layers::Dense<utils::ReLU, 7, 70>, layers::Dense<utils::Sigmoid, 70, 9>> model{hidden, output};
+    model.setNormalizer(randomNormalizer<7>(rng));
+
+    auto chain = kernels::compileJit(model);
+    auto inputs = randomValues(7, rng, 2.0f);
+    std::array<float, 7> input;
+    std::copy(inputs.begin(), inputs.end(), input.begin());
+    auto expected = model.predict(input);
+
+    std::array<float, 9> result{};
+    chain(input.data(), result.data());
+    for (size_t o = 0; o < 9; ++o)
+        POLANN_CHECK_NEAR(result[o], expected[o], 1e-4);
+}
+
+POLANN_TEST(chainsRunOnSeveralThreads)
+{
+    if (!kernels::JitChain::supported())
+        return;
+
+    std::mt19937 rng(31);
+    models::DynamicNN model(11);
+    model.addLayer(90, ActivationKind::Tanh).addLayer(4, ActivationKind::Sigmoid);
+    model.initialize(9);
+    auto chain = kernels::compileJit(model);
+
+    auto inputs = randomValues(11 * 64, rng);
+    std::vector<float> expected(4 * 64);
+    chain.run(inputs.data(), expected.data(), 64);
+
+    std::vector<std::vector<float>> results(4, std::vector<float>(4 * 64));
+    std::vector<std::thread> threads;
+    for (auto &result : results)
+        threads.emplace_back([&] { chain.run(inputs.data(), result.data(), 64); });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (const auto &result : results)
+        POLANN_CHECK(result == expected);
+}
@@ -0,0 +1,168 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <limits>
+#include "polann/callbacks/early_stopping.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::Tanh, 2, 8>, layers::Dense<utils::Sigmoid, 8, 1>>;
+
+    core::Dataset<2, 1> circleDataset(size_t samples)
+    {
+        core::Dataset<2, 1> dataset;
+        dataset.addSamples(samples, [](size_t i, std::span<float, 2> in, std::span<float, 1> out)
+        {
+            in[0] = std::sin(0.7f * static_cast<float>(i));
+            in[1] = std::cos(1.3f * static_cast<float>(i));
+            out[0] = in[0] * in[0] + in[1] * in[1] < 0.8f ? 1.0f : 0.0f;
+        });
+        return dataset;
+    }
+
+    Model makeModel()
+    {
+        Model model{layers::Dense<utils::Tanh, 2, 8>(), layers::Dense<utils::Sigmoid, 8, 1>()};
+        model.initialize(4);
+        return model;
+    }
+
+    // Identity layer, so every prediction is exactly the sample's input
+    template <size_t Size>
+    models::NN<layers::Dense<utils::Identity, Size, Size>> passThrough()
+    {
+        layers::Dense<utils::Identity, Size, Size> layer;
+        layer.weights.fill(0.0f);
+        layer.biases.fill(0.0f);
+        for (size_t i = 0; i < Size; ++i)
+            layer.weights[i * Size + i] = 1.0f;
+        return models::NN<layers::Dense<utils::Identity, Size, Size>>(layer);
+    }
+
+    // Repeats the rows so batches split into several chunks; no metric depends on repetition
+    template <size_t Size, size_t Rows>
+    core::Dataset<Size, Size> repeated(const std::array<std::array<float, Size>, Rows> &predictions,
+                                       const std::array<std::array<float, Size>, Rows> &labels)
+    {
+        core::Dataset<Size, Size> dataset;
+        for (size_t copy = 0; copy < 50; ++copy)
+            for (size_t r = 0; r < Rows; ++r)
+                dataset.addSample(predictions[r], labels[r]);
+        return dataset;
+    }
+
+} // namespace
+
+POLANN_TEST(evaluateMatchesHandComputedMetrics)
+{
+    using Row = std::array<float, 1>;
+    std::array<Row, 8> predictions = {Row{0.875f}, Row{0.375f}, Row{0.375f}, Row{0.625f},
+                                      Row{0.25f}, Row{0.375f}, Row{0.75f}, Row{0.125f}};
+    std::array<Row, 8> labels = {Row{1.0f}, Row{1.0f}, Row{0.0f}, Row{0.0f},
+                                 Row{0.0f}, Row{1.0f}, Row{1.0f}, Row{0.0f}};
+    auto dataset = repeated(predictions, labels);
+    auto model = passThrough<1>();
+    core::ThreadPool pool(4);
+
+    for (size_t batchSize : {64, 400})
+    {
+        auto metrics = model.evaluate(dataset, batchSize, pool);
+        POLANN_CHECK(metrics.samples == 400);
+
+        // Errors -1/8, -5/8, 3/8, 5/8, 1/4, -5/8, -1/4, 1/8
+        POLANN_CHECK_NEAR(metrics.loss, 1.46875 / 8.0, 1e-6);
+        POLANN_CHECK_NEAR(metrics.rmse, std::sqrt(1.46875 / 8.0), 1e-6);
+        POLANN_CHECK_NEAR(metrics.mae, 3.0 / 8.0, 1e-6);
+
+        // Thresholded at 0.5, samples 1, 3 and 5 are wrong
+        POLANN_CHECK_NEAR(metrics.accuracy, 5.0 / 8.0, 1e-6);
+
+        // Of 16 positive-negative pairs, 12 are ordered and two positives at 0.375
+        // tie with the negative at 0.375, counting half each
+        POLANN_CHECK_NEAR(metrics.auc, 13.0 / 16.0, 1e-6);
+    }
+}
+
+POLANN_TEST(evaluateUsesArgmaxForSeveralOutputs)
+{
+    using Row = std::array<float, 3>;
+    std::array<Row, 4> predictions = {Row{0.5f, 0.25f, 0.25f}, Row{0.125f, 0.75f, 0.125f},
+                                      Row{0.25f, 0.25f, 0.5f}, Row{0.0f, 0.625f, 0.375f}};
+    std::array<Row, 4> labels = {Row{1.0f, 0.0f, 0.0f}, Row{0.0f, 0.0f, 1.0f},
+                                 Row{0.0f, 0.0f, 1.0f}, Row{0.0f, 1.0f, 0.0f}};
+    auto dataset = repeated(predictions, labels);
+    auto model = passThrough<3>();
+    core::ThreadPool pool(4);
+
+    auto metrics = model.evaluate(dataset, 64, pool);
+    POLANN_CHECK(metrics.samples == 200);
+
+    // Squared errors per sample sum to 0.375, 1.34375, 0.375 and 0.28125 over 3 outputs
+    POLANN_CHECK_NEAR(metrics.loss, 2.375 / 12.0, 1e-6);
+    POLANN_CHECK_NEAR(metrics.rmse, std::sqrt(2.375 / 12.0), 1e-6);
+    POLANN_CHECK_NEAR(metrics.mae, 4.5 / 12.0, 1e-6);
+
+    // Only sample 1 picks the wrong output
+    POLANN_CHECK_NEAR(metrics.accuracy, 3.0 / 4.0, 1e-6);
+
+    // Per-output AUC 1, 2/3 and 1/2, macro-averaged; the output 1 tie is between negatives
+    POLANN_CHECK_NEAR(metrics.auc, (1.0 + 2.0 / 3.0 + 0.5) / 3.0, 1e-6);
+}
+
+POLANN_TEST(evaluateWithoutAucKeepsOtherMetrics)
+{
+    auto dataset = circleDataset(3000);
+    Model model = makeModel();
+
+    // Several batches and chunks, so partial accumulators are merged
+    auto full = model.evaluate(dataset, 512);
+    auto lossOnly = model.evaluate(dataset, 512, core::ThreadPool::global(), false);
+
+    POLANN_CHECK(!std::isnan(full.auc));
+    POLANN_CHECK(std::isnan(lossOnly.auc));
+    POLANN_CHECK(lossOnly.loss == full.loss);
+    POLANN_CHECK(lossOnly.accuracy == full.accuracy);
+    POLANN_CHECK(lossOnly.mae == full.mae);
+    POLANN_CHECK(lossOnly.rmse == full.rmse);
+    POLANN_CHECK(lossOnly.samples == full.samples);
+}
+
+POLANN_TEST(earlyStoppingTracksValidationLoss)
+{
+    auto train = circleDataset(512);
+    auto validation = circleDataset(256);
+    Model model = makeModel();
+    optimizers::SGD optimizer(0.5f);
+
+    callbacks::EarlyStopping<core::Dataset<2, 1>> stopping(validation, 3);
+    model.fit(train, optimizer, 30, 32, true, false, stopping);
+
+    // The best checkpoint is restored at the end
+    POLANN_CHECK(stopping.bestLoss() < 1.0f);
+    POLANN_CHECK_NEAR(model.evaluate(validation).loss, stopping.bestLoss(), 1e-5);
+}
+
+POLANN_TEST(nanPredictionsGiveNanAuc)
+{
+    auto dataset = circleDataset(64);
+    Model model = makeModel();
+
+    // A NaN step poisons every weight, as a diverged training run would
+    optimizers::SGD optimizer(std::numeric_limits<float>::quiet_NaN());
+    model.fit(dataset, optimizer, 1, 16, false, false);
+
+    auto metrics = model.evaluate(dataset);
+    POLANN_CHECK(std::isnan(metrics.loss));
+    POLANN_CHECK(std::isnan(metrics.auc));
+    POLANN_CHECK(metrics.samples == 64);
+}
@@ -0,0 +1,223 @@
+#include "harness.hpp"
+
+#include <span>
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include "polann/c_api.h"
+#include "polann/core/normalizer.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/model_format.hpp"
+#include "polann/models/nn.hpp"
+
+using namespace polann;
+
+namespace
+{
+    std::string savedModel(bool withNormalizer)
+    {
+        models::DynamicNN model(3);
+        model.addLayer(5, utils::ActivationKind::ReLU).addLayer(2, utils::ActivationKind::Sigmoid);
+        model.initialize(3);
+        if (withNormalizer)
+        {
+            core::Normalizer<3> normalizer;
+            normalizer.shift = {0.5f, -1.0f, 2.0f};
+            normalizer.scale = {2.0f, 0.5f, 1.0f};
+            model.setNormalizer(normalizer);
+        }
+
+        std::ostringstream os;
+        model.save(os);
+        return os.str();
+    }
+
+    // One-layer model file with a hand-written layer shape and no normalizer
+    std::string modelWithShape(uint64_t inputSize, uint64_t outputSize, size_t trailingFloats)
+    {
+        std::string bytes(models::modelMagic, sizeof(models::modelMagic));
+        auto append = [&](const auto &value) { bytes.append(reinterpret_cast<const char *>(&value), sizeof(value)); };
+        append(models::modelFormatVersion);
+        append(uint32_t{1});
+        append(inputSize);
+        append(outputSize);
+        append(static_cast<uint8_t>(utils::ActivationKind::ReLU));
+        bytes.append(trailingFloats * sizeof(float), '\0');
+        bytes.push_back('\0');
+        return bytes;
+    }
+
+    polann_status loadFromMemory(const std::string &bytes)
+    {
+        polann_model *model = reinterpret_cast<polann_model *>(&model); // Must be reset on failure
+        polann_status status = polann_model_load_memory(bytes.data(), bytes.size(), &model);
+        POLANN_CHECK((status == POLANN_OK) == (model != nullptr));
+        polann_model_free(model);
+        return status;
+    }
+
+} // namespace
+
+POLANN_TEST(validModelsLoad)
+{
+    POLANN_CHECK(loadFromMemory(savedModel(false)) == POLANN_OK);
+    POLANN_CHECK(loadFromMemory(savedModel(true)) == POLANN_OK);
+    POLANN_CHECK(loadFromMemory(modelWithShape(4, 2, 4 * 2 + 2)) == POLANN_OK);
+}
+
+POLANN_TEST(truncatedModelsAreRejected)
+{
+    for (bool withNormalizer : {false, true})
+    {
+        std::string bytes = savedModel(withNormalizer);
+        for (size_t length = 0; length < bytes.size(); ++length)
+        {
+            polann_status status = loadFromMemory(bytes.substr(0, length));
+            POLANN_CHECK(status == POLANN_ERROR_FORMAT);
+        }
+    }
+}
+
+POLANN_TEST(oversizedShapesAreRejected)
+{
+    constexpr uint64_t huge = uint64_t{1} << 62;
+    constexpr uint64_t maximum = (std::numeric_limits<uint64_t>::max)();
+
+    // Products that overflow size_t, or that are far larger than the file
+    POLANN_CHECK(loadFromMemory(modelWithShape(huge, 4, 4)) == POLANN_ERROR_FORMAT);
+    POLANN_CHECK(loadFromMemory(modelWithShape(4, huge, 4)) == POLANN_ERROR_FORMAT);
+    POLANN_CHECK(loadFromMemory(modelWithShape(maximum, 1, 4)) == POLANN_ERROR_FORMAT);
+    POLANN_CHECK(loadFromMemory(modelWithShape(uint64_t{1} << 32, uint64_t{1} << 32, 4)) == POLANN_ERROR_FORMAT);
+    POLANN_CHECK(loadFromMemory(modelWithShape(1 << 20, 1 << 10, 4)) == POLANN_ERROR_FORMAT);
+
+    // Empty layers
+    POLANN_CHECK(loadFromMemory(modelWithShape(0, 4, 4)) == POLANN_ERROR_FORMAT);
+    POLANN_CHECK(loadFromMemory(modelWithShape(4, 0, 4)) == POLANN_ERROR_FORMAT);
+}
+
+POLANN_TEST(corruptLoadLeavesModelUnchanged)
+{
+    models::DynamicNN model(3);
+    model.addLayer(4, utils::ActivationKind::Tanh);
+    model.initialize(1);
+    std::vector<float> input = {0.1f, 0.2f, 0.3f};
+    std::vector<float> before = model.predict(input);
+    uint64_t revision = model.parameterRevision();
+
+    std::istringstream oversized(modelWithShape(uint64_t{1} << 62, 4, 4));
+    POLANN_CHECK_THROWS(model.load(oversized), std::runtime_error);
+
+    std::string bytes = savedModel(true);
+    std::istringstream truncated(bytes.substr(0, bytes.size() - 1));
+    POLANN_CHECK_THROWS(model.load(truncated), std::runtime_error);
+
+    POLANN_CHECK(model.parameterRevision() == revision);
+    POLANN_CHECK(model.predict(input) == before);
+}
+
+POLANN_TEST(unknownNormalizationModeIsRejected)
+{
+    // The mode byte follows the normalizer flag and feature count at the end of the layers
+    std::string bytes = savedModel(true);
+    size_t modeOffset = bytes.size() - 2 * 3 * sizeof(float) - 1;
+    bytes[modeOffset] = 7;
+    POLANN_CHECK(loadFromMemory(bytes) == POLANN_ERROR_FORMAT);
+}
+
+POLANN_TEST(failedNNLoadLeavesModelUnchanged)
+{
+    using Model = models::NN<layers::Dense<utils::ReLU, 3, 6>, layers::Dense<utils::Sigmoid, 6, 2>>;
+    auto makeModel = [](uint32_t seed)
+    {
+        Model model{layers::Dense<utils::ReLU, 3, 6>(), layers::Dense<utils::Sigmoid, 6, 2>()};
+        model.initialize(seed);
+        core::Normalizer<3> normalizer;
+        normalizer.shift = {0.5f, -1.0f, 2.0f};
+        normalizer.scale = {2.0f, 0.5f, 1.0f};
+        model.setNormalizer(normalizer);
+        return model;
+    };
+
+    std::ostringstream os;
+    makeModel(2).save(os);
+    std::string other = os.str();
+
+    Model model = makeModel(1);
+    model.finalizeForInference();
+    std::array<float, 3> input = {0.1f, -0.4f, 0.9f};
+    auto before = model.predict(input);
+    uint64_t revision = model.parameterRevision();
+
+    // Every truncation point, including inside the second layer and the normalizer
+    for (size_t length = 0; length < other.size(); ++length)
+    {
+        std::istringstream truncated(other.substr(0, length));
+        POLANN_CHECK_THROWS(model.load(truncated), std::runtime_error);
+    }
+    POLANN_CHECK(model.parameterRevision() == revision);
+    POLANN_CHECK(model.predict(input) == before);
+    POLANN_CHECK(model.getNormalizer().has_value());
+
+    // A complete file still loads, re-packs and bumps the revision
+    std::istringstream complete(other);
+    model.load(complete);
+    POLANN_CHECK(model.isPacked());
+    POLANN_CHECK(model.parameterRevision() != revision);
+    Model reference = makeModel(2);
+    reference.finalizeForInference();
+    POLANN_CHECK(model.predict(input) == reference.predict(input));
+}
+
+POLANN_TEST(cPredictBatchMatchesDynamicNN)
+{
+    constexpr size_t rows = 37;
+    std::string bytes = savedModel(true);
+
+    models::DynamicNN reference;
+    std::istringstream stream(bytes);
+    reference.load(stream);
+
+    polann_model *model = nullptr;
+    POLANN_REQUIRE(polann_model_load_memory(bytes.data(), bytes.size(), &model) == POLANN_OK);
+    POLANN_CHECK(polann_model_input_size(model) == 3);
+    POLANN_CHECK(polann_model_output_size(model) == 2);
+
+    std::vector<float> inputs(rows * 3);
+    for (size_t i = 0; i < inputs.size(); ++i)
+        inputs[i] = 0.1f * static_cast<float>(i % 17) - 0.8f;
+
+    std::vector<float> outputs(rows * 2);
+    std::vector<float> expected(rows * 2);
+    POLANN_CHECK(polann_predict_batch(model, inputs.data(), rows, outputs.data()) == POLANN_OK);
+    reference.predictBatch(inputs, expected);
+    for (size_t i = 0; i < outputs.size(); ++i)
+        POLANN_CHECK_NEAR(outputs[i], expected[i], 1e-6f);
+
+    // Zero rows needs no buffers
+    POLANN_CHECK(polann_predict_batch(model, nullptr, 0, nullptr) == POLANN_OK);
+    polann_model_free(model);
+}
+
+POLANN_TEST(cPredictBatchRejectsOverflowingRows)
+{
+    std::string bytes = savedModel(false);
+    polann_model *model = nullptr;
+    POLANN_REQUIRE(polann_model_load_memory(bytes.data(), bytes.size(), &model) == POLANN_OK);
+
+    // rows * 3 inputs wraps around to a small count
+    constexpr size_t maximum = (std::numeric_limits<size_t>::max)();
+    float input[3] = {};
+    float output[2] = {};
+    POLANN_CHECK(polann_predict_batch(model, input, maximum / 3 + 1, output) == POLANN_ERROR_INVALID_ARGUMENT);
+    POLANN_CHECK(polann_predict_batch(model, input, maximum, output) == POLANN_ERROR_INVALID_ARGUMENT);
+    POLANN_CHECK(std::string(polann_last_error()).find("rows") != std::string::npos);
+
+    POLANN_CHECK(polann_predict_batch(nullptr, input, 1, output) == POLANN_ERROR_INVALID_ARGUMENT);
+    POLANN_CHECK(polann_predict_batch(model, input, 1, output) == POLANN_OK);
+    polann_model_free(model);
+}
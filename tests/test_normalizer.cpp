@@ -0,0 +1,182 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    constexpr size_t features = 4;
+    constexpr size_t samples = 1037; // Not a multiple of any pool's chunk count
+
+    // Column 3 is constant to exercise the unscaled path
+    core::Dataset<features, 1> makeDataset()
+    {
+        core::Dataset<features, 1> dataset;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            float x = static_cast<float>(i);
+            dataset.addSample(std::array<float, features>{std::sin(0.1f * x) * 3.0f + 10.0f, 0.001f * x * x, -x, 2.5f},
+                              std::array<float, 1>{0.0f});
+        }
+        return dataset;
+    }
+
+    // Textbook two-pass statistics in double precision
+    struct Reference
+    {
+        std::array<double, features> mean{};
+        std::array<double, features> stddev{};
+        std::array<float, features> min{};
+        std::array<float, features> max{};
+
+        explicit Reference(const core::Dataset<features, 1> &dataset)
+        {
+            for (size_t j = 0; j < features; ++j)
+            {
+                min[j] = max[j] = dataset.inputRow(0)[j];
+                double sum = 0.0;
+                for (size_t i = 0; i < dataset.size(); ++i)
+                {
+                    float value = dataset.inputRow(i)[j];
+                    sum += value;
+                    min[j] = (std::min)(min[j], value);
+                    max[j] = (std::max)(max[j], value);
+                }
+                mean[j] = sum / static_cast<double>(dataset.size());
+
+                double squares = 0.0;
+                for (size_t i = 0; i < dataset.size(); ++i)
+                {
+                    double delta = dataset.inputRow(i)[j] - mean[j];
+                    squares += delta * delta;
+                }
+                stddev[j] = std::sqrt(squares / static_cast<double>(dataset.size()));
+            }
+        }
+    };
+
+    core::Normalizer<features> sampleNormalizer()
+    {
+        core::Normalizer<features> normalizer;
+        normalizer.shift = {10.0f, 0.5f, -500.0f, 2.5f};
+        normalizer.scale = {0.47f, 1.3f, 0.002f, 1.0f};
+        return normalizer;
+    }
+
+} // namespace
+
+POLANN_TEST(fitMatchesTwoPassStatistics)
+{
+    auto dataset = makeDataset();
+    Reference reference(dataset);
+
+    for (size_t workers : {0, 1, 3, 7})
+    {
+        core::ThreadPool pool(workers);
+
+        auto zscore = core::Normalizer<features>::fit(dataset, core::NormalizationMode::ZScore, pool);
+        POLANN_CHECK(zscore.mode == core::NormalizationMode::ZScore);
+        for (size_t j = 0; j < 3; ++j)
+        {
+            POLANN_CHECK_NEAR(zscore.shift[j], reference.mean[j], 1e-6);
+            POLANN_CHECK_NEAR(zscore.scale[j], 1.0 / reference.stddev[j], 1e-6);
+        }
+        POLANN_CHECK(zscore.shift[3] == 2.5f);
+        POLANN_CHECK(zscore.scale[3] == 1.0f);
+
+        auto minMax = core::Normalizer<features>::fit(dataset, core::NormalizationMode::MinMax, pool);
+        POLANN_CHECK(minMax.mode == core::NormalizationMode::MinMax);
+        for (size_t j = 0; j < 3; ++j)
+        {
+            POLANN_CHECK(minMax.shift[j] == reference.min[j]);
+            POLANN_CHECK_NEAR(minMax.scale[j], 1.0 / (static_cast<double>(reference.max[j]) - reference.min[j]), 1e-6);
+        }
+        POLANN_CHECK(minMax.shift[3] == 2.5f);
+        POLANN_CHECK(minMax.scale[3] == 1.0f);
+    }
+
+    // A single sample has no spread in any column
+    core::Dataset<features, 1> single;
+    single.addSample(std::array<float, features>{1.0f, 2.0f, 3.0f, 4.0f}, std::array<float, 1>{0.0f});
+    auto one = core::Normalizer<features>::fit(single);
+    POLANN_CHECK(one.shift == (std::array<float, features>{1.0f, 2.0f, 3.0f, 4.0f}));
+    POLANN_CHECK(one.scale == (std::array<float, features>{1.0f, 1.0f, 1.0f, 1.0f}));
+
+    POLANN_CHECK_THROWS(core::Normalizer<features>::fit(core::Dataset<features, 1>{}), std::invalid_argument);
+}
+
+POLANN_TEST(batchesApplyTheNormalizerExactly)
+{
+    auto dataset = makeDataset();
+    auto normalizer = sampleNormalizer();
+
+    size_t batchSize = 100;
+    for (size_t batch = 0; batch < dataset.numBatches(batchSize); ++batch)
+    {
+        auto [inputs, outputs] = dataset.getBatch(batch, batchSize, &normalizer);
+        size_t rows = inputs.size() / features;
+        POLANN_CHECK(rows == (std::min)(batchSize, samples - batch * batchSize));
+
+        bool exact = true;
+        for (size_t r = 0; r < rows; ++r)
+        {
+            auto raw = dataset.inputRow(dataset.indices[batch * batchSize + r]);
+            for (size_t j = 0; j < features; ++j)
+                exact &= inputs[r * features + j] == (raw[j] - normalizer.shift[j]) * normalizer.scale[j];
+        }
+        POLANN_CHECK(exact);
+    }
+}
+
+POLANN_TEST(predictAppliesTheNormalizerExactly)
+{
+    using Model = models::NN<layers::Dense<utils::Tanh, features, 6>, layers::Dense<utils::Identity, 6, 2>>;
+    auto makeModel = []
+    {
+        Model model{layers::Dense<utils::Tanh, features, 6>(), layers::Dense<utils::Identity, 6, 2>()};
+        model.initialize(5);
+        return model;
+    };
+
+    auto normalizer = sampleNormalizer();
+    Model withNormalizer = makeModel();
+    withNormalizer.setNormalizer(normalizer);
+    Model plain = makeModel();
+
+    auto dataset = makeDataset();
+    std::vector<float> raw(dataset.inputs.begin(), dataset.inputs.begin() + 50 * features);
+    std::vector<float> normalized(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i)
+        normalized[i] = (raw[i] - normalizer.shift[i % features]) * normalizer.scale[i % features];
+
+    for (size_t r = 0; r < 50; ++r)
+    {
+        std::array<float, features> rawRow, normalizedRow;
+        std::copy_n(raw.begin() + r * features, features, rawRow.begin());
+        std::copy_n(normalized.begin() + r * features, features, normalizedRow.begin());
+        POLANN_CHECK(withNormalizer.predict(rawRow) == plain.predict(normalizedRow));
+    }
+
+    std::vector<float> viaModel(50 * 2), viaHand(50 * 2);
+    withNormalizer.predictBatch(raw, viaModel);
+    plain.predictBatch(normalized, viaHand);
+    POLANN_CHECK(viaModel == viaHand);
+
+    // Packed weights take the same normalized inputs
+    withNormalizer.finalizeForInference();
+    plain.finalizeForInference();
+    withNormalizer.predictBatch(raw, viaModel);
+    plain.predictBatch(normalized, viaHand);
+    POLANN_CHECK(viaModel == viaHand);
+}
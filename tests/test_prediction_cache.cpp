@@ -0,0 +1,199 @@
+#include "harness.hpp"
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <sstream>
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/models/prediction_cache.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::Tanh, 2, 4>, layers::Dense<utils::Sigmoid, 4, 1>>;
+
+    Model makeModel(uint32_t seed)
+    {
+        Model model{layers::Dense<utils::Tanh, 2, 4>(), layers::Dense<utils::Sigmoid, 4, 1>()};
+        model.initialize(seed);
+        return model;
+    }
+
+    std::array<float, 2> point(float x) { return {x, 1.0f - x}; }
+
+} // namespace
+
+POLANN_TEST(hitsAndMissesAreCounted)
+{
+    Model model = makeModel(1);
+    models::PredictionCache cache(model, {.capacity = 64, .shards = 4});
+
+    POLANN_CHECK(cache.predict(point(0.1f)) == model.predict(point(0.1f)));
+    POLANN_CHECK(cache.predict(point(0.2f)) == model.predict(point(0.2f)));
+    POLANN_CHECK(cache.predict(point(0.1f)) == model.predict(point(0.1f)));
+    POLANN_CHECK(cache.counters().misses == 2);
+    POLANN_CHECK(cache.counters().hits == 1);
+
+    // A batch mixing cached and new rows, one of them repeated within the batch
+    std::vector<float> inputs = {0.1f, 0.9f, 0.3f, 0.7f, 0.2f, 0.8f, 0.3f, 0.7f};
+    std::vector<float> cached(4), direct(4);
+    cache.predictBatch(inputs, cached);
+    model.predictBatch(inputs, direct);
+    POLANN_CHECK(cached == direct);
+    POLANN_CHECK(cache.counters().hits == 3);
+    POLANN_CHECK(cache.counters().misses == 4);
+    POLANN_CHECK_NEAR(cache.counters().hitRate(), 3.0 / 7.0, 1e-12);
+
+    cache.resetCounters();
+    POLANN_CHECK(cache.counters().hits == 0 && cache.counters().misses == 0);
+
+    cache.clear();
+    (void)cache.predict(point(0.1f));
+    POLANN_CHECK(cache.counters().misses == 1);
+}
+
+POLANN_TEST(clockEvictsUnreferencedEntriesAtCapacity)
+{
+    Model model = makeModel(2);
+    models::PredictionCache cache(model, {.capacity = 4, .shards = 1});
+    POLANN_CHECK(cache.capacity() == 4);
+
+    for (float x : {0.0f, 1.0f, 2.0f, 3.0f})
+        (void)cache.predict(point(x));
+    (void)cache.predict(point(0.0f)); // Referenced, so the hand skips it once
+
+    // The fifth entry takes the first unreferenced slot
+    (void)cache.predict(point(4.0f));
+    cache.resetCounters();
+
+    (void)cache.predict(point(0.0f));
+    (void)cache.predict(point(4.0f));
+    (void)cache.predict(point(2.0f));
+    (void)cache.predict(point(3.0f));
+    POLANN_CHECK(cache.counters().hits == 4);
+    POLANN_CHECK(cache.counters().misses == 0);
+
+    (void)cache.predict(point(1.0f));
+    POLANN_CHECK(cache.counters().misses == 1);
+}
+
+POLANN_TEST(fitInvalidatesEntries)
+{
+    Model model = makeModel(3);
+    models::PredictionCache cache(model, {.capacity = 16, .shards = 2});
+    (void)cache.predict(point(0.5f));
+
+    core::Dataset<2, 1> dataset;
+    dataset.addSample(point(0.5f), std::array<float, 1>{1.0f});
+    optimizers::SGD optimizer(0.5f);
+    model.fit(dataset, optimizer, 1, 1, false, false);
+
+    POLANN_CHECK(cache.predict(point(0.5f)) == model.predict(point(0.5f)));
+    POLANN_CHECK(cache.counters().hits == 0);
+    POLANN_CHECK(cache.counters().misses == 2);
+}
+
+POLANN_TEST(loadInvalidatesEntries)
+{
+    Model model = makeModel(4);
+    std::stringstream other;
+    makeModel(5).save(other);
+
+    models::PredictionCache cache(model, {.capacity = 16, .shards = 2});
+    auto before = cache.predict(point(0.5f));
+    model.load(other);
+
+    auto after = cache.predict(point(0.5f));
+    POLANN_CHECK(after == model.predict(point(0.5f)));
+    POLANN_CHECK(after != before);
+    POLANN_CHECK(cache.counters().hits == 0);
+}
+
+POLANN_TEST(normalizerChangeInvalidatesEntries)
+{
+    models::DynamicNN model(2);
+    model.addLayer(3, utils::ActivationKind::Tanh).addLayer(1, utils::ActivationKind::Identity);
+    model.initialize(6);
+    models::PredictionCache cache(model, {.capacity = 16, .shards = 2});
+
+    std::vector<float> input = {0.25f, 0.75f};
+    auto before = cache.predict(input);
+    POLANN_CHECK(cache.predict(input) == before);
+    POLANN_CHECK(cache.counters().hits == 1);
+
+    core::Normalizer<2> normalizer;
+    normalizer.shift = {1.0f, -1.0f};
+    normalizer.scale = {2.0f, 0.5f};
+    model.setNormalizer(normalizer);
+
+    auto after = cache.predict(input);
+    POLANN_CHECK(after == model.predict(input));
+    POLANN_CHECK(after != before);
+    POLANN_CHECK(cache.counters().hits == 1);
+    POLANN_CHECK(cache.counters().misses == 2);
+}
+
+POLANN_TEST(assignmentInvalidatesEntries)
+{
+    // Both models were initialized once, so per-model counters would agree
+    using Linear = models::NN<layers::Dense<utils::Identity, 2, 1>>;
+    Linear a{layers::Dense<utils::Identity, 2, 1>()};
+    Linear b{layers::Dense<utils::Identity, 2, 1>()};
+    a.initialize(1);
+    b.initialize(2);
+    POLANN_CHECK(a.parameterRevision() != b.parameterRevision());
+
+    models::PredictionCache cache(a, {.capacity = 16, .shards = 2});
+    auto before = cache.predict(point(0.5f));
+
+    a = b;
+    auto after = cache.predict(point(0.5f));
+    POLANN_CHECK(after == b.predict(point(0.5f)));
+    POLANN_CHECK(after != before);
+    POLANN_CHECK(cache.counters().hits == 0);
+
+    // Moving in another model, and copies in general, also get a fresh revision
+    Linear c = b;
+    POLANN_CHECK(c.parameterRevision() != b.parameterRevision());
+    a = std::move(c);
+    (void)cache.predict(point(0.5f));
+    POLANN_CHECK(cache.counters().hits == 0);
+}
+
+POLANN_TEST(loadFromAnotherModelInvalidatesEntries)
+{
+    // Two runtime-shaped models with identical histories
+    auto make = [](uint32_t seed)
+    {
+        models::DynamicNN model(2);
+        model.addLayer(3, utils::ActivationKind::Tanh).addLayer(1, utils::ActivationKind::Identity);
+        model.initialize(seed);
+        return model;
+    };
+    models::DynamicNN a = make(7);
+    models::DynamicNN b = make(8);
+
+    models::PredictionCache cache(a, {.capacity = 16, .shards = 2});
+    std::vector<float> input = {0.25f, 0.75f};
+    auto before = cache.predict(input);
+
+    std::stringstream bytes;
+    b.save(bytes);
+    a.load(bytes);
+    auto after = cache.predict(input);
+    POLANN_CHECK(after == b.predict(input));
+    POLANN_CHECK(after != before);
+
+    // Assigning a DynamicNN invalidates as well
+    a = make(9);
+    POLANN_CHECK(cache.predict(input) == a.predict(input));
+    POLANN_CHECK(cache.counters().hits == 0);
+    POLANN_CHECK(cache.counters().misses == 3);
+}
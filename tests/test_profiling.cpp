@@ -0,0 +1,125 @@
+#include "harness.hpp"
+
+#include <array>
+#include <tuple>
+#include <optional>
+#include "polann/core/dataset.hpp"
+#include "polann/core/normalizer.hpp"
+#include "polann/core/thread_pool.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/models/revision.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+// Built twice: as configured, and as test_profiling_enabled with POLANN_ENABLE_PROFILING
+
+using namespace polann;
+
+namespace
+{
+    using Hidden = layers::Dense<utils::Tanh, 3, 5>;
+    using Output = layers::Dense<utils::Sigmoid, 5, 2>;
+    using Model = models::NN<Hidden, Output>;
+
+    Model makeModel()
+    {
+        Model model{Hidden(), Output()};
+        model.initialize(3);
+        return model;
+    }
+
+    core::Dataset<3, 2> makeDataset(size_t samples)
+    {
+        core::Dataset<3, 2> dataset;
+        for (size_t i = 0; i < samples; ++i)
+        {
+            float x = static_cast<float>(i);
+            dataset.addSample(std::array<float, 3>{x, -x, 0.5f * x}, std::array<float, 2>{1.0f, 0.0f});
+        }
+        return dataset;
+    }
+
+    bool matches(const utils::TimingStats &stats, uint64_t calls, uint64_t flops, uint64_t bytes)
+    {
+        return stats.calls == calls && stats.flops == flops && stats.bytes == bytes;
+    }
+
+} // namespace
+
+#ifdef POLANN_ENABLE_PROFILING
+
+POLANN_TEST(trainingCountsEveryLayerPass)
+{
+    Model model = makeModel();
+    auto dataset = makeDataset(10);
+    optimizers::SGD optimizer(0.1f);
+
+    // 2 epochs of batches with 4, 4 and 2 rows
+    model.fit(dataset, optimizer, 2, 4, false, false);
+
+    utils::Profile profile = model.profile();
+    POLANN_REQUIRE(profile.layers.size() == 2);
+    POLANN_CHECK(matches(profile.layers[0].forward, 6, 20 * Hidden::forwardFlops, 20 * Hidden::forwardBytes));
+    POLANN_CHECK(matches(profile.layers[0].backward, 6, 20 * Hidden::backwardFlops, 20 * Hidden::backwardBytes));
+    POLANN_CHECK(matches(profile.layers[1].forward, 6, 20 * Output::forwardFlops, 20 * Output::forwardBytes));
+    POLANN_CHECK(matches(profile.layers[1].backward, 6, 20 * Output::backwardFlops, 20 * Output::backwardBytes));
+    POLANN_CHECK(profile.getBatch.calls == 6);
+    POLANN_CHECK(profile.loss.calls == 6);
+    POLANN_CHECK(profile.optimizerStep.calls == 6);
+}
+
+POLANN_TEST(inferenceCountsForwardPassesOnly)
+{
+    Model model = makeModel();
+    auto dataset = makeDataset(10);
+    optimizers::SGD optimizer(0.1f);
+    model.fit(dataset, optimizer, 1, 10, false, false);
+    model.resetProfile();
+    POLANN_CHECK(matches(model.profile().layers[0].forward, 0, 0, 0));
+
+    // Without workers every evaluate batch is one forward call per layer
+    core::ThreadPool pool(0);
+    (void)model.evaluate(dataset, 4, pool);
+    (void)model.predict(std::array<float, 3>{1.0f, 2.0f, 3.0f});
+
+    utils::Profile profile = model.profile();
+    POLANN_CHECK(matches(profile.layers[0].forward, 4, 11 * Hidden::forwardFlops, 11 * Hidden::forwardBytes));
+    POLANN_CHECK(matches(profile.layers[1].forward, 4, 11 * Output::forwardFlops, 11 * Output::forwardBytes));
+    POLANN_CHECK(matches(profile.layers[0].backward, 0, 0, 0));
+    POLANN_CHECK(matches(profile.layers[1].backward, 0, 0, 0));
+    POLANN_CHECK(profile.getBatch.calls == 3);
+    POLANN_CHECK(profile.loss.calls == 0);
+    POLANN_CHECK(profile.optimizerStep.calls == 0);
+}
+
+#else
+
+namespace
+{
+    // NN's data members without the profiler
+    struct Unprofiled
+    {
+        std::tuple<Hidden, Output> layers;
+        std::optional<core::Normalizer<3>> normalizer;
+        models::Revision revision;
+    };
+
+    static_assert(sizeof(Model) == sizeof(Unprofiled), "NullProfiler must not add to the size of NN");
+
+} // namespace
+
+POLANN_TEST(disabledProfilingRecordsNothing)
+{
+    Model model = makeModel();
+    auto dataset = makeDataset(10);
+    optimizers::SGD optimizer(0.1f);
+    model.fit(dataset, optimizer, 2, 4, false, false);
+    (void)model.evaluate(dataset);
+
+    utils::Profile profile = model.profile();
+    POLANN_CHECK(profile.layers.empty());
+    POLANN_CHECK(matches(profile.getBatch, 0, 0, 0));
+}
+
+#endif
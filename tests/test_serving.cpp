@@ -0,0 +1,304 @@
+#include "harness.hpp"
+
+#include <span>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <filesystem>
+#include "polann/serving/histogram.hpp"
+#include "polann/serving/micro_batcher.hpp"
+#include "polann/serving/unix_socket_server.hpp"
+
+using namespace polann;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Doubles every input and records the rows of each batch it is given
+    struct RecordingModel
+    {
+        static constexpr size_t inputSize = 2;
+        static constexpr size_t outputSize = 1;
+
+        bool fail = false;
+        mutable std::mutex mutex;
+        mutable std::vector<size_t> batches;
+
+        void predictBatch(std::span<const float> inputs, std::span<float> outputs) const
+        {
+            size_t rows = inputs.size() / inputSize;
+            {
+                std::lock_guard lock(mutex);
+                batches.push_back(rows);
+            }
+            if (fail)
+                throw std::runtime_error("model failed");
+            for (size_t r = 0; r < rows; ++r)
+                outputs[r] = 2.0f * (inputs[r * 2] + inputs[r * 2 + 1]);
+        }
+
+        std::vector<size_t> recorded() const
+        {
+            std::lock_guard lock(mutex);
+            return batches;
+        }
+    };
+
+    void waitForPending(const serving::MicroBatcher<RecordingModel> &batcher, size_t rows)
+    {
+        while (batcher.pendingRows() < rows)
+            std::this_thread::sleep_for(1ms);
+    }
+
+    uint64_t firstPercentileWithMaximum(uint64_t value)
+    {
+        serving::Histogram histogram;
+        histogram.record(value);
+        histogram.record((std::numeric_limits<uint64_t>::max)());
+        return histogram.percentile(0.0);
+    }
+
+} // namespace
+
+POLANN_TEST(histogramBucketBounds)
+{
+    // Exact below 16
+    for (uint64_t v = 0; v < 16; ++v)
+        POLANN_CHECK(firstPercentileWithMaximum(v) == v);
+
+    // Above, the reported bound is at most 12.5% high, including at power-of-two edges
+    for (uint64_t v : {16ull, 17ull, 31ull, 32ull, 100ull, 1000ull, 1023ull, 1024ull, 123456789ull, 1ull << 40, (1ull << 63) + 5})
+    {
+        uint64_t bound = firstPercentileWithMaximum(v);
+        POLANN_CHECK(bound >= v);
+        POLANN_CHECK(bound - v <= v / 8);
+    }
+    POLANN_CHECK(firstPercentileWithMaximum((std::numeric_limits<uint64_t>::max)()) ==
+                 (std::numeric_limits<uint64_t>::max)());
+}
+
+POLANN_TEST(histogramPercentiles)
+{
+    serving::Histogram histogram;
+    POLANN_CHECK(histogram.percentile(0.5) == 0);
+
+    for (uint64_t v = 1; v <= 1000; ++v)
+        histogram.record(v);
+
+    POLANN_CHECK(histogram.count() == 1000);
+    POLANN_CHECK(histogram.max() == 1000);
+    POLANN_CHECK_NEAR(histogram.mean(), 500.5, 1e-12);
+    POLANN_CHECK(histogram.percentile(0.0) == 1);
+    POLANN_CHECK(histogram.percentile(1.0) == 1000);
+    for (double q : {0.5, 0.9, 0.99})
+    {
+        double exact = q * 999.0 + 1.0;
+        POLANN_CHECK(static_cast<double>(histogram.percentile(q)) >= exact - 1.0);
+        POLANN_CHECK(static_cast<double>(histogram.percentile(q)) <= exact * 1.125);
+    }
+
+    histogram.reset();
+    POLANN_CHECK(histogram.count() == 0 && histogram.max() == 0);
+}
+
+POLANN_TEST(histogramPrintKeepsStreamFormat)
+{
+    serving::Histogram histogram;
+    histogram.record(3);
+    histogram.record(4);
+
+    std::ostringstream os;
+    os << std::setprecision(4);
+    histogram.print(os, "latency", "us");
+    POLANN_CHECK(os.str().find("mean=3.5us") != std::string::npos);
+
+    // The caller's precision and float format survive
+    os.str("");
+    os << 0.987654;
+    POLANN_CHECK(os.str() == "0.9877");
+}
+
+POLANN_TEST(batchClosesAtMaxBatchRows)
+{
+    RecordingModel model;
+    serving::MicroBatcher batcher(model, {.maxBatchRows = 4, .maxWait = 10s});
+
+    auto start = std::chrono::steady_clock::now();
+    std::array<float, 2> outputs{};
+    {
+        std::vector<std::jthread> callers;
+        for (size_t c = 0; c < 2; ++c)
+            callers.emplace_back([&, c]
+            {
+                std::array<float, 4> inputs = {1.0f, 2.0f, 3.0f, static_cast<float>(c)};
+                std::array<float, 2> rows{};
+                batcher.predict(inputs, rows);
+                outputs[c] = rows[1];
+            });
+    }
+
+    // Both two-row requests fill the batch long before maxWait
+    POLANN_CHECK(std::chrono::steady_clock::now() - start < 5s);
+    POLANN_CHECK(model.recorded() == std::vector<size_t>{4});
+    POLANN_CHECK(outputs[0] == 6.0f && outputs[1] == 8.0f);
+
+    // A request larger than maxBatchRows runs as a batch of its own
+    std::vector<float> large(2 * 6, 1.0f);
+    std::vector<float> largeOut(6);
+    batcher.predict(large, largeOut);
+    POLANN_CHECK(model.recorded().back() == 6);
+    POLANN_CHECK(largeOut[5] == 4.0f);
+}
+
+POLANN_TEST(batchClosesAtMaxWait)
+{
+    RecordingModel model;
+    serving::MicroBatcher batcher(model, {.maxBatchRows = 64, .maxWait = 20ms});
+
+    std::array<float, 2> input = {0.5f, 0.25f};
+    std::array<float, 1> output{};
+    auto start = std::chrono::steady_clock::now();
+    batcher.predict(input, output);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    POLANN_CHECK(elapsed >= 20ms);
+    POLANN_CHECK(elapsed < 5s);
+    POLANN_CHECK(output[0] == 1.5f);
+    POLANN_CHECK(model.recorded() == std::vector<size_t>{1});
+    POLANN_CHECK(batcher.stats().batchRows.count() == 1);
+    POLANN_CHECK(batcher.stats().latency.count() == 1);
+}
+
+POLANN_TEST(modelExceptionsReachEveryCaller)
+{
+    RecordingModel model;
+    model.fail = true;
+    serving::MicroBatcher batcher(model, {.maxBatchRows = 3, .maxWait = 10s});
+
+    std::atomic<size_t> failures = 0;
+    {
+        std::vector<std::jthread> callers;
+        for (size_t c = 0; c < 3; ++c)
+            callers.emplace_back([&]
+            {
+                std::array<float, 2> input = {1.0f, 1.0f};
+                std::array<float, 1> output{};
+                try
+                {
+                    batcher.predict(input, output);
+                }
+                catch (const std::runtime_error &)
+                {
+                    ++failures;
+                }
+            });
+    }
+
+    POLANN_CHECK(failures == 3);
+    POLANN_CHECK(model.recorded() == std::vector<size_t>{3});
+
+    // The worker keeps serving after a failed batch
+    model.fail = false;
+    std::vector<float> inputs(6, 1.0f), outputs(3);
+    batcher.predict(inputs, outputs);
+    POLANN_CHECK(outputs[2] == 4.0f);
+}
+
+POLANN_TEST(destructorDrainsQueuedRequests)
+{
+    RecordingModel model;
+    auto batcher = std::make_unique<serving::MicroBatcher<RecordingModel>>(
+        model, serving::BatchingOptions{.maxBatchRows = 64, .maxWait = 10s});
+
+    std::array<float, 3> outputs{};
+    std::vector<std::jthread> callers;
+    for (size_t c = 0; c < 3; ++c)
+        callers.emplace_back([&, c]
+        {
+            std::array<float, 2> input = {static_cast<float>(c), 0.0f};
+            batcher->predict(input, std::span<float>(outputs.data() + c, 1));
+        });
+
+    // Every request is queued and waiting for maxWait when the batcher goes away
+    waitForPending(*batcher, 3);
+    auto start = std::chrono::steady_clock::now();
+    batcher.reset();
+    callers.clear();
+
+    POLANN_CHECK(std::chrono::steady_clock::now() - start < 5s);
+    POLANN_CHECK(model.recorded() == std::vector<size_t>{3});
+    POLANN_CHECK(outputs[0] == 0.0f && outputs[1] == 2.0f && outputs[2] == 4.0f);
+}
+
+POLANN_TEST(oversizedOrEmptyRequestsAreRejected)
+{
+    RecordingModel model;
+    serving::MicroBatcher batcher(model);
+    std::vector<float> inputs(3), outputs(2);
+    POLANN_CHECK_THROWS(batcher.predict(inputs, outputs), std::invalid_argument);
+    POLANN_CHECK_THROWS(batcher.predict({}, outputs), std::invalid_argument);
+    POLANN_CHECK_THROWS(batcher.predict(std::span<const float>(inputs.data(), 2), {}), std::invalid_argument);
+    POLANN_CHECK_THROWS(serving::MicroBatcher(model, {.maxBatchRows = 0}), std::invalid_argument);
+}
+
+#ifdef POLANN_UNIX_SOCKETS
+POLANN_TEST(socketProtocolRoundTrip)
+{
+    RecordingModel model;
+    serving::MicroBatcher batcher(model, {.maxBatchRows = 8, .maxWait = 100us});
+    auto path = std::filesystem::temp_directory_path() / ("polann_test_" + std::to_string(::getpid()) + ".sock");
+
+    std::atomic<bool> stop = false;
+    serving::UnixSocketServer server(batcher, path);
+    std::jthread serverThread([&] { server.run(stop); });
+
+    int fd = serving::protocol::connect(path);
+
+    // Shape
+    uint32_t shape[2] = {};
+    POLANN_CHECK(serving::protocol::writeAll(fd, &serving::protocol::infoRequest, sizeof(uint32_t)));
+    POLANN_CHECK(serving::protocol::readAll(fd, shape, sizeof(shape)));
+    POLANN_CHECK(shape[0] == 2 && shape[1] == 1);
+
+    // Two rows in, two outputs back
+    uint32_t count = 4;
+    float inputs[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float outputs[2] = {};
+    uint32_t replyCount = 0;
+    POLANN_CHECK(serving::protocol::writeAll(fd, &count, sizeof(count)));
+    POLANN_CHECK(serving::protocol::writeAll(fd, inputs, sizeof(inputs)));
+    POLANN_CHECK(serving::protocol::readAll(fd, &replyCount, sizeof(replyCount)));
+    POLANN_REQUIRE(replyCount == 2);
+    POLANN_CHECK(serving::protocol::readAll(fd, outputs, sizeof(outputs)));
+    POLANN_CHECK(outputs[0] == 6.0f && outputs[1] == 14.0f);
+
+    // Statistics as text
+    std::string text;
+    POLANN_CHECK(serving::protocol::writeAll(fd, &serving::protocol::statsRequest, sizeof(uint32_t)));
+    POLANN_CHECK(serving::protocol::readText(fd, text));
+    POLANN_CHECK(text.find("latency") != std::string::npos);
+
+    // A partial row is answered with an error and ends the connection
+    uint32_t partial = 3;
+    uint32_t reply = 0;
+    POLANN_CHECK(serving::protocol::writeAll(fd, &partial, sizeof(partial)));
+    POLANN_CHECK(serving::protocol::readAll(fd, &reply, sizeof(reply)));
+    POLANN_CHECK(reply == serving::protocol::errorReply);
+    POLANN_CHECK(serving::protocol::readText(fd, text));
+    POLANN_CHECK(text.find("whole rows") != std::string::npos);
+    POLANN_CHECK(!serving::protocol::readAll(fd, &reply, sizeof(reply)));
+    ::close(fd);
+
+    stop = true;
+}
+#endif
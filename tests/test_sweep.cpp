@@ -0,0 +1,79 @@
+#include "harness.hpp"
+
+#include <cmath>
+#include <span>
+#include <vector>
+#include "polann/core/dataset.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/models/sweep.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::ReLU, 2, 16>, layers::Dense<utils::Identity, 16, 1>>;
+
+    core::Dataset<2, 1> lineDataset(size_t samples)
+    {
+        core::Dataset<2, 1> dataset;
+        dataset.addSamples(samples, [](size_t i, std::span<float, 2> in, std::span<float, 1> out)
+        {
+            in[0] = std::sin(0.7f * static_cast<float>(i));
+            in[1] = std::cos(1.3f * static_cast<float>(i));
+            out[0] = 0.5f * in[0] - 0.25f * in[1];
+        });
+        return dataset;
+    }
+
+    Model makeModel(const models::SweepConfig &)
+    {
+        return Model{layers::Dense<utils::ReLU, 2, 16>(), layers::Dense<utils::Identity, 16, 1>()};
+    }
+
+} // namespace
+
+POLANN_TEST(divergedRunsAreRankedLast)
+{
+    auto train = lineDataset(256);
+    auto validation = lineDataset(64);
+
+    // The huge learning rates blow up to a NaN loss; the others converge
+    std::vector<models::SweepConfig> configs = {
+        {.learningRate = 1e6f, .batchSize = 8, .seed = 1, .epochs = 5},
+        {.learningRate = 0.05f, .batchSize = 8, .seed = 2, .epochs = 5},
+        {.learningRate = 1e7f, .batchSize = 8, .seed = 3, .epochs = 5},
+        {.learningRate = 0.01f, .batchSize = 8, .seed = 4, .epochs = 5},
+    };
+    auto results = models::runSweep(train, validation, std::span<const models::SweepConfig>(configs), makeModel);
+
+    POLANN_REQUIRE(results.size() == configs.size());
+    POLANN_CHECK(!std::isnan(results[0].validation.loss));
+    POLANN_CHECK(!std::isnan(results[1].validation.loss));
+    POLANN_CHECK(results[0].validation.loss <= results[1].validation.loss);
+    POLANN_CHECK(std::isnan(results[2].validation.loss));
+    POLANN_CHECK(std::isnan(results[3].validation.loss));
+
+    // Stable among the diverged runs
+    POLANN_CHECK(results[2].index == 0);
+    POLANN_CHECK(results[3].index == 2);
+}
+
+POLANN_TEST(sweepIsReproducible)
+{
+    auto train = lineDataset(128);
+    auto validation = lineDataset(32);
+    std::vector<models::SweepConfig> configs = {{.learningRate = 0.05f, .batchSize = 16, .seed = 7, .epochs = 3},
+                                                {.learningRate = 0.02f, .batchSize = 4, .seed = 9, .epochs = 3}};
+
+    auto first = models::runSweep(train, validation, std::span<const models::SweepConfig>(configs), makeModel);
+    auto second = models::runSweep(train, validation, std::span<const models::SweepConfig>(configs), makeModel);
+
+    POLANN_REQUIRE(first.size() == 2 && second.size() == 2);
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        POLANN_CHECK(first[i].index == second[i].index);
+        POLANN_CHECK(first[i].validation.loss == second[i].validation.loss);
+    }
+}
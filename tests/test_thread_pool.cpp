@@ -0,0 +1,144 @@
+#include "harness.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "polann/core/thread_pool.hpp"
+
+using namespace polann;
+
+namespace
+{
+    // Runs parallelFor over [begin, end) and returns how often each index was visited
+    std::vector<int> visits(core::ThreadPool &pool, size_t begin, size_t end, size_t grain)
+    {
+        // Checks are not thread-safe, so chunks only count and the caller checks
+        std::vector<std::atomic<int>> counts(end);
+        std::atomic<int> badChunks{0};
+        pool.parallelFor(begin, end, grain, [&](size_t first, size_t last)
+        {
+            if (first >= last || last - first > (grain == 0 ? 1 : grain))
+                badChunks++;
+            for (size_t i = first; i < last; ++i)
+                counts[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        POLANN_CHECK(badChunks.load() == 0);
+
+        std::vector<int> result(end);
+        for (size_t i = 0; i < end; ++i)
+            result[i] = counts[i].load();
+        return result;
+    }
+}
+
+POLANN_TEST(parallelForCoversEveryIndexOnce)
+{
+    core::ThreadPool pool(4);
+    for (size_t grain : {0, 1, 3, 7, 64, 1000, 5000})
+    {
+        std::vector<int> counts = visits(pool, 5, 1000, grain);
+        for (size_t i = 0; i < counts.size(); ++i)
+            POLANN_CHECK(counts[i] == (i < 5 ? 0 : 1));
+    }
+
+    // Empty and reversed ranges run nothing
+    POLANN_CHECK(visits(pool, 10, 10, 4) == std::vector<int>(10, 0));
+    bool ran = false;
+    pool.parallelFor(10, 3, 1, [&](size_t, size_t) { ran = true; });
+    POLANN_CHECK(!ran);
+
+    // The overload without grain splits about once per thread
+    std::vector<std::atomic<int>> counts(777);
+    pool.parallelFor(0, counts.size(), [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+            counts[i]++;
+    });
+    for (const auto &count : counts)
+        POLANN_CHECK(count.load() == 1);
+}
+
+POLANN_TEST(parallelForRethrowsAfterAllChunks)
+{
+    core::ThreadPool pool(3);
+    std::atomic<int> running{0};
+
+    POLANN_CHECK_THROWS(pool.parallelFor(0, 200, 1, [&](size_t first, size_t)
+    {
+        ++running;
+        std::this_thread::yield();
+        if (first == 17)
+        {
+            --running;
+            throw std::runtime_error("chunk failed");
+        }
+        --running;
+    }), std::runtime_error);
+
+    // No chunk may still be running once the exception reaches the caller
+    POLANN_CHECK(running.load() == 0);
+
+    // The pool stays usable
+    POLANN_CHECK(visits(pool, 0, 100, 5) == std::vector<int>(100, 1));
+}
+
+POLANN_TEST(submitPropagatesResultsAndExceptions)
+{
+    core::ThreadPool pool(2);
+    auto value = pool.submit([] { return 42; });
+    auto failing = pool.submit([]() -> int { throw std::invalid_argument("task failed"); });
+
+    POLANN_CHECK(value.get() == 42);
+    POLANN_CHECK_THROWS(failing.get(), std::invalid_argument);
+}
+
+POLANN_TEST(nestedParallelForCompletes)
+{
+    core::ThreadPool pool(4);
+    constexpr size_t outer = 16;
+    constexpr size_t inner = 200;
+    std::vector<std::atomic<int>> counts(outer * inner);
+
+    pool.parallelFor(0, outer, 1, [&](size_t first, size_t last)
+    {
+        for (size_t o = first; o < last; ++o)
+            pool.parallelFor(0, inner, 8, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    counts[o * inner + i]++;
+            });
+    });
+
+    for (const auto &count : counts)
+        POLANN_CHECK(count.load() == 1);
+}
+
+POLANN_TEST(poolWithoutWorkersRunsInline)
+{
+    core::ThreadPool pool(0);
+    POLANN_CHECK(pool.workerCount() == 0);
+    POLANN_CHECK(pool.concurrency() == 1);
+
+    const auto caller = std::this_thread::get_id();
+    size_t chunks = 0;
+    pool.parallelFor(0, 100, 10, [&](size_t, size_t)
+    {
+        POLANN_CHECK(std::this_thread::get_id() == caller);
+        ++chunks;
+    });
+    POLANN_CHECK(chunks == 10);
+
+    // submit runs before returning, on the caller
+    bool ran = false;
+    auto future = pool.submit([&]
+    {
+        ran = std::this_thread::get_id() == caller;
+        return 7;
+    });
+    POLANN_CHECK(ran);
+    POLANN_CHECK(future.get() == 7);
+
+    POLANN_CHECK_THROWS(pool.parallelFor(0, 4, 1, [](size_t, size_t) { throw std::runtime_error("inline"); }),
+                        std::runtime_error);
+}
@@ -0,0 +1,79 @@
+#include "harness.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include "polann/utils/trace.hpp"
+
+using namespace polann;
+
+POLANN_TEST(numberedSpansAreNamedOnWrite)
+{
+    utils::TraceRecorder trace;
+    auto now = utils::TraceRecorder::Clock::now();
+    trace.record("layer", 2, ".forward", "layer", now, now);
+    trace.record("epoch ", 5, {}, "train", now, now);
+    trace.record("evaluate", "eval", now, now);
+
+    std::ostringstream os;
+    trace.write(os);
+    std::string json = os.str();
+    POLANN_CHECK(json.find("\"name\": \"layer2.forward\", \"cat\": \"layer\"") != std::string::npos);
+    POLANN_CHECK(json.find("\"name\": \"epoch 5\", \"cat\": \"train\"") != std::string::npos);
+    POLANN_CHECK(json.find("\"name\": \"evaluate\", \"cat\": \"eval\"") != std::string::npos);
+
+    trace.clear();
+    os.str("");
+    trace.write(os);
+    POLANN_CHECK(os.str().find("evaluate") == std::string::npos);
+}
+
+POLANN_TEST(writeKeepsStreamFormat)
+{
+    utils::TraceRecorder trace;
+    std::ostringstream os;
+    os << std::setprecision(2);
+    trace.write(os);
+
+    os.str("");
+    os << 1.23456;
+    POLANN_CHECK(os.str() == "1.2");
+}
+
+POLANN_TEST(writeAndClearWhileThreadsRecord)
+{
+    constexpr size_t spansPerThread = 20000;
+    utils::TraceRecorder trace;
+    std::atomic<size_t> running = 4;
+    std::vector<std::jthread> threads;
+    for (size_t t = 0; t < 4; ++t)
+        threads.emplace_back([&]
+        {
+            for (size_t i = 0; i < spansPerThread; ++i)
+            {
+                auto now = utils::TraceRecorder::Clock::now();
+                trace.record("batch ", i, {}, "train", now, now);
+            }
+            --running;
+        });
+
+    for (size_t round = 0; running.load() > 0; ++round)
+    {
+        std::ostringstream os;
+        trace.write(os);
+        POLANN_CHECK(os.str().ends_with("]}\n"));
+        if (round % 4 == 3)
+            trace.clear();
+    }
+    threads.clear();
+
+    // Spans after the last clear are all there
+    auto now = utils::TraceRecorder::Clock::now();
+    trace.record("batch ", spansPerThread, {}, "train", now, now);
+    std::ostringstream os;
+    trace.write(os);
+    POLANN_CHECK(os.str().find("\"name\": \"batch 20000\"") != std::string::npos);
+}
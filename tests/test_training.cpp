@@ -0,0 +1,89 @@
+#include "harness.hpp"
+
+#include <array>
+#include <stdexcept>
+#include "polann/callbacks/callback.hpp"
+#include "polann/core/dataset.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    using Model = models::NN<layers::Dense<utils::ReLU, 3, 8>, layers::Dense<utils::Sigmoid, 8, 2>>;
+
+    struct ThrowAtEpochEnd
+    {
+        template <typename M>
+        callbacks::Action onEpochEnd(M &, const callbacks::EpochInfo &)
+        {
+            throw std::runtime_error("callback failed");
+        }
+    };
+
+    struct ThrowingOptimizer
+    {
+        template <typename Layer>
+        void step(Layer &)
+        {
+            throw std::runtime_error("optimizer failed");
+        }
+    };
+
+    core::Dataset<3, 2> smallDataset()
+    {
+        core::Dataset<3, 2> dataset;
+        for (int i = 0; i < 16; ++i)
+        {
+            float x = static_cast<float>(i) / 16.0f;
+            dataset.addSample(std::array<float, 3>{x, 1.0f - x, 0.5f}, std::array<float, 2>{x, 1.0f - x});
+        }
+        return dataset;
+    }
+
+} // namespace
+
+POLANN_TEST(fitRestoresPackingAfterNormalExit)
+{
+    Model model{layers::Dense<utils::ReLU, 3, 8>(), layers::Dense<utils::Sigmoid, 8, 2>()};
+    model.initialize(1);
+    auto dataset = smallDataset();
+
+    model.finalizeForInference();
+    optimizers::SGD optimizer(0.1f);
+    model.fit(dataset, optimizer, 2, 4, true, false);
+    POLANN_CHECK(model.isPacked());
+
+    // An unpacked model stays unpacked
+    model.dropPackedWeights();
+    model.fit(dataset, optimizer, 1, 4, true, false);
+    POLANN_CHECK(!model.isPacked());
+}
+
+POLANN_TEST(fitRestoresPackingWhenTrainingThrows)
+{
+    Model model{layers::Dense<utils::ReLU, 3, 8>(), layers::Dense<utils::Sigmoid, 8, 2>()};
+    model.initialize(2);
+    auto dataset = smallDataset();
+    model.finalizeForInference();
+
+    optimizers::SGD optimizer(0.1f);
+    ThrowAtEpochEnd callback;
+    POLANN_CHECK_THROWS(model.fit(dataset, optimizer, 3, 4, true, false, callback), std::runtime_error);
+    POLANN_CHECK(model.isPacked());
+
+    ThrowingOptimizer failing;
+    POLANN_CHECK_THROWS(model.fit(dataset, failing, 1, 4, true, false), std::runtime_error);
+    POLANN_CHECK(model.isPacked());
+
+    // The restored packing reflects the weights trained before the exception
+    std::array<float, 3> input = {0.2f, 0.4f, 0.6f};
+    auto packed = model.predict(input);
+    model.dropPackedWeights();
+    auto unpacked = model.predict(input);
+    for (size_t o = 0; o < 2; ++o)
+        POLANN_CHECK_NEAR(packed[o], unpacked[o], 1e-5);
+}
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "polann/serving/histogram.hpp"
+#include "polann/serving/unix_socket_server.hpp"
+
+using namespace polann;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: polann_loadgen [options]\n"
+                  << "  --socket <path>        Server socket (default /tmp/polann.sock)\n"
+                  << "  --connections <n>      Concurrent clients, one request in flight each (default 16)\n"
+                  << "  --requests <n>         Requests per client (default 2000)\n"
+                  << "  --rows <n>             Rows per request (default 1)\n"
+                  << "  --distinct <n>         Draw rows from n fixed feature vectors, to exercise --cache (default 0: all fresh)\n";
+    }
+
+    /**
+     * @brief Client connection that closes its socket
+     */
+    struct Connection
+    {
+        int fd;
+
+        explicit Connection(const std::string &path) : fd(serving::protocol::connect(path)) {}
+        ~Connection() { ::close(fd); }
+
+        Connection(const Connection &) = delete;
+        Connection &operator=(const Connection &) = delete;
+
+        void send(uint32_t header)
+        {
+            if (!serving::protocol::writeAll(fd, &header, sizeof(header)))
+                throw std::runtime_error("Server closed the connection");
+        }
+
+        uint32_t receiveHeader()
+        {
+            uint32_t header = 0;
+            if (!serving::protocol::readAll(fd, &header, sizeof(header)))
+                throw std::runtime_error("Server closed the connection");
+            if (header == serving::protocol::errorReply)
+            {
+                std::string message;
+                serving::protocol::readText(fd, message);
+                throw std::runtime_error("Server error: " + message);
+            }
+            return header;
+        }
+    };
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string socketPath = "/tmp/polann.sock";
+    size_t connections = 16;
+    size_t requests = 2000;
+    size_t rows = 1;
+    size_t distinct = 0;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("Missing value for " + std::string(arg));
+                return argv[++i];
+            };
+
+            if (arg == "--socket")
+                socketPath = value();
+            else if (arg == "--connections")
+                connections = std::stoul(value());
+            else if (arg == "--requests")
+                requests = std::stoul(value());
+            else if (arg == "--rows")
+                rows = std::stoul(value());
+            else if (arg == "--distinct")
+                distinct = std::stoul(value());
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+            else
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+        }
+
+        if (connections == 0 || rows == 0)
+            throw std::invalid_argument("--connections and --rows must be positive");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        uint32_t shape[2] = {};
+        {
+            Connection probe(socketPath);
+            probe.send(serving::protocol::infoRequest);
+            if (!serving::protocol::readAll(probe.fd, shape, sizeof(shape)))
+                throw std::runtime_error("Server closed the connection");
+        }
+        const size_t inputCount = rows * shape[0];
+        const size_t outputCount = rows * shape[1];
+
+        // Shared pool of repeated feature vectors
+        std::vector<float> repeated(distinct * shape[0]);
+        std::mt19937 poolRng(12345);
+        std::uniform_real_distribution<float> poolDist(-1.0f, 1.0f);
+        for (float &x : repeated)
+            x = poolDist(poolRng);
+
+        serving::Histogram latency;
+        std::atomic<size_t> failures{0};
+        std::vector<std::jthread> clients;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t c = 0; c < connections; ++c)
+            clients.emplace_back([&, c]
+            {
+                try
+                {
+                    Connection connection(socketPath);
+                    std::mt19937 rng(static_cast<uint32_t>(c));
+                    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+                    std::vector<float> inputs(inputCount);
+                    std::vector<float> outputs(outputCount);
+
+                    for (size_t r = 0; r < requests; ++r)
+                    {
+                        if (distinct == 0)
+                            for (float &x : inputs)
+                                x = dist(rng);
+                        else
+                            for (size_t row = 0; row < rows; ++row)
+                                std::copy_n(repeated.data() + rng() % distinct * shape[0], shape[0], inputs.data() + row * shape[0]);
+
+                        auto sent = std::chrono::steady_clock::now();
+                        connection.send(static_cast<uint32_t>(inputCount));
+                        if (!serving::protocol::writeAll(connection.fd, inputs.data(), inputs.size() * sizeof(float)))
+                            throw std::runtime_error("Server closed the connection");
+                        if (connection.receiveHeader() != outputCount ||
+                            !serving::protocol::readAll(connection.fd, outputs.data(), outputs.size() * sizeof(float)))
+                            throw std::runtime_error("Malformed reply");
+
+                        auto elapsed = std::chrono::steady_clock::now() - sent;
+                        latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    failures.fetch_add(1);
+                    std::cerr << "Client " << c << ": " << e.what() << "\n";
+                }
+            });
+        clients.clear(); // Joins
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << connections << " connections x " << requests << " requests x " << rows << " rows against a "
+                  << shape[0] << " -> " << shape[1] << " model\n"
+                  << std::fixed << std::setprecision(0) << static_cast<double>(latency.count()) / seconds << " requests/s, "
+                  << static_cast<double>(latency.count() * rows) / seconds << " rows/s" << std::defaultfloat << "\n\n"
+                  << "Client round trip\n";
+        latency.print(std::cout, "latency", "us");
+
+        Connection stats(socketPath);
+        stats.send(serving::protocol::statsRequest);
+        std::string text;
+        if (serving::protocol::readText(stats.fd, text))
+            std::cout << "\nServer\n" << text;
+
+        return failures.load() == 0 ? 0 : 1;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
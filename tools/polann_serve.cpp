@@ -0,0 +1,173 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/prediction_cache.hpp"
+#include "polann/serving/micro_batcher.hpp"
+#include "polann/serving/unix_socket_server.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+
+namespace
+{
+    std::atomic<bool> stopRequested{false};
+
+    void onSignal(int) { stopRequested.store(true, std::memory_order_relaxed); }
+
+    void printUsage()
+    {
+        std::cout << "Usage: polann_serve (--model <file> | --random <shape>) [options]\n"
+                  << "  --model <file>       Serve a model saved with NN::save or DynamicNN::save\n"
+                  << "  --random <shape>     Serve random weights, e.g. 32,128,64,8 (for load tests)\n"
+                  << "  --socket <path>      Unix socket to listen on (default /tmp/polann.sock)\n"
+                  << "  --max-batch <rows>   Rows that close a micro-batch (default 64)\n"
+                  << "  --max-wait-us <n>    Longest a request waits for a batch to fill (default 200)\n"
+                  << "  --cache <entries>    Memoize predictions of repeated inputs (default 0: off)\n"
+                  << "  --stats-every <s>    Print latency histograms every s seconds (default 0: at exit only)\n";
+    }
+
+    // ReLU hidden layers and a sigmoid output, as in the examples
+    models::DynamicNN randomModel(std::string_view shape)
+    {
+        std::vector<size_t> sizes;
+        std::istringstream stream{std::string(shape)};
+        for (std::string item; std::getline(stream, item, ',');)
+            sizes.push_back(std::stoul(item));
+        if (sizes.size() < 2)
+            throw std::invalid_argument("--random needs at least an input and an output size");
+
+        models::DynamicNN model(sizes.front());
+        for (size_t i = 1; i < sizes.size(); ++i)
+            model.addLayer(sizes[i], i + 1 == sizes.size() ? utils::ActivationKind::Sigmoid : utils::ActivationKind::ReLU);
+        return model;
+    }
+
+    template <typename Model>
+    void serve(const Model &model, const std::string &socketPath, const serving::BatchingOptions &options, double statsEvery)
+    {
+        serving::MicroBatcher batcher(model, options);
+        serving::UnixSocketServer server(batcher, socketPath);
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+
+        std::cout << "Serving " << batcher.inputSize() << " -> " << batcher.outputSize() << " on " << socketPath
+                  << " (max batch " << options.maxBatchRows << " rows, max wait " << options.maxWait.count() << " us)\n";
+
+        std::jthread reporter;
+        if (statsEvery > 0.0)
+            reporter = std::jthread([&](std::stop_token stop)
+            {
+                auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(statsEvery));
+                auto next = std::chrono::steady_clock::now() + interval;
+                while (!stop.stop_requested())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    if (std::chrono::steady_clock::now() < next)
+                        continue;
+                    next += interval;
+                    batcher.stats().print(std::cout);
+                    std::cout << std::endl;
+                }
+            });
+
+        server.run(stopRequested);
+        reporter = {};
+
+        std::cout << "\nFinal statistics\n";
+        batcher.stats().print(std::cout);
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string modelPath;
+    std::string randomShape;
+    std::string socketPath = "/tmp/polann.sock";
+    serving::BatchingOptions options;
+    double statsEvery = 0.0;
+    size_t cacheEntries = 0;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                    throw std::invalid_argument("Missing value for " + std::string(arg));
+                return argv[++i];
+            };
+
+            if (arg == "--model")
+                modelPath = value();
+            else if (arg == "--random")
+                randomShape = value();
+            else if (arg == "--socket")
+                socketPath = value();
+            else if (arg == "--max-batch")
+                options.maxBatchRows = std::stoul(value());
+            else if (arg == "--max-wait-us")
+                options.maxWait = std::chrono::microseconds(std::stol(value()));
+            else if (arg == "--cache")
+                cacheEntries = std::stoul(value());
+            else if (arg == "--stats-every")
+                statsEvery = std::stod(value());
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+            else
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+        }
+
+        if (modelPath.empty() == randomShape.empty())
+            throw std::invalid_argument("Pass exactly one of --model and --random");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        models::DynamicNN model;
+        if (modelPath.empty())
+            model = randomModel(randomShape);
+        else
+            model.load(std::filesystem::path(modelPath));
+        model.finalizeForInference();
+
+        if (cacheEntries == 0)
+            serve(model, socketPath, options, statsEvery);
+        else
+        {
+            models::PredictionCache cache(model, {.capacity = cacheEntries});
+            serve(cache, socketPath, options, statsEvery);
+
+            auto counters = cache.counters();
+            std::cout << "cache      hits=" << counters.hits << " misses=" << counters.misses
+                      << " hit rate=" << counters.hitRate() << "\n";
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
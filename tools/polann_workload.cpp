@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "polann/c_api.h"
+#include "polann/core/dataset.hpp"
+#include "polann/layers/dense.hpp"
+#include "polann/models/dynamic_nn.hpp"
+#include "polann/models/nn.hpp"
+#include "polann/optimizers/sgd.hpp"
+#include "polann/utils/activation_functions.hpp"
+
+using namespace polann;
+using namespace polann::layers;
+using namespace polann::utils;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: polann_workload [options]\n"
+                  << "Trains and runs several model shapes the way typical users do; used to collect\n"
+                  << "profiles for POLANN_PGO_GENERATE builds.\n"
+                  << "  --scale <f>    Multiply the number of samples (default 1)\n";
+    }
+
+    // Separable synthetic task, so training does real work and the loss falls
+    template <size_t InputSize, size_t OutputSize>
+    core::Dataset<InputSize, OutputSize> syntheticDataset(size_t samples)
+    {
+        core::Dataset<InputSize, OutputSize> dataset;
+        dataset.addSamples(samples, [](size_t i, std::span<float, InputSize> in, std::span<float, OutputSize> out)
+        {
+            float sum = 0.0f;
+            for (size_t j = 0; j < InputSize; ++j)
+            {
+                in[j] = std::sin(0.37f * static_cast<float>(i) + 1.3f * static_cast<float>(j));
+                sum += in[j] * (j % 2 == 0 ? 1.0f : -0.5f);
+            }
+            for (size_t k = 0; k < OutputSize; ++k)
+                out[k] = sum > 0.1f * static_cast<float>(k) ? 1.0f : 0.0f;
+        });
+        return dataset;
+    }
+
+    struct Timer
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        [[nodiscard]] double milliseconds() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+
+    void report(std::string_view phase, std::string_view shape, double milliseconds, float loss)
+    {
+        std::cout << std::left << std::setw(12) << phase << std::setw(16) << shape << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(9) << milliseconds << " ms   loss " << std::setprecision(4) << loss
+                  << std::defaultfloat << "\n";
+    }
+
+    /**
+     * @brief fit, evaluate and the three inference paths on one compile-time architecture
+     */
+    template <typename... Layers>
+    float runStatic(std::string_view shape, size_t samples, int epochs, int batchSize)
+    {
+        using Model = models::NN<Layers...>;
+        auto dataset = syntheticDataset<Model::inputSize, Model::outputSize>(samples);
+
+        Model model{Layers()...};
+        model.initialize(7);
+        optimizers::SGD optimizer(0.05f);
+
+        Timer training;
+        model.fit(dataset, optimizer, epochs, batchSize, true, false);
+        report("fit", shape, training.milliseconds(), model.evaluate(dataset).loss);
+
+        // One request at a time, then batches, then on packed weights
+        Timer inference;
+        float checksum = 0.0f;
+        std::array<float, Model::inputSize> input{};
+        for (size_t i = 0; i < dataset.size(); ++i)
+        {
+            std::copy_n(dataset.inputs.data() + i * Model::inputSize, Model::inputSize, input.begin());
+            checksum += model.predict(input)[0];
+        }
+
+        std::vector<float> outputs(dataset.size() * Model::outputSize);
+        model.predictBatch(dataset.inputs, outputs);
+        model.finalizeForInference();
+        for (size_t i = 0; i < dataset.size(); i += 64)
+        {
+            size_t rows = (std::min)(size_t{64}, dataset.size() - i);
+            model.predictBatch({dataset.inputs.data() + i * Model::inputSize, rows * Model::inputSize},
+                               {outputs.data() + i * Model::outputSize, rows * Model::outputSize});
+        }
+        float loss = model.evaluate(dataset).loss;
+        report("predict", shape, inference.milliseconds(), loss);
+        return checksum + outputs[0] + loss;
+    }
+
+    /**
+     * @brief Runtime-shaped training, then inference through the C API as an embedding service would
+     */
+    float runDynamic(size_t samples, int epochs)
+    {
+        auto dataset = syntheticDataset<32, 8>(samples);
+
+        models::DynamicNN model(32);
+        model.addLayer(128, ActivationKind::ReLU).addLayer(64, ActivationKind::ReLU).addLayer(8, ActivationKind::Sigmoid);
+        model.initialize(11);
+        optimizers::SGD optimizer(0.05f);
+
+        Timer training;
+        model.fit(dataset, optimizer, epochs, 64, true, false);
+        report("fit", "dyn 32-128-64-8", training.milliseconds(), model.evaluate(dataset).loss);
+
+        std::ostringstream saved;
+        model.save(saved);
+        std::string bytes = saved.str();
+
+        polann_model *loaded = nullptr;
+        if (polann_model_load_memory(bytes.data(), bytes.size(), &loaded) != POLANN_OK)
+            throw std::runtime_error(std::string("C API load failed: ") + polann_last_error());
+
+        Timer inference;
+        std::vector<float> outputs(dataset.size() * 8);
+        polann_status status = POLANN_OK;
+        for (size_t rows : {size_t{1}, size_t{16}, size_t{256}})
+            for (size_t i = 0; i + rows <= dataset.size() && status == POLANN_OK; i += rows)
+                status = polann_predict_batch(loaded, dataset.inputs.data() + i * 32, rows, outputs.data() + i * 8);
+        polann_model_free(loaded);
+        if (status != POLANN_OK)
+            throw std::runtime_error(std::string("C API inference failed: ") + polann_last_error());
+
+        // Same loss as evaluate() reports, from the C API's outputs
+        float loss = 0.0f;
+        for (size_t i = 0; i < outputs.size(); ++i)
+            loss += (outputs[i] - dataset.outputs[i]) * (outputs[i] - dataset.outputs[i]);
+        loss /= static_cast<float>(outputs.size());
+
+        report("c api", "dyn 32-128-64-8", inference.milliseconds(), loss);
+        return outputs[0];
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    double scale = 1.0;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            if (arg == "--scale" && i + 1 < argc)
+                scale = std::stod(argv[++i]);
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+            else
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+        }
+
+        if (!(scale > 0.0))
+            throw std::invalid_argument("--scale must be positive");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 1;
+    }
+
+    auto samples = [&](size_t base) { return (std::max)(size_t{64}, static_cast<size_t>(static_cast<double>(base) * scale)); };
+
+    try
+    {
+        Timer total;
+        float checksum = 0.0f;
+
+        // Tiny tabular model, a mid-sized classifier and a wide image-like input
+        checksum += runStatic<Dense<ReLU, 2, 64>, Dense<ReLU, 64, 32>, Dense<Sigmoid, 32, 1>>("2-64-32-1", samples(8192), 20, 32);
+        checksum += runStatic<Dense<ReLU, 32, 128>, Dense<ReLU, 128, 64>, Dense<Sigmoid, 64, 8>>("32-128-64-8", samples(8192), 10, 64);
+        checksum += runStatic<Dense<Tanh, 784, 128>, Dense<Sigmoid, 128, 10>>("784-128-10", samples(2048), 5, 128);
+        checksum += runDynamic(samples(8192), 10);
+
+        std::cout << "total " << std::fixed << std::setprecision(0) << total.milliseconds() << " ms (checksum "
+                  << std::setprecision(3) << checksum << ")\n";
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}